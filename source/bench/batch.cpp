@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../driver/account.h"
+
+// ============================================================================
+// One retrieve() per key (as in driver_ht.cpp) vs retrieve_batch()
+// ============================================================================
+
+namespace {
+    /// Keys 0..n-1 in random order, so consecutive probes land on unrelated cache lines.
+    std::vector<int> shuffled_keys( int n )
+    {
+        std::vector<int> keys( n );
+        std::iota( keys.begin(), keys.end(), 0 );
+        std::shuffle( keys.begin(), keys.end(), std::mt19937{ 42 } );
+        return keys;
+    }
+}
+
+/// Looks every key up with a loop of retrieve() calls.
+static void BM_RetrieveLoop( benchmark::State &state )
+{
+    auto keys = shuffled_keys( static_cast<int>(state.range(0)) );
+    ac::HashTbl<int, int> table;
+    for ( auto k : keys )
+        table.insert( k, k );
+    std::shuffle( keys.begin(), keys.end(), std::mt19937{ 7 } );
+
+    std::vector<int> out( keys.size() );
+    for ( auto _ : state ) {
+        for ( size_t i{0}; i < keys.size(); ++i )
+            table.retrieve( keys[i], out[i] );
+        benchmark::DoNotOptimize( out.data() );
+    }
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK(BM_RetrieveLoop)->Arg(1 << 12)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+/// Same lookups with one retrieve_batch() call.
+static void BM_RetrieveBatch( benchmark::State &state )
+{
+    auto keys = shuffled_keys( static_cast<int>(state.range(0)) );
+    ac::HashTbl<int, int> table;
+    for ( auto k : keys )
+        table.insert( k, k );
+    std::shuffle( keys.begin(), keys.end(), std::mt19937{ 7 } );
+
+    std::vector<int> out( keys.size() );
+    for ( auto _ : state ) {
+        table.retrieve_batch( keys.data(), keys.size(), out.data(), nullptr );
+        benchmark::DoNotOptimize( out.data() );
+    }
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK(BM_RetrieveBatch)->Arg(1 << 12)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+/// Account lookups, the driver's workload, one at a time.
+static void BM_AccountRetrieveLoop( benchmark::State &state )
+{
+    std::vector<Account::AcctKey> keys;
+    ac::HashTbl<Account::AcctKey, float, KeyHash, KeyEqual> table;
+    for ( int i{0}; i < state.range(0); ++i ) {
+        Account a{ "Client #" + std::to_string( i ), 1, i % 97, i, 10.f };
+        keys.push_back( a.getKey() );
+        table.insert( a.getKey(), a.m_balance );
+    }
+    std::shuffle( keys.begin(), keys.end(), std::mt19937{ 7 } );
+
+    std::vector<float> out( keys.size() );
+    for ( auto _ : state ) {
+        for ( size_t i{0}; i < keys.size(); ++i )
+            table.retrieve( keys[i], out[i] );
+        benchmark::DoNotOptimize( out.data() );
+    }
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK(BM_AccountRetrieveLoop)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+/// Same account lookups in one batch.
+static void BM_AccountRetrieveBatch( benchmark::State &state )
+{
+    std::vector<Account::AcctKey> keys;
+    ac::HashTbl<Account::AcctKey, float, KeyHash, KeyEqual> table;
+    for ( int i{0}; i < state.range(0); ++i ) {
+        Account a{ "Client #" + std::to_string( i ), 1, i % 97, i, 10.f };
+        keys.push_back( a.getKey() );
+        table.insert( a.getKey(), a.m_balance );
+    }
+    std::shuffle( keys.begin(), keys.end(), std::mt19937{ 7 } );
+
+    std::vector<float> out( keys.size() );
+    for ( auto _ : state ) {
+        table.retrieve_batch( keys.data(), keys.size(), out.data(), nullptr );
+        benchmark::DoNotOptimize( out.data() );
+    }
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK(BM_AccountRetrieveBatch)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,66 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+
+// ============================================================================
+// String keys with and without a cached hash in each entry
+// ============================================================================
+
+namespace {
+    /// A std::string for which HashTbl does not cache the hash (the behavior before cache_hash).
+    struct UncachedString : std::string {
+        using std::string::string;
+    };
+    struct UncachedHash {
+        std::size_t operator()( const UncachedString &s ) const { return std::hash<std::string>{}( s ); }
+    };
+
+    /// Keys sharing a long prefix, so comparing two of them is not free.
+    template <class S>
+    std::vector<S> make_keys( int n )
+    {
+        std::vector<S> keys;
+        for ( int i{0}; i < n; ++i )
+            keys.emplace_back( ( "/var/lib/some/long/common/prefix/" + std::to_string( i ) ).c_str() );
+        return keys;
+    }
+}
+
+template <>
+struct ac::cache_hash<UncachedString> : std::false_type {};
+
+/// Inserts `state.range(0)` string keys, which rehashes the table about log2(n) times.
+template <class S, class Hash>
+static void BM_StringInsert( benchmark::State &state )
+{
+    auto keys = make_keys<S>( static_cast<int>(state.range(0)) );
+    for ( auto _ : state ) {
+        ac::HashTbl<S, int, Hash> table;
+        for ( auto &k : keys )
+            table.insert( k, 0 );
+        benchmark::DoNotOptimize( table.size() );
+    }
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK_TEMPLATE(BM_StringInsert, std::string, std::hash<std::string>)->Arg(1 << 18)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_StringInsert, UncachedString, UncachedHash)->Arg(1 << 18)->Unit(benchmark::kMillisecond);
+
+/// Looks every key up in a table held at load factor `state.range(1)` (long chains).
+template <class S, class Hash>
+static void BM_StringLookupLongChains( benchmark::State &state )
+{
+    auto keys = make_keys<S>( static_cast<int>(state.range(0)) );
+    ac::HashTbl<S, int, Hash> table;
+    table.max_load_factor( static_cast<float>(state.range(1)) );
+    for ( auto &k : keys )
+        table.insert( k, 0 );
+
+    for ( auto _ : state )
+        for ( auto &k : keys )
+            benchmark::DoNotOptimize( table.contains( k ) );
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK_TEMPLATE(BM_StringLookupLongChains, std::string, std::hash<std::string>)->Args({1 << 16, 8});
+BENCHMARK_TEMPLATE(BM_StringLookupLongChains, UncachedString, UncachedHash)->Args({1 << 16, 8});
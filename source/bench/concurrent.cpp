@@ -0,0 +1,72 @@
+#include <mutex>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../include/concurrent_hashtbl.h"
+#include "../include/read_mostly_hashtbl.h"
+
+// ============================================================================
+// Scaling across threads: one global mutex vs sharded locks
+// ============================================================================
+
+namespace {
+    constexpr int PRELOADED = 1 << 16;
+    constexpr int OPS = 1 << 12; // Per thread and iteration.
+
+    /// The previous approach: a HashTbl behind one mutex.
+    struct GlobalLockTbl {
+        std::mutex m_mutex;
+        ac::HashTbl<int, int> m_table;
+
+        bool retrieve( int k, int &d ) { std::lock_guard lock( m_mutex ); return m_table.retrieve( k, d ); }
+        bool insert( int k, int d ) { std::lock_guard lock( m_mutex ); return m_table.insert( k, d ); }
+    };
+
+    template <class Table>
+    Table& shared_table()
+    {
+        static Table *table = [] {
+            auto *t = new Table;
+            for ( int i{0}; i < PRELOADED; ++i )
+                t->insert( i, i );
+            return t;
+        }();
+        return *table;
+    }
+
+    /// Lookups of preloaded keys, plus one insert (of a key owned by the thread) every WRITE_EVERY operations.
+    template <class Table, unsigned WRITE_EVERY>
+    void run_mix( benchmark::State &state )
+    {
+        auto &table = shared_table<Table>();
+        unsigned x = 2463534242u + static_cast<unsigned>( state.thread_index() );
+        const int own = PRELOADED + state.thread_index() * OPS;
+        for ( auto _ : state ) {
+            int found{0};
+            for ( int i{0}; i < OPS; ++i ) {
+                x ^= x << 13; x ^= x >> 17; x ^= x << 5; // xorshift32
+                int d;
+                if ( x % WRITE_EVERY == 0 )
+                    table.insert( own + i, i );
+                else
+                    found += table.retrieve( static_cast<int>( x % PRELOADED ), d );
+            }
+            benchmark::DoNotOptimize( found );
+        }
+        state.SetItemsProcessed( state.iterations() * OPS );
+    }
+}
+
+// 90% reads, 10% writes.
+static void BM_GlobalMutexMix( benchmark::State &state ) { run_mix<GlobalLockTbl, 10>( state ); }
+BENCHMARK(BM_GlobalMutexMix)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_ShardedMix( benchmark::State &state ) { run_mix<ac::ConcurrentHashTbl<int, int>, 10>( state ); }
+BENCHMARK(BM_ShardedMix)->ThreadRange(1, 64)->UseRealTime();
+
+// 99% reads, 1% writes: sharded locks vs lock-free reads.
+static void BM_ShardedReadMostly( benchmark::State &state ) { run_mix<ac::ConcurrentHashTbl<int, int>, 100>( state ); }
+BENCHMARK(BM_ShardedReadMostly)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_LockFreeReadMostly( benchmark::State &state ) { run_mix<ac::ReadMostlyHashTbl<int, int>, 100>( state ); }
+BENCHMARK(BM_LockFreeReadMostly)->ThreadRange(1, 64)->UseRealTime();
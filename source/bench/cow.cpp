@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../include/cow_hashtbl.h"
+
+// ============================================================================
+// Point-in-time views: deep copy of a HashTbl vs snapshot of a CowHashTbl
+// ============================================================================
+
+/// Copies the whole table, as a reporting thread had to before.
+static void BM_ViewByCopy( benchmark::State &state )
+{
+    ac::HashTbl<int, int> table;
+    for ( int i{0}; i < state.range(0); ++i )
+        table.insert( i, i );
+    for ( auto _ : state ) {
+        ac::HashTbl<int, int> view( table );
+        benchmark::DoNotOptimize( view.size() );
+    }
+}
+BENCHMARK(BM_ViewByCopy)->Arg(1 << 10)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+/// Takes a snapshot, then writes `writes` keys to the live table (paying for what it clones).
+static void BM_ViewBySnapshot( benchmark::State &state )
+{
+    ac::CowHashTbl<int, int> table;
+    for ( int i{0}; i < state.range(0); ++i )
+        table.insert( i, i );
+    const int writes = static_cast<int>(state.range(1));
+    int next{0};
+    for ( auto _ : state ) {
+        auto view = table.snapshot();
+        for ( int w{0}; w < writes; ++w, ++next )
+            table.insert( next % state.range(0), next );
+        benchmark::DoNotOptimize( view.size() );
+    }
+}
+BENCHMARK(BM_ViewBySnapshot)->ArgNames({"n", "writes"})
+    ->Args({1 << 10, 0})->Args({1 << 20, 0})->Args({1 << 20, 1})->Args({1 << 20, 1000})
+    ->Unit(benchmark::kMicrosecond);
+
+/// Lookups: the extra indirections of the copy-on-write layout.
+template <class Table>
+static void BM_SnapshotLookup( benchmark::State &state )
+{
+    Table table;
+    for ( int i{0}; i < state.range(0); ++i )
+        table.insert( i, i );
+    for ( auto _ : state )
+        for ( int i{0}; i < state.range(0); ++i )
+            benchmark::DoNotOptimize( table.contains( i ) );
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK_TEMPLATE(BM_SnapshotLookup, ac::HashTbl<int, int>)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_SnapshotLookup, ac::CowHashTbl<int, int>)->Arg(1 << 20);
@@ -0,0 +1,39 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../include/filtered_hashtbl.h"
+
+// ============================================================================
+// Miss-heavy lookups: HashTbl vs the same table behind a membership filter
+// ============================================================================
+
+namespace {
+    std::string account_key( std::size_t i_ ) { return "account-" + std::to_string( i_ * 2654435761u % 1000000007u ); }
+}
+
+/// Looks up state.range(0) stored keys mixed with nine times as many absent ones.
+template <class Table>
+static void BM_MissHeavyLookup( benchmark::State &state )
+{
+    auto n = static_cast<std::size_t>( state.range(0) );
+    Table table;
+    for ( std::size_t i{0}; i < n; ++i )
+        table.insert( account_key( i ), static_cast<int>( i ) );
+    std::vector<std::string> probes;
+    probes.reserve( 10 * n );
+    for ( std::size_t i{0}; i < 10 * n; ++i )
+        probes.push_back( account_key( i % 10 == 0 ? i / 10 : n + i ) ); // 1 hit in 10
+
+    for ( auto _ : state ) {
+        int sum{0}, data{0};
+        for ( const auto &key : probes )
+            if ( table.retrieve( key, data ) )
+                sum += data;
+        benchmark::DoNotOptimize( sum );
+    }
+    state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( probes.size() ) );
+}
+BENCHMARK_TEMPLATE(BM_MissHeavyLookup, ac::HashTbl<std::string, int>)->Arg(1 << 10)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_MissHeavyLookup, ac::FilteredHashTbl<std::string, int>)->Arg(1 << 10)->Arg(1 << 18);
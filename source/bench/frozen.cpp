@@ -0,0 +1,68 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../include/frozen_hashtbl.h"
+
+// ============================================================================
+// Frozen (minimal perfect hash) table vs the chained HashTbl
+// ============================================================================
+
+namespace {
+    std::vector<std::string> frozen_keys( std::size_t n_ )
+    {
+        std::vector<std::string> keys;
+        keys.reserve( n_ );
+        for ( std::size_t i{0}; i < n_; ++i )
+            keys.push_back( "account-" + std::to_string( i * 2654435761u % 1000000007u ) );
+        return keys;
+    }
+
+    ac::HashTbl<std::string, int> chained_table( const std::vector<std::string> &keys_ )
+    {
+        ac::HashTbl<std::string, int> table;
+        table.reserve( keys_.size() );
+        for ( std::size_t i{0}; i < keys_.size(); ++i )
+            table.insert( keys_[i], static_cast<int>(i) );
+        return table;
+    }
+}
+
+/// Time to freeze a populated table; reports the size of the index in bits per key.
+static void BM_FrozenBuild( benchmark::State &state )
+{
+    auto table = chained_table( frozen_keys( static_cast<std::size_t>(state.range(0)) ) );
+    double bits{0};
+    for ( auto _ : state ) {
+        auto frozen = ac::freeze( table );
+        bits = frozen.bits_per_key();
+        benchmark::DoNotOptimize( frozen.size() );
+    }
+    state.counters["bits_per_key"] = bits;
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK(BM_FrozenBuild)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+/// Successful lookups of every key, in random order.
+template <class Table>
+static void BM_FrozenVsChainedLookup( benchmark::State &state )
+{
+    auto keys = frozen_keys( static_cast<std::size_t>(state.range(0)) );
+    auto chained = chained_table( keys );
+    Table table( chained );
+    std::shuffle( keys.begin(), keys.end(), std::mt19937( 7 ) );
+
+    for ( auto _ : state ) {
+        int sum{0}, data{0};
+        for ( const auto &key : keys )
+            if ( table.retrieve( key, data ) )
+                sum += data;
+        benchmark::DoNotOptimize( sum );
+    }
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK_TEMPLATE(BM_FrozenVsChainedLookup, ac::HashTbl<std::string, int>)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_FrozenVsChainedLookup, ac::FrozenHashTbl<std::string, int>)->Arg(1 << 10)->Arg(1 << 20);
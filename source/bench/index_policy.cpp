@@ -0,0 +1,79 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+
+// ============================================================================
+// Cost of mapping a hash value to a bucket
+// ============================================================================
+
+namespace {
+    /// The original bucket computation: a 64-bit division by a run-time prime.
+    class runtime_modulo_policy {
+        public:
+            using size_type = std::size_t;
+            size_type reset( size_type n_ ) { return m_size = ac::prime_index_policy().reset(n_); }
+            size_type index( std::size_t hash_ ) const { return hash_ % m_size; }
+            size_type bucket_count() const { return m_size; }
+        private:
+            size_type m_size{1};
+    };
+
+    std::vector<std::size_t> random_hashes( std::size_t n_ )
+    {
+        std::mt19937_64 rng( 42 );
+        std::vector<std::size_t> hashes( n_ );
+        for ( auto &h : hashes )
+            h = rng();
+        return hashes;
+    }
+}
+
+/// Maps 4096 random hashes into a table of `state.range(0)` buckets.
+template <class Policy>
+static void BM_BucketIndex( benchmark::State &state )
+{
+    Policy policy;
+    policy.reset( static_cast<std::size_t>(state.range(0)) );
+    auto hashes = random_hashes( 4096 );
+
+    for ( auto _ : state ) {
+        std::size_t sum{0};
+        for ( auto h : hashes )
+            sum += policy.index( h );
+        benchmark::DoNotOptimize( sum );
+    }
+    state.SetItemsProcessed( state.iterations() * static_cast<int64_t>(hashes.size()) );
+}
+BENCHMARK_TEMPLATE(BM_BucketIndex, runtime_modulo_policy)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_BucketIndex, ac::prime_index_policy)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_BucketIndex, ac::power2_index_policy)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_BucketIndex, ac::fast_range_index_policy)->Arg(1 << 10)->Arg(1 << 20);
+
+/// Successful lookups of int keys in a HashTbl using the given index policy.
+template <class Policy>
+static void BM_RetrieveWithPolicy( benchmark::State &state )
+{
+    const auto n = static_cast<int>(state.range(0));
+    ac::HashTbl<int, int, std::hash<int>, std::equal_to<int>, Policy> table( n );
+    for ( int i{0}; i < n; ++i )
+        table.insert( i * 7919, i );
+
+    std::mt19937 rng( 42 );
+    std::vector<int> keys( 4096 );
+    for ( auto &k : keys )
+        k = static_cast<int>(rng() % n) * 7919;
+
+    for ( auto _ : state ) {
+        int data{0};
+        for ( auto k : keys )
+            table.retrieve( k, data );
+        benchmark::DoNotOptimize( data );
+    }
+    state.SetItemsProcessed( state.iterations() * static_cast<int64_t>(keys.size()) );
+}
+BENCHMARK_TEMPLATE(BM_RetrieveWithPolicy, runtime_modulo_policy)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_RetrieveWithPolicy, ac::prime_index_policy)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_RetrieveWithPolicy, ac::power2_index_policy)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_RetrieveWithPolicy, ac::fast_range_index_policy)->Arg(1 << 10)->Arg(1 << 16);
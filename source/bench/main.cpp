@@ -0,0 +1,4 @@
+// Entry point of the benchmark suite; every bench/*.cpp registers its own benchmarks.
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
@@ -0,0 +1,52 @@
+#include <string>
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+#include "../include/multi_hashtbl.h"
+
+// ============================================================================
+// Many values per key: MultiHashTbl vs std::unordered_multimap
+// ============================================================================
+
+namespace {
+    constexpr int CUSTOMERS = 10000;
+
+    std::string customer( int i_ ) { return "Customer #" + std::to_string( i_ ); }
+}
+
+/// Sums the values of every customer, each holding `state.range(0)` of them.
+template <class Table>
+static void BM_MultiValueLookup( benchmark::State &state )
+{
+    const int per_key = static_cast<int>(state.range(0));
+    Table table;
+    for ( int v{0}; v < per_key; ++v )
+        for ( int c{0}; c < CUSTOMERS; ++c )
+            table.insert( { customer( c ), v } );
+    std::vector<std::string> names;
+    for ( int c{0}; c < CUSTOMERS; ++c )
+        names.push_back( customer( c ) );
+
+    for ( auto _ : state ) {
+        long sum{0};
+        for ( const auto &name : names ) {
+            auto [first, last] = table.equal_range( name );
+            for ( ; first != last; ++first ) {
+                if constexpr ( std::is_same_v<Table, std::unordered_multimap<std::string, int>> )
+                    sum += first->second;
+                else
+                    sum += *first;
+            }
+        }
+        benchmark::DoNotOptimize( sum );
+    }
+    state.SetItemsProcessed( state.iterations() * CUSTOMERS * per_key );
+}
+
+/// MultiHashTbl with the same insert({key, value}) call as the standard container.
+struct MultiTable : ac::MultiHashTbl<std::string, int> {
+    void insert( const std::pair<std::string, int> &p_ ) { ac::MultiHashTbl<std::string, int>::insert( p_.first, p_.second ); }
+};
+
+BENCHMARK_TEMPLATE(BM_MultiValueLookup, MultiTable)->Arg(1)->Arg(16)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MultiValueLookup, std::unordered_multimap<std::string, int>)->Arg(1)->Arg(16)->Arg(256)->Unit(benchmark::kMillisecond);
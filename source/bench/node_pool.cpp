@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../include/node_pool.h"
+
+// ============================================================================
+// Default allocator vs node pool: a batch job that fills a table and drops it
+// ============================================================================
+
+using PooledTbl = ac::HashTbl< int, int, std::hash<int>, std::equal_to<int>, ac::prime_index_policy,
+                               ac::PoolAllocator< ac::HashEntry<int, int> > >;
+
+/// Inserts `state.range(0)` keys into a table using std::allocator, then destroys it.
+static void BM_BatchDefaultAllocator( benchmark::State &state )
+{
+    const auto n = static_cast<int>(state.range(0));
+    for ( auto _ : state ) {
+        ac::HashTbl<int, int> table;
+        for ( int i{0}; i < n; ++i )
+            table.insert( i, i );
+        benchmark::DoNotOptimize( table.size() );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK(BM_BatchDefaultAllocator)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+/// Same job with every node and bucket array drawn from a NodePool released in one go.
+static void BM_BatchNodePool( benchmark::State &state )
+{
+    const auto n = static_cast<int>(state.range(0));
+    for ( auto _ : state ) {
+        ac::NodePool pool( std::size_t{1} << 20 );
+        {
+            PooledTbl table( 11, pool );
+            for ( int i{0}; i < n; ++i )
+                table.insert( i, i );
+            benchmark::DoNotOptimize( table.size() );
+        }
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK(BM_BatchNodePool)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../driver/account.h"
+
+// ============================================================================
+// Account keys: std::tuple<std::string, int, int, int> vs packed ids and interned name
+// ============================================================================
+
+namespace {
+    /// Accounts whose names are too long for the small string optimization.
+    std::vector<Account> make_accounts( int n )
+    {
+        std::vector<Account> accounts;
+        for ( int i{0}; i < n; ++i )
+            accounts.emplace_back( "Client with a long name #" + std::to_string( i ), 1, i % 97, i, 10.f );
+        return accounts;
+    }
+
+    /// Heap bytes of the keys themselves (long names), which the table statistics do not see.
+    std::size_t key_heap_bytes( const std::vector<Account> &accounts, bool packed )
+    {
+        std::size_t bytes{0};
+        for ( const auto &a : accounts )
+            if ( !packed && a.m_name.size() > std::string().capacity() )
+                bytes += a.m_name.size() + 1;
+        return bytes;
+    }
+
+    template <class Key>
+    Key key_of( const Account &a )
+    {
+        if constexpr ( std::is_same_v<Key, Account::AcctKeyPacked> )
+            return a.getPackedKey();
+        else
+            return a.getKey();
+    }
+}
+
+/// Builds a balance table; reports the bytes per account held by the table and its keys.
+template <class Key>
+static void BM_KeyInsert( benchmark::State &state )
+{
+    auto accounts = make_accounts( static_cast<int>(state.range(0)) );
+    std::vector<Key> keys;
+    for ( const auto &a : accounts )
+        keys.push_back( key_of<Key>( a ) );
+
+    std::size_t bytes{0};
+    for ( auto _ : state ) {
+        ac::HashTbl<Key, float, KeyHash, KeyEqual> table;
+        for ( std::size_t i{0}; i < keys.size(); ++i )
+            table.insert( keys[i], accounts[i].m_balance );
+        bytes = table.stats().bytes_allocated;
+    }
+    constexpr bool packed = std::is_same_v<Key, Account::AcctKeyPacked>;
+    state.counters["bytes_per_account"] = double( bytes + key_heap_bytes( accounts, packed ) ) / accounts.size();
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK_TEMPLATE(BM_KeyInsert, Account::AcctKey)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_KeyInsert, Account::AcctKeyPacked)->Arg(1 << 12)->Arg(1 << 18);
+
+/// Looks every account up by a key built beforehand.
+template <class Key>
+static void BM_KeyLookup( benchmark::State &state )
+{
+    auto accounts = make_accounts( static_cast<int>(state.range(0)) );
+    std::vector<Key> keys;
+    ac::HashTbl<Key, float, KeyHash, KeyEqual> table;
+    for ( const auto &a : accounts ) {
+        keys.push_back( key_of<Key>( a ) );
+        table.insert( keys.back(), a.m_balance );
+    }
+
+    for ( auto _ : state )
+        for ( const auto &k : keys )
+            benchmark::DoNotOptimize( table.contains( k ) );
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK_TEMPLATE(BM_KeyLookup, Account::AcctKey)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_KeyLookup, Account::AcctKeyPacked)->Arg(1 << 12)->Arg(1 << 18);
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../include/parallel_hashtbl.h"
+
+// ============================================================================
+// Insert latency: stop-the-world vs incremental rehash
+// ============================================================================
+
+/// Inserts `state.range(0)` keys with `rehash_step(state.range(1))` and reports the slowest insert.
+static void BM_InsertLatency( benchmark::State &state )
+{
+    const auto n = static_cast<int>(state.range(0));
+    double worst_ns{0};
+
+    for ( auto _ : state ) {
+        ac::HashTbl<int, int> table;
+        table.rehash_step( static_cast<std::size_t>(state.range(1)) );
+        for ( int i{0}; i < n; ++i ) {
+            auto start = std::chrono::steady_clock::now();
+            table.insert( i, i );
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            worst_ns = std::max( worst_ns, std::chrono::duration<double, std::nano>(elapsed).count() );
+        }
+        benchmark::DoNotOptimize( table.size() );
+    }
+    state.counters["max_insert_ns"] = worst_ns;
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK(BM_InsertLatency)->ArgNames({"n", "step"})
+    ->Args({1 << 20, 0})->Args({1 << 20, 1})->Args({1 << 20, 4})
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Bulk load: growing as needed vs reserve() vs the range constructor
+// ============================================================================
+
+/// Loads `state.range(0)` pairs; `state.range(1)` selects 0 = plain inserts, 1 = reserve() first, 2 = range constructor.
+static void BM_BulkLoad( benchmark::State &state )
+{
+    const auto n = static_cast<int>(state.range(0));
+    std::vector<std::pair<int, int>> pairs;
+    for ( int i{0}; i < n; ++i )
+        pairs.emplace_back( i, i );
+
+    for ( auto _ : state ) {
+        if ( state.range(1) == 2 ) {
+            ac::HashTbl<int, int> table( pairs.begin(), pairs.end() );
+            benchmark::DoNotOptimize( table.size() );
+            continue;
+        }
+        ac::HashTbl<int, int> table;
+        if ( state.range(1) == 1 )
+            table.reserve( pairs.size() );
+        for ( auto &p : pairs )
+            table.insert( p.first, p.second );
+        benchmark::DoNotOptimize( table.size() );
+    }
+    state.SetItemsProcessed( state.iterations() * n );
+}
+BENCHMARK(BM_BulkLoad)->ArgNames({"n", "mode"})
+    ->Args({1 << 20, 0})->Args({1 << 20, 1})->Args({1 << 20, 2})
+    ->Unit(benchmark::kMillisecond);
+
+/// Purges 90% of a table: `mode` 0 erases the keys one by one, 1 uses erase_if, and 2 uses
+/// erase_if with a minimum load factor, so the table also shrinks (and later scans are short).
+static void BM_Purge( benchmark::State &state )
+{
+    const int n = static_cast<int>(state.range(0));
+    for ( auto _ : state ) {
+        state.PauseTiming();
+        ac::HashTbl<int, int> table;
+        if ( state.range(1) == 2 )
+            table.min_load_factor( 0.25f );
+        for ( int i{0}; i < n; ++i )
+            table.insert( i, i );
+        state.ResumeTiming();
+
+        if ( state.range(1) == 0 ) {
+            for ( int i{0}; i < n; ++i )
+                if ( i % 10 != 0 )
+                    table.erase( i );
+        } else {
+            table.erase_if( []( const int &key, const int & ) { return key % 10 != 0; } );
+        }
+        // A full scan after the purge, as a nightly job would do.
+        long sum{0};
+        table.for_each( [&sum]( const int &, const int &data ) { sum += data; } );
+        benchmark::DoNotOptimize( sum );
+        state.counters["buckets"] = static_cast<double>(table.bucket_count());
+    }
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK(BM_Purge)->ArgNames({"n", "mode"})
+    ->Args({1 << 20, 0})->Args({1 << 20, 1})->Args({1 << 20, 2})->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Parallel rehash and bulk build: speedup from 1 to N threads
+// ============================================================================
+
+/// Doubles a table of `state.range(0)` string keys on `state.range(1)` threads (0: serial rehash).
+static void BM_ParallelRehash( benchmark::State &state )
+{
+    const auto threads = static_cast<std::size_t>(state.range(1));
+    ac::ThreadPool pool( std::max<std::size_t>( threads, 1 ) );
+    ac::HashTbl<std::string, int> table;
+    table.reserve( static_cast<std::size_t>(state.range(0)) );
+    for ( int i{0}; i < state.range(0); ++i )
+        table.insert( std::to_string( i ), i );
+
+    std::size_t buckets = table.bucket_count();
+    for ( auto _ : state ) {
+        buckets *= 2;
+        if ( threads == 0 )
+            table.rehash( buckets );
+        else
+            ac::parallel_rehash( table, buckets, pool );
+        state.PauseTiming();
+        table.rehash( 0 ); // Back to its original size (not measured).
+        buckets = table.bucket_count();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+
+/// Builds a table of `state.range(0)` string keys on `state.range(1)` threads (0: serial constructor).
+static void BM_ParallelBuild( benchmark::State &state )
+{
+    const auto threads = static_cast<std::size_t>(state.range(1));
+    ac::ThreadPool pool( std::max<std::size_t>( threads, 1 ) );
+    std::vector<std::pair<std::string, int>> pairs;
+    for ( int i{0}; i < state.range(0); ++i )
+        pairs.emplace_back( std::to_string( i ), i );
+
+    for ( auto _ : state ) {
+        if ( threads == 0 ) {
+            ac::HashTbl<std::string, int> table( pairs.begin(), pairs.end() );
+            benchmark::DoNotOptimize( table.size() );
+        } else {
+            auto table = ac::parallel_build<ac::HashTbl<std::string, int>>( pairs.begin(), pairs.end(), pool );
+            benchmark::DoNotOptimize( table.size() );
+        }
+    }
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+
+/// Serial baseline, then 1, 2, 4, ... threads up to the number of hardware threads.
+static void ParallelArgs( benchmark::internal::Benchmark *b )
+{
+    b->ArgNames({"n", "threads"})->Args({1 << 21, 0});
+    const auto cores = std::max( 1u, std::thread::hardware_concurrency() );
+    for ( unsigned t{1}; t < 2 * cores; t *= 2 )
+        b->Args({1 << 21, std::min( t, cores )});
+}
+BENCHMARK(BM_ParallelRehash)->Apply(ParallelArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ParallelBuild)->Apply(ParallelArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
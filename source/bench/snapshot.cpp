@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../include/snapshot.h"
+#include "../driver/account.h"
+
+// ============================================================================
+// Restart: re-inserting every account vs mapping a snapshot
+// ============================================================================
+
+namespace {
+    using BalanceTbl = ac::HashTbl<Account::AcctKey, float, KeyHash, KeyEqual>;
+    constexpr int ACCOUNTS = 1 << 20;
+
+    const std::vector<Account>& accounts()
+    {
+        static const std::vector<Account> all = [] {
+            std::vector<Account> v;
+            for ( int i{0}; i < ACCOUNTS; ++i )
+                v.emplace_back( "Client with a long name #" + std::to_string( i ), 1 + i % 7, i % 997, i, 1.f * i );
+            return v;
+        }();
+        return all;
+    }
+
+    /// The snapshot of every account, written once.
+    const std::string& snapshot_path()
+    {
+        static const std::string path = [] {
+            BalanceTbl table;
+            table.reserve( accounts().size() );
+            for ( auto &a : accounts() )
+                table.insert( a.getKey(), a.m_balance );
+            std::string p = "bench_accounts.snap";
+            ac::save_snapshot( table, p );
+            std::atexit( [] { std::remove( "bench_accounts.snap" ); } );
+            return p;
+        }();
+        return path;
+    }
+}
+
+/// What a restart costs today: inserting every account again.
+static void BM_RestartByInsert( benchmark::State &state )
+{
+    for ( auto _ : state ) {
+        BalanceTbl table;
+        for ( auto &a : accounts() )
+            table.insert( a.getKey(), a.m_balance );
+        benchmark::DoNotOptimize( table.size() );
+    }
+    state.SetItemsProcessed( state.iterations() * ACCOUNTS );
+}
+BENCHMARK(BM_RestartByInsert)->Unit(benchmark::kMillisecond);
+
+/// Mapping the snapshot; with `state.range(0)` the checksum is verified (one pass over the file).
+static void BM_RestartFromSnapshot( benchmark::State &state )
+{
+    const auto &path = snapshot_path();
+    for ( auto _ : state ) {
+        ac::MappedHashTbl<Account::AcctKey, float, KeyHash> table{ path, state.range(0) != 0 };
+        benchmark::DoNotOptimize( table.size() );
+    }
+    state.SetItemsProcessed( state.iterations() * ACCOUNTS );
+}
+BENCHMARK(BM_RestartFromSnapshot)->ArgName("verify")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/// Lookups served from the mapped pages (the page cache is warm after the first iteration).
+static void BM_MappedLookup( benchmark::State &state )
+{
+    ac::MappedHashTbl<Account::AcctKey, float, KeyHash> table{ snapshot_path() };
+    std::vector<Account::AcctKey> keys;
+    for ( int i{0}; i < ACCOUNTS; i += 16 )
+        keys.push_back( accounts()[i].getKey() );
+    for ( auto _ : state )
+        for ( auto &k : keys )
+            benchmark::DoNotOptimize( table.contains( k ) );
+    state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+}
+BENCHMARK(BM_MappedLookup);
@@ -0,0 +1,53 @@
+#include <array>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../include/static_hashtbl.h"
+
+// ============================================================================
+// Small hot lookup tables: HashTbl vs StaticHashTbl
+// ============================================================================
+
+namespace {
+    /// Bank codes of a small routing table, looked up over and over.
+    constexpr std::array<int, 12> BANKS{ 1, 12, 13, 17, 18, 28, 33, 104, 116, 237, 341, 422 };
+}
+
+/// Looks up every bank code of a heap-backed HashTbl.
+static void BM_SmallTableLookup_HashTbl( benchmark::State &state )
+{
+    ac::HashTbl<int, int> table;
+    for ( auto bank : BANKS )
+        table.insert( bank, bank * 10 );
+    for ( auto _ : state ) {
+        int sum{0}, data{0};
+        for ( auto bank : BANKS ) {
+            benchmark::DoNotOptimize( bank );
+            if ( table.retrieve( bank, data ) )
+                sum += data;
+        }
+        benchmark::DoNotOptimize( sum );
+    }
+    state.SetItemsProcessed( state.iterations() * static_cast<int64_t>(BANKS.size()) );
+}
+BENCHMARK(BM_SmallTableLookup_HashTbl);
+
+/// The same lookups in a table built at compile time.
+static void BM_SmallTableLookup_Static( benchmark::State &state )
+{
+    static constexpr ac::StaticHashTbl<int, int, 12> table{
+        {1, 10}, {12, 120}, {13, 130}, {17, 170}, {18, 180}, {28, 280},
+        {33, 330}, {104, 1040}, {116, 1160}, {237, 2370}, {341, 3410}, {422, 4220}
+    };
+    for ( auto _ : state ) {
+        int sum{0}, data{0};
+        for ( auto bank : BANKS ) {
+            benchmark::DoNotOptimize( bank );
+            if ( table.retrieve( bank, data ) )
+                sum += data;
+        }
+        benchmark::DoNotOptimize( sum );
+    }
+    state.SetItemsProcessed( state.iterations() * static_cast<int64_t>(BANKS.size()) );
+}
+BENCHMARK(BM_SmallTableLookup_Static);
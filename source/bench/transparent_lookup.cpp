@@ -0,0 +1,51 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../driver/account.h"
+
+// ============================================================================
+// Account lookup: full key (copies the name) vs key view (no allocation)
+// ============================================================================
+
+namespace {
+    /// Accounts whose names are too long for the small string optimization.
+    std::vector<Account> make_accounts( int n )
+    {
+        std::vector<Account> accounts;
+        for ( int i{0}; i < n; ++i )
+            accounts.emplace_back( "Client with a long name #" + std::to_string( i ), 1, i % 97, i, 10.f );
+        return accounts;
+    }
+}
+
+/// Looks every account up by `getKey()`, which builds a std::string per probe.
+static void BM_LookupByKey( benchmark::State &state )
+{
+    auto accounts = make_accounts( static_cast<int>(state.range(0)) );
+    ac::HashTbl<Account::AcctKey, Account, KeyHash, KeyEqual> table;
+    for ( auto &a : accounts )
+        table.insert( a.getKey(), a );
+
+    for ( auto _ : state )
+        for ( auto &a : accounts )
+            benchmark::DoNotOptimize( table.contains( a.getKey() ) );
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK(BM_LookupByKey)->Arg(1 << 12)->Arg(1 << 16);
+
+/// Same lookups through `getKeyView()` and the transparent functors.
+static void BM_LookupByKeyView( benchmark::State &state )
+{
+    auto accounts = make_accounts( static_cast<int>(state.range(0)) );
+    ac::HashTbl<Account::AcctKey, Account, KeyHash, KeyEqual> table;
+    for ( auto &a : accounts )
+        table.insert( a.getKey(), a );
+
+    for ( auto _ : state )
+        for ( auto &a : accounts )
+            benchmark::DoNotOptimize( table.contains( a.getKeyView() ) );
+    state.SetItemsProcessed( state.iterations() * state.range(0) );
+}
+BENCHMARK(BM_LookupByKeyView)->Arg(1 << 12)->Arg(1 << 16);
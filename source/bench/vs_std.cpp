@@ -0,0 +1,356 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "../include/hashtbl.h"
+#include "../driver/account.h"
+
+// ============================================================================
+// HashTbl vs std::unordered_map: every basic operation, three key types,
+// uniform and Zipfian access, table sizes from 1K up to AC_BENCH_MAX_N.
+//
+// Benchmarks are named <operation>/<table>/<key>[/<pattern>]/<n>, e.g.
+// "LookupHit/HashTbl/string/zipf/100000"; filter with --benchmark_filter.
+// ============================================================================
+
+// Largest table size measured. Raise it to 100000000 (CMake option of the same name) on a
+// machine with enough memory; every power of ten from 1000 up to it is measured.
+#ifndef AC_BENCH_MAX_N
+#define AC_BENCH_MAX_N 1000000
+#endif
+
+namespace {
+    /// Probes per lookup/upsert iteration: the table size, capped so that large tables stay quick.
+    constexpr std::size_t MAX_PROBES = 1 << 20;
+
+    /// Bijective 64-bit mixer (splitmix64 finalizer): distinct inputs give distinct keys.
+    std::uint64_t mix( std::uint64_t x )
+    {
+        x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+        x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebULL;
+        return x ^ ( x >> 31 );
+    }
+
+    /// Key type under test: its name in the benchmark, how to make the i-th key, and its functors.
+    template <class K> struct KeyKind;
+
+    template <> struct KeyKind<int> {
+        static constexpr const char *NAME = "int";
+        using hash = std::hash<int>;
+        using equal = std::equal_to<int>;
+        // Odd multiplier: a bijection on 32 bits, and the keys are not in insertion order.
+        static int make( std::size_t i ) { return static_cast<int>( static_cast<std::uint32_t>( i ) * 2654435761u ); }
+    };
+
+    template <> struct KeyKind<std::string> {
+        static constexpr const char *NAME = "string";
+        using hash = std::hash<std::string>;
+        using equal = std::equal_to<std::string>;
+        // 24 characters: past the small string optimization, like most real identifiers.
+        static std::string make( std::size_t i )
+        {
+            char buf[32];
+            std::snprintf( buf, sizeof buf, "session/%016llx", static_cast<unsigned long long>( mix( i ) ) );
+            return buf;
+        }
+    };
+
+    template <> struct KeyKind<Account::AcctKey> {
+        static constexpr const char *NAME = "AcctKey";
+        using hash = KeyHash;
+        using equal = KeyEqual;
+        static Account::AcctKey make( std::size_t i )
+        {
+            const auto n = static_cast<int>( i );
+            return { "Client #" + std::to_string( i ), 1 + n % 7, n % 997, n };
+        }
+    };
+
+    template <class K>
+    using HashTblOf = ac::HashTbl<K, int, typename KeyKind<K>::hash, typename KeyKind<K>::equal>;
+    template <class K>
+    using StdMapOf = std::unordered_map<K, int, typename KeyKind<K>::hash, typename KeyKind<K>::equal>;
+
+    template <class Map> struct MapName;
+    template <class K> struct MapName<HashTblOf<K>> { static constexpr const char *NAME = "HashTbl"; };
+    template <class K> struct MapName<StdMapOf<K>> { static constexpr const char *NAME = "std"; };
+
+    // The only operation spelled differently in the two tables.
+    template <class K>
+    bool found( const HashTblOf<K> &map_, const K &key_ ) { return map_.contains( key_ ); }
+    template <class K>
+    bool found( const StdMapOf<K> &map_, const K &key_ ) { return map_.find( key_ ) != map_.end(); }
+
+    /// The n keys stored in the table (index i < n) and n keys that are not (index n + i).
+    template <class K>
+    const std::vector<K>& keys_for( std::size_t n )
+    {
+        static std::map<std::size_t, std::vector<K>> cache;
+        auto &keys = cache[n];
+        if ( keys.empty() ) {
+            keys.reserve( 2 * n );
+            for ( std::size_t i{0}; i < 2 * n; ++i )
+                keys.push_back( KeyKind<K>::make( i ) );
+        }
+        return keys;
+    }
+
+    /*!
+     * @brief Zipfian ranks in [0, n), rank 0 being the most frequent (Gray et al., as in YCSB).
+     *
+     * With theta = 0.99 a small set of keys gets most accesses, the typical skew of caches
+     * and session stores.
+     */
+    class Zipf {
+        public:
+            explicit Zipf( std::size_t n_, double theta_ = 0.99 ) : m_n{static_cast<double>( n_ )}, m_theta{theta_}
+            {
+                for ( std::size_t i{1}; i <= n_; ++i )
+                    m_zetan += 1.0 / std::pow( static_cast<double>( i ), theta_ );
+                const double zeta2 = 1.0 + std::pow( 0.5, theta_ );
+                m_alpha = 1.0 / ( 1.0 - theta_ );
+                m_eta = ( 1.0 - std::pow( 2.0 / m_n, 1.0 - theta_ ) ) / ( 1.0 - zeta2 / m_zetan );
+            }
+
+            template <class Rng>
+            std::size_t operator()( Rng &rng_ )
+            {
+                const double u = std::uniform_real_distribution<double>{ 0.0, 1.0 }( rng_ );
+                const double uz = u * m_zetan;
+                if ( uz < 1.0 )
+                    return 0;
+                if ( uz < 1.0 + std::pow( 0.5, m_theta ) )
+                    return 1;
+                auto rank = static_cast<std::size_t>( m_n * std::pow( m_eta * u - m_eta + 1.0, m_alpha ) );
+                return std::min( rank, static_cast<std::size_t>( m_n ) - 1 );
+            }
+
+        private:
+            double m_n;
+            double m_theta;
+            double m_zetan{0};
+            double m_alpha;
+            double m_eta;
+    };
+
+    enum class Pattern { UNIFORM, ZIPF };
+    const char *pattern_name( Pattern p_ ) { return p_ == Pattern::UNIFORM ? "uniform" : "zipf"; }
+
+    /// Indices in [0, n) of the keys probed by one iteration, drawn with the given pattern.
+    const std::vector<std::size_t>& probes_for( std::size_t n, Pattern pattern )
+    {
+        static std::map<std::pair<std::size_t, Pattern>, std::vector<std::size_t>> cache;
+        auto &probes = cache[{ n, pattern }];
+        if ( probes.empty() ) {
+            std::mt19937_64 rng{ 42 };
+            const auto count = std::min( n, MAX_PROBES );
+            probes.reserve( count );
+            if ( pattern == Pattern::UNIFORM ) {
+                std::uniform_int_distribution<std::size_t> pick{ 0, n - 1 };
+                for ( std::size_t i{0}; i < count; ++i )
+                    probes.push_back( pick( rng ) );
+            } else {
+                Zipf zipf{ n };
+                for ( std::size_t i{0}; i < count; ++i )
+                    probes.push_back( zipf( rng ) );
+            }
+        }
+        return probes;
+    }
+
+    /// A table holding the first n keys, built once and shared by the read-only benchmarks.
+    template <class Map>
+    const Map& filled( const std::vector<typename Map::key_type> &keys_, std::size_t n )
+    {
+        static std::map<std::size_t, Map> cache;
+        auto [it, is_new] = cache.try_emplace( n );
+        if ( is_new )
+            for ( std::size_t i{0}; i < n; ++i )
+                it->second[keys_[i]] = static_cast<int>( i );
+        return it->second;
+    }
+
+    /// Copies `source_` into `map_` outside the timed region.
+    template <class Map>
+    void untimed_copy( benchmark::State &state, std::optional<Map> &map_, const Map &source_ )
+    {
+        state.PauseTiming();
+        map_.emplace( source_ );
+        state.ResumeTiming();
+    }
+
+    /// Destroys `map_` outside the timed region.
+    template <class Map>
+    void untimed_reset( benchmark::State &state, std::optional<Map> &map_ )
+    {
+        state.PauseTiming();
+        map_.reset();
+        state.ResumeTiming();
+    }
+
+    // ------------------------------------------------------------------------
+    // The benchmarks. `n` is the table size.
+    // ------------------------------------------------------------------------
+
+    /// Inserts n distinct keys into an empty table (rehashes included).
+    template <class Map>
+    void insert( benchmark::State &state, std::size_t n )
+    {
+        const auto &keys = keys_for<typename Map::key_type>( n );
+        for ( auto _ : state ) {
+            Map map;
+            for ( std::size_t i{0}; i < n; ++i )
+                map.insert_or_assign( keys[i], static_cast<int>( i ) );
+            benchmark::DoNotOptimize( map.size() );
+        }
+        state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( n ) );
+    }
+
+    /// Looks up stored keys, picked with `pattern`.
+    template <class Map>
+    void lookup_hit( benchmark::State &state, std::size_t n, Pattern pattern )
+    {
+        const auto &keys = keys_for<typename Map::key_type>( n );
+        const auto &map = filled<Map>( keys, n );
+        const auto &probes = probes_for( n, pattern );
+        for ( auto _ : state ) {
+            std::size_t hits{0};
+            for ( auto i : probes )
+                hits += found( map, keys[i] );
+            benchmark::DoNotOptimize( hits );
+        }
+        state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( probes.size() ) );
+    }
+
+    /// Looks up keys that are not in the table.
+    template <class Map>
+    void lookup_miss( benchmark::State &state, std::size_t n )
+    {
+        const auto &keys = keys_for<typename Map::key_type>( n );
+        const auto &map = filled<Map>( keys, n );
+        const auto &probes = probes_for( n, Pattern::UNIFORM );
+        for ( auto _ : state ) {
+            std::size_t hits{0};
+            for ( auto i : probes )
+                hits += found( map, keys[n + i] );
+            benchmark::DoNotOptimize( hits );
+        }
+        state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( probes.size() ) );
+    }
+
+    /// Erases every key of a full table (the copy it works on is made outside the timing).
+    template <class Map>
+    void erase( benchmark::State &state, std::size_t n )
+    {
+        const auto &keys = keys_for<typename Map::key_type>( n );
+        const auto &source = filled<Map>( keys, n );
+        std::optional<Map> map;
+        for ( auto _ : state ) {
+            untimed_copy( state, map, source );
+            for ( std::size_t i{0}; i < n; ++i )
+                map->erase( keys[i] );
+            benchmark::DoNotOptimize( map->size() );
+            untimed_reset( state, map );
+        }
+        state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( n ) );
+    }
+
+    /// `++map[key]` on keys picked with `pattern`, half of which are not in the table yet.
+    template <class Map>
+    void upsert( benchmark::State &state, std::size_t n, Pattern pattern )
+    {
+        const auto &keys = keys_for<typename Map::key_type>( n );
+        const auto &source = filled<Map>( keys, n / 2 );
+        const auto &probes = probes_for( n, pattern );
+        std::optional<Map> map;
+        for ( auto _ : state ) {
+            untimed_copy( state, map, source );
+            for ( auto i : probes )
+                ++( *map )[keys[i]];
+            benchmark::DoNotOptimize( map->size() );
+            untimed_reset( state, map );
+        }
+        state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( probes.size() ) );
+    }
+
+    /// Rebuilds a full table with twice its buckets.
+    template <class Map>
+    void rehash( benchmark::State &state, std::size_t n )
+    {
+        const auto &keys = keys_for<typename Map::key_type>( n );
+        const auto &source = filled<Map>( keys, n );
+        std::optional<Map> map;
+        for ( auto _ : state ) {
+            untimed_copy( state, map, source );
+            map->rehash( 2 * map->bucket_count() );
+            benchmark::DoNotOptimize( map->bucket_count() );
+            untimed_reset( state, map );
+        }
+        state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( n ) );
+    }
+
+    /// Copy-constructs a full table.
+    template <class Map>
+    void copy( benchmark::State &state, std::size_t n )
+    {
+        const auto &keys = keys_for<typename Map::key_type>( n );
+        const auto &source = filled<Map>( keys, n );
+        for ( auto _ : state ) {
+            Map map{ source };
+            benchmark::DoNotOptimize( map.size() );
+        }
+        state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( n ) );
+    }
+
+    // ------------------------------------------------------------------------
+    // Registration
+    // ------------------------------------------------------------------------
+
+    template <class Map, class Fn, class... Args>
+    void add( const char *op, const std::string &suffix, std::size_t n, Fn fn, Args... args )
+    {
+        using K = typename Map::key_type;
+        auto name = std::string{ op } + "/" + MapName<Map>::NAME + "/" + KeyKind<K>::NAME + suffix + "/" + std::to_string( n );
+        benchmark::RegisterBenchmark( name.c_str(), [=]( benchmark::State &state ) { fn( state, n, args... ); } )
+            ->Unit( n >= 1000000 ? benchmark::kMillisecond : benchmark::kMicrosecond );
+    }
+
+    template <class Map>
+    void register_map()
+    {
+        for ( std::size_t n{1000}; n <= AC_BENCH_MAX_N; n *= 10 ) {
+            add<Map>( "Insert", "", n, insert<Map> );
+            for ( auto pattern : { Pattern::UNIFORM, Pattern::ZIPF } ) {
+                const auto suffix = std::string{ "/" } + pattern_name( pattern );
+                add<Map>( "LookupHit", suffix, n, lookup_hit<Map>, pattern );
+                add<Map>( "Upsert", suffix, n, upsert<Map>, pattern );
+            }
+            add<Map>( "LookupMiss", "", n, lookup_miss<Map> );
+            add<Map>( "Erase", "", n, erase<Map> );
+            add<Map>( "Rehash", "", n, rehash<Map> );
+            add<Map>( "Copy", "", n, copy<Map> );
+        }
+    }
+
+    template <class K>
+    void register_key()
+    {
+        register_map<HashTblOf<K>>();
+        register_map<StdMapOf<K>>();
+    }
+
+    const bool registered = [] {
+        register_key<int>();
+        register_key<std::string>();
+        register_key<Account::AcctKey>();
+        return true;
+    }();
+}
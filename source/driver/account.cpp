@@ -2,9 +2,71 @@
  * @file: account.cpp
  */
 #include "account.h"
+#include "../include/hash_functors.h"
 
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
 #include <utility>
 
+#include "../include/hashtbl.h"
+
+namespace {
+    /// Client names used by packed keys, each stored once; a name's id is its position.
+    class NameTable {
+    public:
+        std::uint32_t intern(std::string_view name)
+        {
+            std::uint32_t id;
+            if (find(name, id))
+                return id;
+            std::unique_lock lock(m_mutex);
+            if (m_ids.retrieve(name, id)) // Interned by another thread meanwhile.
+                return id;
+            if (m_names.size() == UINT32_MAX)
+                throw std::length_error("too many account names");
+            id = static_cast<std::uint32_t>(m_names.size());
+            m_names.emplace_back(name); // A deque never moves its elements: the views stay valid.
+            m_ids.insert(m_names.back(), id);
+            return id;
+        }
+        bool find(std::string_view name, std::uint32_t& id) const
+        {
+            std::shared_lock lock(m_mutex);
+            return m_ids.retrieve(name, id);
+        }
+        std::string_view name(std::uint32_t id) const
+        {
+            std::shared_lock lock(m_mutex);
+            return m_names[id];
+        }
+        std::size_t size() const
+        {
+            std::shared_lock lock(m_mutex);
+            return m_names.size();
+        }
+
+    private:
+        mutable std::shared_mutex m_mutex;
+        std::deque<std::string> m_names;
+        ac::HashTbl<std::string_view, std::uint32_t, ac::string_hash, std::equal_to<>> m_ids;
+    };
+
+    NameTable& names()
+    {
+        static NameTable table;
+        return table;
+    }
+
+    std::uint64_t pack_ids(int bank, int branch, int number)
+    {
+        if (bank < 0 or bank > 0xFFFF or branch < 0 or branch > 0xFFFF)
+            throw std::out_of_range("bank and branch codes of a packed key must be in [0, 65535]");
+        return std::uint64_t(bank) << 48 | std::uint64_t(branch) << 32 | static_cast<std::uint32_t>(number);
+    }
+}
+
 /// Basic constructor.
 Account::Account(std::string n, int bnc, int brc, int nmr, float bal)
     : m_name{std::move( n )}, m_bank_code{ bnc }, m_branch_code{ brc }, m_number{ nmr }, m_balance{ bal }
@@ -17,6 +79,45 @@ Account::AcctKey Account::getKey() const
     return std::make_tuple(m_name, m_bank_code, m_branch_code, m_number);
 }
 
+/// Returns a view of the account key.
+Account::AcctKeyView Account::getKeyView() const
+{
+    return { m_name, m_bank_code, m_branch_code, m_number };
+}
+
+/// Returns the packed account key.
+Account::AcctKeyPacked Account::getPackedKey() const
+{
+    return AcctKeyPacked::make(m_name, m_bank_code, m_branch_code, m_number);
+}
+
+AcctKeyPacked AcctKeyPacked::make(std::string_view name, int bank, int branch, int number)
+{
+    auto ids = pack_ids(bank, branch, number);
+    return { ids, names().intern(name) };
+}
+
+bool AcctKeyPacked::find(std::string_view name, int bank, int branch, int number, AcctKeyPacked& key)
+{
+    if (bank < 0 or bank > 0xFFFF or branch < 0 or branch > 0xFFFF)
+        return false;
+    std::uint32_t id;
+    if (not names().find(name, id))
+        return false;
+    key = { pack_ids(bank, branch, number), id };
+    return true;
+}
+
+std::string_view AcctKeyPacked::name() const
+{
+    return names().name(m_name);
+}
+
+std::size_t interned_account_names()
+{
+    return names().size();
+}
+
 std::ostream& operator<<(std::ostream& os_, const Account::AcctKey& ak_)
 {
     const auto& [name, bkid, brid, accn] = ak_;
@@ -40,10 +141,24 @@ bool operator==(const Account& a, const Account& b)
 }
 
 std::size_t KeyHash::operator()(const Account::AcctKey& k_) const
+{
+    // A view of the key, so both overloads agree
+    return (*this)(Account::AcctKeyView{ k_ });
+}
+
+std::size_t KeyHash::operator()(const Account::AcctKeyView& k_) const
 {
     const auto& [name, bkid, brid, accn] = k_;
-    return std::hash<std::string>{}(name) xor std::hash<int>{}(bkid) xor std::hash<int>{}(brid)
-           xor std::hash<int>{}(accn);
+    // Combine in order: xor would let the (identity) hashes of the ints cancel each other.
+    auto h = std::hash<std::string_view>{}(name);
+    h = ac::hash_combine(h, std::hash<int>{}(bkid));
+    h = ac::hash_combine(h, std::hash<int>{}(brid));
+    return ac::hash_combine(h, std::hash<int>{}(accn));
+}
+
+std::size_t KeyHash::operator()(const Account::AcctKeyPacked& k_) const
+{
+    return ac::hash_combine(k_.m_ids, k_.m_name);
 }
 
 // Functor that test two keys for equality.
@@ -53,3 +168,8 @@ bool KeyEqual::operator()(const Account::AcctKey& k1_, const Account::AcctKey& k
     const auto& [name2, bkid2, brid2, accn2] = k2_;
     return name1 == name2 and bkid1 == bkid2 and brid1 == brid2 and accn1 == accn2;
 }
+
+bool KeyEqual::operator()(const Account::AcctKeyView& k1_, const Account::AcctKeyView& k2_) const
+{
+    return k1_ == k2_;
+}
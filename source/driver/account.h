@@ -6,9 +6,44 @@
 #ifndef ACCOUNT_H
 #define ACCOUNT_H
 
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
+
+/*!
+ * Compact account key: bank (16 bits), branch (16 bits) and number (32 bits) packed in one
+ * integer, plus the id of the client name in a process-wide table of interned names. It is
+ * trivially copyable and 16 bytes long (against 48 and a heap allocation per long name for
+ * `Account::AcctKey`), and two keys compare with one integer comparison unless their
+ * numbers match. Name ids are only meaningful within one process: do not persist them.
+ */
+struct AcctKeyPacked {
+    std::uint64_t m_ids;   //!< bank << 48 | branch << 32 | number.
+    std::uint32_t m_name;  //!< Interned name id.
+
+    /// Packs a key, interning the name. @throws std::out_of_range if bank or branch is not in [0, 65535].
+    static AcctKeyPacked make(std::string_view name, int bank, int branch, int number);
+    /// Packs a key only if the name is already interned: otherwise no account can have it.
+    static bool find(std::string_view name, int bank, int branch, int number, AcctKeyPacked& key);
+
+    [[nodiscard]] std::string_view name() const;
+    [[nodiscard]] int bank() const { return static_cast<int>(m_ids >> 48); }
+    [[nodiscard]] int branch() const { return static_cast<int>((m_ids >> 32) & 0xFFFF); }
+    [[nodiscard]] int number() const { return static_cast<std::int32_t>(static_cast<std::uint32_t>(m_ids)); }
+
+    friend bool operator==(const AcctKeyPacked& a, const AcctKeyPacked& b)
+    {
+        return a.m_ids == b.m_ids and a.m_name == b.m_name;
+    }
+    friend bool operator!=(const AcctKeyPacked& a, const AcctKeyPacked& b) { return not(a == b); }
+};
+
+/// Number of distinct names interned by packed keys so far.
+std::size_t interned_account_names();
 
 /// Represents a bank account.
 struct Account {
@@ -20,6 +55,10 @@ struct Account {
 
     // Nickname for the account key.
     using AcctKey = std::tuple<std::string, int, int, int>;
+    // Non-owning account key, for lookups that must not copy the client name.
+    using AcctKeyView = std::tuple<std::string_view, int, int, int>;
+    // Compact key: packed ids and an interned name.
+    using AcctKeyPacked = ::AcctKeyPacked;
 
     /// Basic constructor.
     Account(std::string = "<empty>", int = 0, int = 0, int = 0, float = 0.f);
@@ -27,6 +66,12 @@ struct Account {
     /// Returns the account key.
     [[nodiscard]] AcctKey getKey() const;
 
+    /// Returns a view of the account key; valid while the account (its name) is.
+    [[nodiscard]] AcctKeyView getKeyView() const;
+
+    /// Returns the packed account key (interns the name).
+    [[nodiscard]] AcctKeyPacked getPackedKey() const;
+
     /// Stream extractor of the account information.
     friend std::ostream& operator<<(std::ostream& os, const Account& acct);
 };
@@ -35,13 +80,28 @@ struct Account {
 bool operator==(const Account& a, const Account& b);
 
 /// Functor that generates a hash number for a given account.
+/// Transparent: keys and key views of the same account hash alike.
 struct KeyHash {
+    using is_transparent = void;
     std::size_t operator()(const Account::AcctKey&) const;
+    std::size_t operator()(const Account::AcctKeyView&) const;
+    std::size_t operator()(const Account::AcctKeyPacked&) const;
 };
 
-// Functor that test two keys for equality.
+// Functor that test two keys for equality (keys and key views mix freely).
 struct KeyEqual {
+    using is_transparent = void;
     bool operator()(const Account::AcctKey&, const Account::AcctKey&) const;
+    bool operator()(const Account::AcctKeyView&, const Account::AcctKeyView&) const;
+    bool operator()(const Account::AcctKeyPacked& k1, const Account::AcctKeyPacked& k2) const { return k1 == k2; }
 };
 
+namespace ac {
+    template <class KeyType>
+    struct cache_hash;
+    /// A packed key hashes in a few instructions: storing its hash in every entry would cost more than it saves.
+    template <>
+    struct cache_hash<Account::AcctKeyPacked> : std::false_type {};
+}
+
 #endif
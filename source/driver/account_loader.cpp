@@ -0,0 +1,351 @@
+/*!
+ * @file: account_loader.cpp
+ */
+#include "account_loader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ACCOUNT_LOADER_POSIX 1
+#endif
+
+namespace {
+    /// A whole file, mapped read-only where possible (read into memory otherwise).
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path)
+        {
+#ifdef ACCOUNT_LOADER_POSIX
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("cannot open " + path);
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("cannot stat " + path);
+            }
+            m_size = static_cast<std::size_t>(st.st_size);
+            if (m_size > 0) {
+                void* p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    ::close(fd);
+                    throw std::runtime_error("cannot map " + path);
+                }
+                // Every page is read once, front to back (within each chunk).
+                ::madvise(p, m_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char*>(p);
+            }
+            ::close(fd);
+#else
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file)
+                throw std::runtime_error("cannot open " + path);
+            m_size = static_cast<std::size_t>(file.tellg());
+            m_buffer.resize(m_size);
+            file.seekg(0);
+            file.read(m_buffer.data(), static_cast<std::streamsize>(m_size));
+            m_data = m_buffer.data();
+#endif
+        }
+        ~MappedFile()
+        {
+#ifdef ACCOUNT_LOADER_POSIX
+            if (m_data != nullptr)
+                ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+        }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::string_view view() const { return { m_data, m_size }; }
+
+        /// Drops the resident pages wholly inside `part` (of view()), which will not be read again.
+        void release([[maybe_unused]] std::string_view part)
+        {
+#ifdef ACCOUNT_LOADER_POSIX
+            static const auto page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+            auto first = (reinterpret_cast<std::uintptr_t>(part.data()) + page - 1) / page * page;
+            auto last = (reinterpret_cast<std::uintptr_t>(part.data() + part.size())) / page * page;
+            if (first < last)
+                ::madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+#endif
+        }
+
+    private:
+        const char* m_data{ nullptr };
+        std::size_t m_size{ 0 };
+#ifndef ACCOUNT_LOADER_POSIX
+        std::string m_buffer;
+#endif
+    };
+
+    template <class T>
+    bool parse_number(std::string_view field, T& value)
+    {
+        auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+        return ec == std::errc{} && end == field.data() + field.size();
+    }
+
+    // Floating-point from_chars is missing from older standard libraries: strtof on a bounded copy.
+    bool parse_number(std::string_view field, float& value)
+    {
+        char buf[32];
+        if (field.empty() || field.size() >= sizeof(buf))
+            return false;
+        field.copy(buf, field.size());
+        buf[field.size()] = '\0';
+        char* end{ nullptr };
+        value = std::strtof(buf, &end);
+        return end == buf + field.size();
+    }
+
+    /// Splits "name,bank,branch,number,balance"; false if the line is malformed.
+    bool parse_line(std::string_view line, Account& acct)
+    {
+        std::string_view fields[5];
+        for (int i{ 0 }; i < 4; ++i) {
+            auto comma = line.find(',');
+            if (comma == std::string_view::npos)
+                return false;
+            fields[i] = line.substr(0, comma);
+            line.remove_prefix(comma + 1);
+        }
+        fields[4] = line;
+        if (fields[0].empty())
+            return false;
+        acct.m_name.assign(fields[0]);
+        return parse_number(fields[1], acct.m_bank_code) && parse_number(fields[2], acct.m_branch_code)
+            && parse_number(fields[3], acct.m_number) && parse_number(fields[4], acct.m_balance);
+    }
+
+    bool is_binary(std::string_view data)
+    {
+        return data.size() >= sizeof(ACCOUNT_BIN_MAGIC)
+            && std::memcmp(data.data(), ACCOUNT_BIN_MAGIC, sizeof(ACCOUNT_BIN_MAGIC)) == 0;
+    }
+
+    double seconds_since(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+ParsedAccounts parse_accounts_csv(std::string_view text)
+{
+    ParsedAccounts out;
+    // About 30 bytes per row: avoids most reallocations without a counting pass.
+    out.accounts.reserve(text.size() / 32);
+    bool first{ true };
+    while (!text.empty()) {
+        auto end = text.find('\n');
+        auto line = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (line.empty())
+            continue;
+
+        Account acct;
+        if (parse_line(line, acct))
+            out.accounts.push_back(std::move(acct));
+        else if (!(first && line.substr(0, 5) == "name,")) // A header is not a bad row.
+            ++out.bad_rows;
+        first = false;
+    }
+    return out;
+}
+
+ParsedAccounts parse_accounts_bin(std::string_view bytes)
+{
+    ParsedAccounts out;
+    const std::size_t n = bytes.size() / sizeof(AccountRecord);
+    out.accounts.reserve(n);
+    for (std::size_t i{ 0 }; i < n; ++i) {
+        AccountRecord r;
+        std::memcpy(&r, bytes.data() + i * sizeof(AccountRecord), sizeof(AccountRecord));
+        auto name_len = static_cast<std::size_t>(std::find(r.m_name, r.m_name + AccountRecord::NAME_SIZE, '\0') - r.m_name);
+        if (name_len == 0) {
+            ++out.bad_rows;
+            continue;
+        }
+        out.accounts.emplace_back(std::string(r.m_name, name_len), r.m_bank_code, r.m_branch_code, r.m_number,
+                                  r.m_balance);
+    }
+    if (bytes.size() % sizeof(AccountRecord) != 0)
+        ++out.bad_rows;
+    return out;
+}
+
+namespace {
+    /// Cuts a whole dump into about `chunks` pieces, at line (CSV) or record (binary) boundaries.
+    std::vector<std::string_view> split_chunks(std::string_view data, std::size_t chunks, bool binary)
+    {
+        if (binary)
+            data.remove_prefix(sizeof(ACCOUNT_BIN_MAGIC));
+        chunks = std::max<std::size_t>(1, chunks);
+
+        // Cut points: CSV chunks end after a newline, binary chunks on a record boundary.
+        std::vector<std::string_view> pieces;
+        const std::size_t unit = binary ? sizeof(AccountRecord) : 1;
+        const std::size_t target = (data.size() / unit + chunks - 1) / chunks * unit;
+        while (!data.empty()) {
+            std::size_t cut = std::min(data.size(), std::max(target, unit));
+            if (!binary && cut < data.size()) {
+                auto nl = data.find('\n', cut - 1);
+                cut = nl == std::string_view::npos ? data.size() : nl + 1;
+            }
+            pieces.push_back(data.substr(0, cut));
+            data.remove_prefix(cut);
+        }
+        return pieces;
+    }
+
+    std::future<ParsedAccounts> submit_chunk(ac::ThreadPool& pool, std::string_view piece, bool binary)
+    {
+        return pool.submit([piece, binary] { return binary ? parse_accounts_bin(piece) : parse_accounts_csv(piece); });
+    }
+
+    /// Upper bound on the rows of a dump: one per record, or one per line.
+    std::size_t max_rows(std::string_view data, bool binary)
+    {
+        if (binary)
+            return (data.size() - sizeof(ACCOUNT_BIN_MAGIC)) / sizeof(AccountRecord);
+        return static_cast<std::size_t>(std::count(data.begin(), data.end(), '\n')) + 1;
+    }
+}
+
+ParsedAccounts parse_accounts(std::string_view data, ac::ThreadPool& pool, std::size_t chunks)
+{
+    const bool binary = is_binary(data);
+    std::vector<std::future<ParsedAccounts>> parts;
+    for (auto piece : split_chunks(data, chunks, binary))
+        parts.push_back(submit_chunk(pool, piece, binary));
+
+    ParsedAccounts all;
+    for (auto& part : parts) {
+        auto r = part.get();
+        all.bad_rows += r.bad_rows;
+        std::move(r.accounts.begin(), r.accounts.end(), std::back_inserter(all.accounts));
+    }
+    return all;
+}
+
+LoadReport load_accounts(const std::string& path, AccountTbl& table, std::size_t threads)
+{
+    LoadReport report;
+    auto start = std::chrono::steady_clock::now();
+    MappedFile file(path);
+    report.bytes = file.view().size();
+    const bool binary = is_binary(file.view());
+    ac::ThreadPool pool(threads);
+    // Many small chunks, only a couple per thread parsed ahead of the inserts: the rows waiting
+    // for the table stay a small part of the dump.
+    const auto pieces = split_chunks(file.view(), 16 * pool.size(), binary);
+    const std::size_t ahead = 2 * pool.size();
+    std::deque<std::future<ParsedAccounts>> parts;
+    std::size_t next{ 0 };
+    for (; next < pieces.size() && next < ahead; ++next)
+        parts.push_back(submit_chunk(pool, pieces[next], binary));
+    report.parse_seconds += seconds_since(start);
+
+    // Sized once, from the dump itself, while the first chunks parse.
+    start = std::chrono::steady_clock::now();
+    table.reserve(table.size() + max_rows(file.view(), binary));
+    report.insert_seconds += seconds_since(start);
+
+    // Each chunk goes into the table in input order as soon as it is parsed, then is freed
+    // along with its part of the mapping.
+    for (std::size_t i{ 0 }; i < pieces.size(); ++i) {
+        start = std::chrono::steady_clock::now();
+        auto chunk = parts.front().get();
+        parts.pop_front();
+        file.release(pieces[i]);
+        if (next < pieces.size())
+            parts.push_back(submit_chunk(pool, pieces[next++], binary));
+        report.parse_seconds += seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        report.rows += chunk.accounts.size();
+        report.bad_rows += chunk.bad_rows;
+        for (auto& acct : chunk.accounts)
+            table.insert_or_assign(acct.getKey(), std::move(acct));
+        report.insert_seconds += seconds_since(start);
+    }
+    report.inserted = table.size();
+    report.peak_rss_kb = peak_rss_kb();
+    return report;
+}
+
+void write_sample_dump(const std::string& path, std::size_t n, bool binary)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (binary)
+        out.write(ACCOUNT_BIN_MAGIC, sizeof(ACCOUNT_BIN_MAGIC));
+    else
+        out << "name,bank,branch,number,balance\n";
+    for (std::size_t i{ 0 }; i < n; ++i) {
+        Account a{ "Client #" + std::to_string(i), 1 + static_cast<int>(i % 7), static_cast<int>(i % 997),
+                   static_cast<int>(i), static_cast<float>(i % 10000) / 4 };
+        if (binary) {
+            AccountRecord r{};
+            a.m_name.copy(r.m_name, AccountRecord::NAME_SIZE);
+            r.m_bank_code = a.m_bank_code;
+            r.m_branch_code = a.m_branch_code;
+            r.m_number = a.m_number;
+            r.m_balance = a.m_balance;
+            out.write(reinterpret_cast<const char*>(&r), sizeof(r));
+        } else {
+            out << a.m_name << ',' << a.m_bank_code << ',' << a.m_branch_code << ',' << a.m_number << ','
+                << a.m_balance << '\n';
+        }
+    }
+    if (!out)
+        throw std::runtime_error("cannot write " + path);
+}
+
+std::size_t peak_rss_kb()
+{
+#ifdef ACCOUNT_LOADER_POSIX
+    struct rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return static_cast<std::size_t>(usage.ru_maxrss) / 1024; // Bytes on macOS.
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#endif
+#else
+    return 0;
+#endif
+}
+
+double LoadReport::rows_per_second() const
+{
+    const double total = parse_seconds + insert_seconds;
+    return total > 0 ? static_cast<double>(rows) / total : 0;
+}
+
+std::ostream& operator<<(std::ostream& os, const LoadReport& r)
+{
+    return os << ">>> Loaded " << r.rows << " rows (" << r.bad_rows << " bad, " << r.inserted
+              << " distinct keys) from " << r.bytes << " bytes\n"
+              << ">>> parse " << r.parse_seconds << " s, insert " << r.insert_seconds << " s: "
+              << static_cast<std::size_t>(r.rows_per_second()) << " rows/s\n"
+              << ">>> peak RSS " << r.peak_rss_kb / 1024 << " MiB\n";
+}
@@ -0,0 +1,84 @@
+/*!
+ * @file: account_loader.h
+ * @brief Parallel loading of account dumps (CSV or fixed-size binary records) into a table.
+ */
+
+#ifndef ACCOUNT_LOADER_H
+#define ACCOUNT_LOADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../include/hashtbl.h"
+#include "../include/thread_pool.h"
+#include "account.h"
+
+/// The table the driver fills: accounts by key.
+using AccountTbl = ac::HashTbl<Account::AcctKey, Account, KeyHash, KeyEqual>;
+
+/*!
+ * Binary dump: the 8-byte magic "ACCTBIN1", then fixed-size records, so that a dump splits
+ * into chunks at any multiple of the record size. Names longer than the field are cut.
+ */
+struct AccountRecord {
+    static constexpr std::size_t NAME_SIZE = 48;
+    char m_name[NAME_SIZE];    //!< Client name, padded with '\0'.
+    std::int32_t m_bank_code;
+    std::int32_t m_branch_code;
+    std::int32_t m_number;
+    float m_balance;
+};
+static_assert(sizeof(AccountRecord) == 64, "binary dumps use 64-byte records");
+inline constexpr char ACCOUNT_BIN_MAGIC[8] = { 'A', 'C', 'C', 'T', 'B', 'I', 'N', '1' };
+
+/// Result of parsing one chunk (or a whole dump).
+struct ParsedAccounts {
+    std::vector<Account> accounts;
+    std::size_t bad_rows{0}; //!< Malformed lines or records, skipped.
+};
+
+/// What a load did and cost.
+struct LoadReport {
+    std::size_t rows{0};          //!< Accounts parsed.
+    std::size_t bad_rows{0};      //!< Lines or records skipped.
+    std::size_t inserted{0};      //!< Distinct keys in the table afterwards.
+    std::size_t bytes{0};         //!< Size of the input file.
+    double parse_seconds{0};      //!< Mapping, and waiting for the parallel parsing.
+    double insert_seconds{0};     //!< Sizing the table and inserting (overlaps the parsing).
+    std::size_t peak_rss_kb{0};   //!< Peak resident set size of the process, in KiB.
+
+    double rows_per_second() const;
+};
+std::ostream& operator<<(std::ostream& os, const LoadReport& r);
+
+/// Parses CSV lines "name,bank,branch,number,balance"; a first line starting with "name" is a header.
+ParsedAccounts parse_accounts_csv(std::string_view text);
+/// Parses binary records (without the magic); a trailing partial record counts as bad.
+ParsedAccounts parse_accounts_bin(std::string_view bytes);
+
+/*!
+ * Parses a whole dump on `pool`, in about `chunks` pieces cut at line (CSV) or record
+ * (binary) boundaries. The format is binary if the data starts with ACCOUNT_BIN_MAGIC.
+ * Accounts come out in input order.
+ */
+ParsedAccounts parse_accounts(std::string_view data, ac::ThreadPool& pool, std::size_t chunks);
+
+/*!
+ * Maps `path` and parses it in parallel on `threads` threads (0: one per core). `table` is
+ * sized once from the file (records or lines), and each chunk is inserted in input order as
+ * soon as it is parsed, then freed (a repeated key keeps its last row).
+ * @throws std::runtime_error if the file cannot be read.
+ */
+LoadReport load_accounts(const std::string& path, AccountTbl& table, std::size_t threads = 0);
+
+/// Writes `n` synthetic accounts to `path`, as CSV or binary, to produce test dumps.
+void write_sample_dump(const std::string& path, std::size_t n, bool binary);
+
+/// Peak resident set size of the process in KiB (0 where unknown).
+std::size_t peak_rss_kb();
+
+#endif
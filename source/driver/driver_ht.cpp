@@ -1,19 +1,53 @@
 // @author: Selan
 //
 #include <cassert>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <string>
 #include <tuple>
 
 #include "../include/hashtbl.h"
 #include "account.h"
+#include "account_loader.h"
 
 using namespace ac;
 
+//=== INGESTION MODE
+
+/// driver_hash --load <dump> [threads] | driver_hash --generate <rows> <dump> [--binary]
+static int run_loader(int argc, char* argv[])
+{
+    const std::string mode{ argv[1] };
+    try {
+        if (mode == "--load" && argc >= 3) {
+            AccountTbl contas;
+            auto threads = argc >= 4 ? std::stoul(argv[3]) : 0;
+            std::cout << load_accounts(argv[2], contas, threads);
+            return EXIT_SUCCESS;
+        }
+        if (mode == "--generate" && argc >= 4) {
+            bool binary = argc >= 5 && std::string{ argv[4] } == "--binary";
+            write_sample_dump(argv[3], std::stoul(argv[2]), binary);
+            return EXIT_SUCCESS;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "driver_hash: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    std::cerr << "usage: driver_hash                                 (demo)\n"
+              << "       driver_hash --load <dump> [threads]         (CSV or binary dump)\n"
+              << "       driver_hash --generate <rows> <dump> [--binary]\n";
+    return EXIT_FAILURE;
+}
+
 //=== DRIVER CODE
 
-int main()
+int main(int argc, char* argv[])
 {
+    if (argc > 1)
+        return run_loader(argc, argv);
+
     Account acct("Alex Bastos", 1, 1668, 54321, 1500.f);
     Account my_accounts[] = { { "Alex Bastos", 1, 1668, 54321, 1500.F },
                              { "Aline Souza", 1, 1668, 45794, 530.f },
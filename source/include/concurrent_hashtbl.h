@@ -0,0 +1,83 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef CONCURRENT_HASHTBL_H
+#define CONCURRENT_HASHTBL_H
+
+#include <cstddef>      // std::size_t
+#include <functional>   // std::hash, std::equal_to
+#include <memory>       // std::unique_ptr
+#include <mutex>        // std::unique_lock
+#include <shared_mutex> // std::shared_mutex, std::shared_lock
+#include <vector>
+
+#include "hashtbl.h"
+#include "hash_policy.h" // hash_mix
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Thread-safe hash table made of independently locked HashTbl shards.
+     *
+     * A key goes to the shard picked by the high bits of its (mixed) hash, so the shard
+     * choice does not correlate with the bucket index inside the shard. Each shard is a
+     * HashTbl guarded by its own `std::shared_mutex`: lookups take it shared, updates
+     * exclusive, and a shard that grows rehashes on its own while the others keep working.
+     *
+     * Every member function is safe to call concurrently. References returned by
+     * operator[] stay valid until the key is erased (HashTbl never moves its nodes), but
+     * concurrent accesses to the referenced data must be synchronized by the caller;
+     * update() runs a read-modify-write under the shard lock instead.
+     */
+	template< class KeyType,
+		      class DataType,
+		      class KeyHash = std::hash< KeyType >,
+		      class KeyEqual = std::equal_to< KeyType >,
+		      class IndexPolicy = prime_index_policy >
+	class ConcurrentHashTbl {
+        public:
+            // Aliases
+            using table_type = HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>;
+            using entry_type = typename table_type::entry_type;
+            using size_type  = std::size_t;
+
+            explicit ConcurrentHashTbl( size_type shards_ = DEFAULT_SHARDS, size_type shard_sz_ = DEFAULT_SIZE );
+            ConcurrentHashTbl( const ConcurrentHashTbl& ) = delete;
+            ConcurrentHashTbl& operator=( const ConcurrentHashTbl& ) = delete;
+
+            virtual ~ConcurrentHashTbl() = default;
+
+            bool insert( const KeyType &, const DataType & );
+            bool retrieve( const KeyType &, DataType & ) const;
+            bool contains( const KeyType & ) const;
+            bool erase( const KeyType & );
+            template <class Function> void update( const KeyType &, Function && );
+            DataType& operator[]( const KeyType & );
+            void clear();
+            bool empty() const;
+            size_type size() const;
+            inline size_type shard_count() const { return m_shard_count; };
+            void max_load_factor( float mlf );
+
+        private:
+            /// One lock and its table, on its own cache lines so that shards do not false-share.
+            struct alignas(64) Shard {
+                mutable std::shared_mutex m_mutex;
+                table_type m_table;
+
+                explicit Shard( size_type sz_ ) : m_table(sz_) {}
+            };
+
+            Shard& shard_of( const KeyType& ) const;
+
+        private:
+            size_type m_shard_count; //!< Number of shards (a power of two).
+            unsigned m_shard_shift;  //!< 64 - log2(m_shard_count): keeps the top hash bits.
+            std::vector<std::unique_ptr<Shard>> m_shards; //!< The shards (held by pointer: mutexes cannot move).
+
+            static constexpr size_type DEFAULT_SHARDS = 16;
+            static constexpr size_type DEFAULT_SIZE = 11;
+    };
+
+} // namespace ac
+#include "concurrent_hashtbl.inl"
+#endif
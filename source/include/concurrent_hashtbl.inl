@@ -0,0 +1,207 @@
+#include "concurrent_hashtbl.h"
+
+/*!
+ * @file concurrent_hashtbl.inl
+ * @brief Implementation of the ConcurrentHashTbl class (sharded HashTbl with striped locks).
+ *
+ * Authors: Gabriel Victor and Thiago Raquel.
+ */
+
+namespace ac {
+    /*!
+     * @brief Constructor that creates the shards.
+     *
+     * @param shards Number of shards, rounded up to a power of two. More shards than threads
+     *               keeps two threads from contending on one lock most of the time.
+     * @param shard_sz Initial size of each shard's table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::ConcurrentHashTbl(size_type shards,
+                                                                                            size_type shard_sz)
+    {
+        m_shard_count = 1;
+        unsigned bits{0};
+        while (m_shard_count < shards) {
+            m_shard_count <<= 1;
+            ++bits;
+        }
+        m_shard_shift = 64 - bits;
+
+        m_shards.reserve(m_shard_count);
+        for (size_type i{0}; i < m_shard_count; ++i)
+            m_shards.push_back(std::make_unique<Shard>(shard_sz));
+    }
+
+    /*!
+     * @brief Finds the shard responsible for a key.
+     *
+     * @param key_ The key.
+     * @return The shard, selected by the top bits of the mixed hash.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    typename ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::Shard &
+    ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::shard_of(const KeyType &key_) const
+    {
+        // A shift by 64 is undefined, so a single shard is handled apart.
+        if (m_shard_count == 1)
+            return *m_shards[0];
+        return *m_shards[static_cast<size_type>(hash_mix(KeyHash()(key_)) >> m_shard_shift)];
+    }
+
+    /*!
+     * @brief Inserts a key-value pair, replacing the data if the key already exists.
+     *
+     * @param key_ The key to be inserted.
+     * @param data_item_ The data associated with the key.
+     * @return true if the key was new, false if its data was replaced.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::insert(const KeyType &key_,
+                                                                                      const DataType &data_item_)
+    {
+        auto &shard = shard_of(key_);
+        std::unique_lock lock(shard.m_mutex);
+        return shard.m_table.insert(key_, data_item_);
+    }
+
+    /*!
+     * @brief Retrieves a copy of the data associated with a key.
+     *
+     * @param key_ The key to search for.
+     * @param data_item_ Receives the data.
+     * @return true if the key exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::retrieve(const KeyType &key_,
+                                                                                        DataType &data_item_) const
+    {
+        auto &shard = shard_of(key_);
+        std::shared_lock lock(shard.m_mutex);
+        return shard.m_table.retrieve(key_, data_item_);
+    }
+
+    /*!
+     * @brief Checks whether a key is stored.
+     *
+     * @param key_ The key to search for.
+     * @return true if the key exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::contains(const KeyType &key_) const
+    {
+        auto &shard = shard_of(key_);
+        std::shared_lock lock(shard.m_mutex);
+        return shard.m_table.contains(key_);
+    }
+
+    /*!
+     * @brief Removes a key and its data.
+     *
+     * @param key_ The key to remove.
+     * @return true if the key was found and removed.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::erase(const KeyType &key_)
+    {
+        auto &shard = shard_of(key_);
+        std::unique_lock lock(shard.m_mutex);
+        return shard.m_table.erase(key_);
+    }
+
+    /*!
+     * @brief Applies `fn_` to the data of a key, inserting a value-initialized data first if needed.
+     *
+     * The call holds the shard's exclusive lock, so read-modify-write updates such as
+     * `update(key, [](int &n) { ++n; })` are atomic. `fn_` must not access the table.
+     *
+     * @param key_ The key.
+     * @param fn_ Callable taking a `DataType&`.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class Function>
+    void ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::update(const KeyType &key_,
+                                                                                      Function &&fn_)
+    {
+        auto &shard = shard_of(key_);
+        std::unique_lock lock(shard.m_mutex);
+        std::forward<Function>(fn_)(shard.m_table[key_]);
+    }
+
+    /*!
+     * @brief Access or insert the data associated with a key.
+     *
+     * Finding or inserting the key is thread-safe. The returned reference stays valid until
+     * the key is erased, but reading or writing through it races with other threads using
+     * the same key; use update() for that.
+     *
+     * @param key_ The key to access or insert.
+     * @return A reference to the data associated with the key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    DataType& ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::operator[](const KeyType &key_)
+    {
+        auto &shard = shard_of(key_);
+        std::unique_lock lock(shard.m_mutex);
+        return shard.m_table[key_];
+    }
+
+    /*!
+     * @brief Removes every element, one shard at a time.
+     *
+     * Elements inserted concurrently into an already cleared shard survive.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::clear()
+    {
+        for (auto &shard : m_shards) {
+            std::unique_lock lock(shard->m_mutex);
+            shard->m_table.clear();
+        }
+    }
+
+    /*!
+     * @brief Checks whether every shard is empty.
+     *
+     * @return true if no element was found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::empty() const
+    {
+        return size() == 0;
+    }
+
+    /*!
+     * @brief Returns the number of elements.
+     *
+     * Shards are counted one after the other, so under concurrent updates the result is
+     * only a snapshot of each shard at a slightly different time.
+     *
+     * @return The sum of the shard sizes.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    typename ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size_type
+    ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size() const
+    {
+        size_type total{0};
+        for (auto &shard : m_shards) {
+            std::shared_lock lock(shard->m_mutex);
+            total += shard->m_table.size();
+        }
+        return total;
+    }
+
+    /*!
+     * @brief Sets the maximum load factor of every shard.
+     *
+     * @param mlf The new maximum load factor.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void ConcurrentHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::max_load_factor(float mlf)
+    {
+        for (auto &shard : m_shards) {
+            std::unique_lock lock(shard->m_mutex);
+            shard->m_table.max_load_factor(mlf);
+        }
+    }
+
+} // Namespace ac.
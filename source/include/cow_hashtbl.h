@@ -0,0 +1,105 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef COW_HASHTBL_H
+#define COW_HASHTBL_H
+
+#include <algorithm>    // std::find_if
+#include <array>
+#include <atomic>       // std::atomic_thread_fence
+#include <cstddef>      // std::size_t
+#include <functional>   // std::hash, std::equal_to
+#include <memory>       // std::shared_ptr
+#include <stdexcept>    // std::out_of_range, std::invalid_argument
+#include <vector>
+
+#include "hashtbl.h"     // HashEntry, cache_hash
+#include "hash_policy.h" // prime_index_policy
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Hash table whose copies are O(1) snapshots, sharing storage until either side writes.
+     *
+     * Storage has three levels, all reference counted: a directory of pages, pages of
+     * `PAGE_SIZE` bucket pointers, and one chain (a vector of entries) per non-empty bucket.
+     * Copying a table copies one pointer. The first write after a copy clones the directory
+     * (one pointer per page), the page of the bucket it touches and that bucket's chain; later
+     * writes to the same page and bucket find them unshared and work in place. A copy
+     * therefore costs what the writer touches afterwards, never a pass over the whole table.
+     *
+     * Like HashTbl, a table object is not itself thread-safe. Copying the table must be
+     * synchronized with the writers of the original (e.g. done by the writing thread, or under
+     * its lock); from then on the copy is an independent, consistent point-in-time view that
+     * another thread may read while the original keeps changing. Data is shared between copies
+     * as immutable values: a DataType with interior mutability (e.g. a pointer to a mutable
+     * object) is shared, not cloned.
+     */
+	template< class KeyType,
+		      class DataType,
+		      class KeyHash = std::hash< KeyType >,
+		      class KeyEqual = std::equal_to< KeyType >,
+		      class IndexPolicy = prime_index_policy >
+	class CowHashTbl {
+        public:
+            // Aliases
+            using key_type = KeyType;
+            using mapped_type = DataType;
+            using entry_type = HashEntry<KeyType, DataType>;
+            using size_type  = std::size_t;
+
+            explicit CowHashTbl( size_type table_sz_ = DEFAULT_SIZE );
+            // Copies share storage (O(1)); no move operations, so a "move" is the same cheap copy
+            // and never leaves a table without storage.
+            CowHashTbl( const CowHashTbl& ) = default;
+            CowHashTbl& operator=( const CowHashTbl& ) = default;
+
+            virtual ~CowHashTbl() = default;
+
+            bool insert( const KeyType &, const DataType & );
+            bool retrieve( const KeyType &, DataType & ) const;
+            bool contains( const KeyType & ) const;
+            const DataType& at( const KeyType & ) const;
+            size_type count( const KeyType & ) const;
+            bool erase( const KeyType & );
+            void clear();
+            template <class Function> void for_each( Function && ) const;
+
+            /// A point-in-time copy of the table (same as copying it; named for intent).
+            inline CowHashTbl snapshot() const { return *this; };
+            inline bool empty() const { return m_count == 0; };
+            inline size_type size() const { return m_count; };
+            inline size_type bucket_count() const { return m_size; };
+            float max_load_factor() const;
+            void max_load_factor( float );
+            /// Whether this table still shares its whole directory with another one (e.g. a snapshot).
+            inline bool shared() const { return m_dir.use_count() > 1; };
+
+        private:
+            using node_type = detail::ChainEntry<KeyType, DataType>; // entry_type plus its cached hash
+            using Chain = std::vector<node_type>;
+            static constexpr size_type PAGE_SIZE = 64; //!< Buckets per page: the unit cloned on a write.
+            /// A null chain is an empty bucket.
+            struct Page { std::array<std::shared_ptr<Chain>, PAGE_SIZE> m_chains; };
+            struct Directory { std::vector<std::shared_ptr<Page>> m_pages; };
+
+            static std::shared_ptr<Directory> make_directory( size_type );
+            template <class T> static bool unshared( const std::shared_ptr<T>& );
+            static std::size_t hash_of( const node_type& );
+            const Chain* chain_at( size_type ) const;
+            std::shared_ptr<Chain>& writable_chain( size_type );
+            const node_type* find_entry( const KeyType& ) const;
+            void rehash( size_type );
+
+        private:
+            IndexPolicy m_policy;             //!< Maps hash values to buckets.
+            size_type m_size{0};              //!< Number of buckets.
+            size_type m_count{0};             //!< Number of elements.
+            float m_max_load{1.0f};           //!< Grows when size() > max_load_factor() * bucket_count().
+            std::shared_ptr<Directory> m_dir; //!< Pages of buckets, possibly shared with copies.
+
+            static constexpr size_type DEFAULT_SIZE = 11;
+    };
+
+} // namespace ac
+#include "cow_hashtbl.inl"
+#endif
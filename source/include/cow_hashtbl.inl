@@ -0,0 +1,354 @@
+#include "cow_hashtbl.h"
+
+/*!
+ * @file cow_hashtbl.inl
+ * @brief Implementation of the CowHashTbl class (copy-on-write snapshots of a hash table).
+ *
+ * Authors: Gabriel Victor and Thiago Raquel.
+ */
+
+namespace ac {
+    /*!
+     * @brief Constructor that creates an empty table.
+     *
+     * @param table_sz_ Initial number of buckets, rounded up by the index policy.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::CowHashTbl(size_type table_sz_)
+    {
+        m_size = m_policy.reset(table_sz_);
+        m_dir = make_directory(m_size);
+    }
+
+    /*!
+     * @brief Allocates a directory with the pages for `buckets_` empty buckets.
+     *
+     * @param buckets_ Number of buckets.
+     * @return The new directory.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    std::shared_ptr<typename CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::Directory>
+    CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::make_directory(size_type buckets_)
+    {
+        auto dir = std::make_shared<Directory>();
+        dir->m_pages.reserve((buckets_ + PAGE_SIZE - 1) / PAGE_SIZE);
+        for (size_type i{0}; i < buckets_; i += PAGE_SIZE)
+            dir->m_pages.push_back(std::make_shared<Page>());
+        return dir;
+    }
+
+    /*!
+     * @brief Whether this table holds the only reference to `p_`, so it may write through it.
+     *
+     * A copy on another thread releases its reference after its last read of the object; the
+     * acquire fence orders those reads before the writes this table is about to make.
+     *
+     * @param p_ A directory, page or chain reachable from this table.
+     * @return true if nothing else shares it.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class T>
+    bool CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::unshared(const std::shared_ptr<T> &p_)
+    {
+        if (p_.use_count() != 1)
+            return false;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+
+    /*!
+     * @brief Returns the `KeyHash` of an entry's key, from the entry itself when it caches it.
+     *
+     * @param entry_ An entry of this table.
+     * @return The hash of its key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    std::size_t CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::hash_of(const node_type &entry_)
+    {
+        if constexpr (cache_hash<KeyType>::value)
+            return entry_.m_hash;
+        else
+            return KeyHash()(entry_.m_key);
+    }
+
+    /*!
+     * @brief Returns the chain of bucket `b_` for reading.
+     *
+     * @param b_ Bucket index.
+     * @return The chain, or null if the bucket is empty.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    const typename CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::Chain *
+    CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::chain_at(size_type b_) const
+    {
+        return m_dir->m_pages[b_ / PAGE_SIZE]->m_chains[b_ % PAGE_SIZE].get();
+    }
+
+    /*!
+     * @brief Returns the chain pointer of bucket `b_`, cloning whatever a copy still shares.
+     *
+     * The directory, the page and the chain are each cloned only if shared, so repeated writes
+     * after a snapshot pay for each of them once. The pointer may be null (empty bucket); when it
+     * is not, the chain it points to is this table's own.
+     *
+     * @param b_ Bucket index.
+     * @return Reference to the bucket's slot in its (unshared) page.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    std::shared_ptr<typename CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::Chain> &
+    CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::writable_chain(size_type b_)
+    {
+        if (!unshared(m_dir))
+            m_dir = std::make_shared<Directory>(*m_dir);
+        auto &page = m_dir->m_pages[b_ / PAGE_SIZE];
+        if (!unshared(page))
+            page = std::make_shared<Page>(*page);
+        auto &chain = page->m_chains[b_ % PAGE_SIZE];
+        if (chain != nullptr && !unshared(chain))
+            chain = std::make_shared<Chain>(*chain);
+        return chain;
+    }
+
+    /*!
+     * @brief Finds the entry of a key.
+     *
+     * @param key_ The key.
+     * @return The entry, or null if the key is absent.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    const typename CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::node_type *
+    CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::find_entry(const KeyType &key_) const
+    {
+        auto hash = KeyHash()(key_);
+        const Chain *chain = chain_at(m_policy.index(hash));
+        if (chain == nullptr)
+            return nullptr;
+        for (const auto &entry : *chain)
+            if (entry.hash_may_match(hash) && KeyEqual()(entry.m_key, key_))
+                return &entry;
+        return nullptr;
+    }
+
+    /*!
+     * @brief Inserts a key-value pair, replacing the data if the key already exists.
+     *
+     * Copies of the table keep seeing the previous contents.
+     *
+     * @param key_ The key to be inserted.
+     * @param data_item_ The data associated with the key.
+     * @return true if the key was new, false if its data was replaced.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::insert(const KeyType &key_,
+                                                                               const DataType &data_item_)
+    {
+        auto hash = KeyHash()(key_);
+        auto &chain = writable_chain(m_policy.index(hash));
+        if (chain == nullptr)
+            chain = std::make_shared<Chain>();
+
+        for (auto &entry : *chain) {
+            if (entry.hash_may_match(hash) && KeyEqual()(entry.m_key, key_)) {
+                entry.m_data = data_item_;
+                return false;
+            }
+        }
+        chain->emplace_back(key_, data_item_);
+        chain->back().store_hash(hash);
+
+        if (++m_count > m_max_load * m_size)
+            rehash(m_size * 2);
+        return true;
+    }
+
+    /*!
+     * @brief Retrieves the data associated with a key.
+     *
+     * @param key_ The key to look up.
+     * @param data_item_ Receives the data if the key is found.
+     * @return true if the key was found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::retrieve(const KeyType &key_,
+                                                                                 DataType &data_item_) const
+    {
+        if (auto entry = find_entry(key_)) {
+            data_item_ = entry->m_data;
+            return true;
+        }
+        return false;
+    }
+
+    /*!
+     * @brief Checks whether a key is in the table.
+     *
+     * @param key_ The key to look up.
+     * @return true if the key was found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::contains(const KeyType &key_) const
+    {
+        return find_entry(key_) != nullptr;
+    }
+
+    /*!
+     * @brief Returns the data associated with a key.
+     *
+     * Read-only: writing through a reference could change the copies sharing the entry. The
+     * reference is valid until the next write to this table.
+     *
+     * @param key_ The key to look up.
+     * @return The data.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    const DataType& CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::at(const KeyType &key_) const
+    {
+        if (auto entry = find_entry(key_))
+            return entry->m_data;
+        throw std::out_of_range("Key not found");
+    }
+
+    /*!
+     * @brief Counts the elements with a key.
+     *
+     * @param key_ The key to look up.
+     * @return 1 if the key is in the table, 0 otherwise.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    typename CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size_type
+    CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::count(const KeyType &key_) const
+    {
+        return contains(key_) ? 1 : 0;
+    }
+
+    /*!
+     * @brief Removes the element with a key.
+     *
+     * Nothing is cloned when the key is absent.
+     *
+     * @param key_ The key of the element to be removed.
+     * @return true if the key was found and removed.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::erase(const KeyType &key_)
+    {
+        auto hash = KeyHash()(key_);
+        auto b = m_policy.index(hash);
+        const Chain *shared_chain = chain_at(b);
+        if (shared_chain == nullptr)
+            return false;
+        auto pos = std::find_if(shared_chain->begin(), shared_chain->end(), [&](const node_type &entry) {
+            return entry.hash_may_match(hash) && KeyEqual()(entry.m_key, key_);
+        });
+        if (pos == shared_chain->end())
+            return false;
+
+        auto index = pos - shared_chain->begin();
+        auto &chain = writable_chain(b);
+        if (chain->size() == 1) {
+            chain.reset(); // Empty buckets hold no chain.
+        } else {
+            // Order within a chain does not matter: fill the hole with the last entry
+            if (index + 1 != static_cast<std::ptrdiff_t>(chain->size()))
+                (*chain)[index] = std::move(chain->back());
+            chain->pop_back();
+        }
+        --m_count;
+        return true;
+    }
+
+    /*!
+     * @brief Removes every element, keeping the number of buckets.
+     *
+     * Copies keep their contents: this table simply starts a new directory.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::clear()
+    {
+        m_dir = make_directory(m_size);
+        m_count = 0;
+    }
+
+    /*!
+     * @brief Calls `fn_(key, data)` for every element, in no particular order.
+     *
+     * @param fn_ Function called once per element; it must not modify the table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class Function>
+    void CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::for_each(Function &&fn_) const
+    {
+        for (const auto &page : m_dir->m_pages)
+            for (const auto &chain : page->m_chains)
+                if (chain != nullptr)
+                    for (const auto &entry : *chain)
+                        fn_(entry.m_key, entry.m_data);
+    }
+
+    /*!
+     * @brief Moves the elements to a new directory of (at least) `buckets_` buckets.
+     *
+     * Entries of chains no copy shares are moved; the others are copied, and the copies keep
+     * the old directory.
+     *
+     * @param buckets_ Requested number of buckets, rounded up by the index policy.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::rehash(size_type buckets_)
+    {
+        IndexPolicy policy{m_policy};
+        auto size = policy.reset(buckets_);
+        auto dir = make_directory(size);
+
+        const bool dir_owned = unshared(m_dir);
+        for (auto &page : m_dir->m_pages) {
+            const bool page_owned = dir_owned && unshared(page);
+            for (auto &chain : page->m_chains) {
+                if (chain == nullptr)
+                    continue;
+                const bool chain_owned = page_owned && unshared(chain);
+                for (auto &entry : *chain) {
+                    auto b = policy.index(hash_of(entry));
+                    auto &target = dir->m_pages[b / PAGE_SIZE]->m_chains[b % PAGE_SIZE];
+                    if (target == nullptr)
+                        target = std::make_shared<Chain>();
+                    if (chain_owned)
+                        target->push_back(std::move(entry));
+                    else
+                        target->push_back(entry);
+                }
+            }
+        }
+
+        m_policy = policy;
+        m_size = size;
+        m_dir = std::move(dir);
+    }
+
+    /*!
+     * @brief Sets the maximum load factor, the number of elements per bucket above which the table grows.
+     *
+     * @param mlf The new maximum load factor.
+     * @throws std::invalid_argument if `mlf` is not positive.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::max_load_factor(float mlf)
+    {
+        if (!(mlf > 0))
+            throw std::invalid_argument("max_load_factor must be positive");
+        m_max_load = mlf;
+    }
+
+    /*!
+     * @brief Get the maximum load factor.
+     *
+     * @return The current maximum load factor.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    float CowHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::max_load_factor() const
+    {
+        return m_max_load;
+    }
+
+} // namespace ac
@@ -0,0 +1,201 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <atomic>    // std::atomic, std::atomic_thread_fence
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint64_t
+#include <stdexcept> // std::runtime_error
+#include <vector>
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Epoch-based reclamation (EBR): tells writers when unlinked memory is no longer read.
+     *
+     * Readers wrap every lock-free traversal in a Guard. Entering announces the global epoch in
+     * a slot owned by the reading thread (its own cache line: no line is shared with another
+     * reader); leaving marks the slot idle. Writers unlink nodes first and then hand them to a
+     * RetireList, which stamps them with the current epoch. The global epoch only advances when
+     * every active reader has announced it, so once it is two steps past a stamp, no reader can
+     * still hold a pointer to that node and it can be freed.
+     *
+     * A single process-wide domain (global()) serves every table; each thread takes a slot on
+     * its first read and gives it back when it exits.
+     */
+    class EpochDomain {
+        private:
+            struct Local;
+
+        public:
+            static constexpr std::size_t MAX_THREADS = 256; //!< Threads that may read at the same time.
+
+            /// The domain shared by every lock-free table.
+            static EpochDomain& global()
+            {
+                static EpochDomain domain;
+                return domain;
+            }
+
+            /// Marks the calling thread as reading for the guard's lifetime. Guards can nest.
+            class Guard {
+                public:
+                    explicit Guard( EpochDomain &domain_ = EpochDomain::global() ) : m_local{domain_.local()}
+                    {
+                        if (m_local.m_depth++ == 0) {
+                            m_local.m_slot->m_epoch.store(domain_.m_epoch.load(std::memory_order_relaxed),
+                                                          std::memory_order_relaxed);
+                            // The announcement must be visible before any shared pointer is read.
+                            std::atomic_thread_fence(std::memory_order_seq_cst);
+                        }
+                    }
+                    ~Guard()
+                    {
+                        if (--m_local.m_depth == 0)
+                            m_local.m_slot->m_epoch.store(IDLE, std::memory_order_release);
+                    }
+                    Guard( const Guard& ) = delete;
+                    Guard& operator=( const Guard& ) = delete;
+
+                private:
+                    Local &m_local; //!< The calling thread's slot and nesting depth.
+            };
+
+            /// Current global epoch.
+            std::uint64_t epoch() const { return m_epoch.load(std::memory_order_seq_cst); }
+
+            /*!
+             * @brief Advances the global epoch if every active reader has announced the current one.
+             *
+             * @return The global epoch after the attempt.
+             */
+            std::uint64_t try_advance()
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto current = m_epoch.load(std::memory_order_seq_cst);
+                for (auto &slot : m_slots) {
+                    auto e = slot.m_epoch.load(std::memory_order_acquire);
+                    if (e != IDLE && e != current)
+                        return current;
+                }
+                // Another writer may have advanced it meanwhile: then keep its value.
+                m_epoch.compare_exchange_strong(current, current + 1, std::memory_order_seq_cst);
+                return m_epoch.load(std::memory_order_seq_cst);
+            }
+
+        private:
+            static constexpr std::uint64_t IDLE = ~std::uint64_t{0};
+
+            struct alignas(64) Slot {
+                std::atomic<std::uint64_t> m_epoch{IDLE}; //!< Epoch announced by the reader, or IDLE.
+                std::atomic<bool> m_taken{false};         //!< Whether a live thread owns the slot.
+            };
+
+            /// Per-thread view of the domain: the slot it owns and the guard nesting depth.
+            struct Local {
+                Slot *m_slot{nullptr};
+                unsigned m_depth{0};
+                ~Local()
+                {
+                    if (m_slot != nullptr)
+                        m_slot->m_taken.store(false, std::memory_order_release);
+                }
+            };
+
+            Local& local()
+            {
+                // One slot per thread; the domain is a process-wide singleton, so one Local suffices.
+                thread_local Local tl;
+                if (tl.m_slot == nullptr) {
+                    for (auto &slot : m_slots) {
+                        bool expected{false};
+                        if (slot.m_taken.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                            tl.m_slot = &slot;
+                            break;
+                        }
+                    }
+                    if (tl.m_slot == nullptr)
+                        throw std::runtime_error("EpochDomain: more than MAX_THREADS reading threads");
+                }
+                return tl;
+            }
+
+            EpochDomain() = default;
+
+            Slot m_slots[MAX_THREADS];                       //!< One per reading thread.
+            alignas(64) std::atomic<std::uint64_t> m_epoch{0}; //!< The global epoch.
+    };
+
+    /*!
+     * @brief Memory unlinked by a writer, waiting until no reader can see it.
+     *
+     * Not thread-safe: each writer (or the writers of one table, under their lock) owns one.
+     * The owner must ensure no reader is left before destroying it; the destructor then frees
+     * everything at once.
+     */
+    class RetireList {
+        public:
+            explicit RetireList( EpochDomain &domain_ = EpochDomain::global() ) : m_domain{&domain_} {}
+            RetireList( const RetireList& ) = delete;
+            RetireList& operator=( const RetireList& ) = delete;
+            ~RetireList() { clear(); }
+
+            /*!
+             * @brief Hands over an object that is no longer reachable from the shared structure.
+             *
+             * @param ptr_ The object, destroyed later with `delete`.
+             */
+            template <class T>
+            void retire( T *ptr_ )
+            {
+                m_items.push_back({ ptr_, []( void *p ) { delete static_cast<T*>(p); }, m_domain->epoch() });
+                // Amortize: try to reclaim once the list has grown a bit.
+                if (m_items.size() >= m_next_scan)
+                    reclaim();
+            }
+
+            /// Frees what no reader can reach any more. Returns the number of objects still pending.
+            std::size_t reclaim()
+            {
+                auto epoch = m_domain->try_advance();
+                std::size_t kept{0};
+                for (auto &item : m_items) {
+                    if (item.m_epoch + 2 <= epoch)
+                        item.m_deleter(item.m_ptr);
+                    else
+                        m_items[kept++] = item;
+                }
+                m_items.resize(kept);
+                m_next_scan = 2 * kept + SCAN_THRESHOLD;
+                return kept;
+            }
+
+            /// Frees everything now. Only valid when no reader can hold any of the objects.
+            void clear()
+            {
+                for (auto &item : m_items)
+                    item.m_deleter(item.m_ptr);
+                m_items.clear();
+                m_next_scan = SCAN_THRESHOLD;
+            }
+
+            /// Number of objects waiting to be freed.
+            std::size_t pending() const { return m_items.size(); }
+
+        private:
+            struct Item {
+                void *m_ptr;
+                void (*m_deleter)( void* );
+                std::uint64_t m_epoch; //!< Global epoch when the object was retired.
+            };
+
+            static constexpr std::size_t SCAN_THRESHOLD = 64;
+
+            EpochDomain *m_domain;
+            std::vector<Item> m_items;
+            std::size_t m_next_scan{SCAN_THRESHOLD};
+    };
+
+} // namespace ac
+#endif
@@ -0,0 +1,102 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef FILTERED_HASHTBL_H
+#define FILTERED_HASHTBL_H
+
+#include <algorithm>        // std::max
+#include <cstddef>          // std::size_t
+#include <functional>       // std::hash, std::equal_to
+#include <initializer_list>
+#include <stdexcept>        // std::out_of_range
+#include <utility>          // std::as_const
+
+#include "hashtbl.h"
+#include "hash_policy.h"       // prime_index_policy
+#include "hashtbl_stats.h"     // HashTblStats, detail::FilterCounters
+#include "membership_filter.h" // CountingBloomFilter
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief HashTbl behind a membership filter that answers most lookups of absent keys.
+     *
+     * A CountingBloomFilter holds the hash of every key of the table. A lookup asks it first:
+     * when it says no, the key is absent and the call returns after reading one cache line,
+     * without walking a chain or comparing keys. Otherwise the lookup goes to the table; a
+     * key present in the table is never rejected.
+     *
+     * The filter follows every change: inserts add the key's hash, erase() and erase_if()
+     * remove it, clear() empties it. It indexes hash values rather than buckets, so the
+     * table's own rehashes leave it valid; it is rebuilt from the table, twice as large,
+     * when the table outgrows it, and on an explicit rehash(). stats() reports its size,
+     * the false-positive rate expected from its fill and, with AC_HASHTBL_STATS=1, the
+     * lookups it rejected and let through in vain.
+     *
+     * Worth it when most lookups miss: a lookup that finds its key hashes it twice (once for
+     * the filter, once for the table), and the filter costs about 6 bytes per key.
+     */
+	template< class KeyType,
+		      class DataType,
+		      class KeyHash = std::hash< KeyType >,
+		      class KeyEqual = std::equal_to< KeyType >,
+		      class IndexPolicy = prime_index_policy >
+	class FilteredHashTbl {
+        public:
+            // Aliases
+            using key_type = KeyType;
+            using mapped_type = DataType;
+            using table_type = HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>;
+            using entry_type = typename table_type::entry_type;
+            using size_type  = std::size_t;
+            template <class K>
+            using if_transparent = typename table_type::template if_transparent<K>;
+
+            explicit FilteredHashTbl( size_type table_sz_ = DEFAULT_SIZE );
+            FilteredHashTbl( const std::initializer_list< entry_type > & );
+
+            bool insert( const KeyType &, const DataType & );
+            DataType& operator[]( const KeyType & );
+            bool retrieve( const KeyType &, DataType & ) const;
+            template <class K, class = if_transparent<K>> bool retrieve( const K &, DataType & ) const;
+            bool contains( const KeyType & ) const;
+            template <class K, class = if_transparent<K>> bool contains( const K & ) const;
+            DataType* find( const KeyType & );
+            const DataType* find( const KeyType & ) const;
+            template <class K, class = if_transparent<K>> const DataType* find( const K & ) const;
+            DataType& at( const KeyType & );
+            const DataType& at( const KeyType & ) const;
+            bool erase( const KeyType & );
+            template <class Predicate> size_type erase_if( Predicate );
+            void clear();
+            void rehash( size_type );
+            void reserve( size_type );
+            HashTblStats stats() const;
+            void reset_stats();
+            template <class Function> void for_each( Function &&fn_ ) const { m_table.for_each(fn_); };
+
+            inline bool empty() const { return m_table.empty(); };
+            inline size_type size() const { return m_table.size(); };
+            inline size_type bucket_count() const { return m_table.bucket_count(); };
+            /// Number of keys the filter is sized for; it is rebuilt larger past that.
+            inline size_type filter_capacity() const { return m_filter.capacity(); };
+            inline float max_load_factor() const { return m_table.max_load_factor(); };
+            inline void max_load_factor( float mlf_ ) { m_table.max_load_factor(mlf_); };
+            /// The wrapped table, for read-only use.
+            inline const table_type& table() const { return m_table; };
+
+        private:
+            template <class K> const DataType* lookup( const K & ) const;
+            void add_hash( std::size_t );
+            void rebuild_filter( size_type );
+
+        private:
+            table_type m_table;            //!< The elements.
+            CountingBloomFilter m_filter;  //!< The hashes of the keys of m_table.
+            detail::FilterCounters<AC_HASHTBL_STATS != 0> m_counters; //!< Filter outcomes (empty unless enabled).
+
+            static constexpr size_type DEFAULT_SIZE = 11;
+    };
+
+} // namespace ac
+#include "filtered_hashtbl.inl"
+#endif
@@ -0,0 +1,342 @@
+#include "filtered_hashtbl.h"
+
+/*!
+ * @file filtered_hashtbl.inl
+ * @brief Implementation of the FilteredHashTbl class (HashTbl behind a membership filter).
+ *
+ * Authors: Gabriel Victor and Thiago Raquel.
+ */
+
+namespace ac {
+    /*!
+     * @brief Constructor that creates an empty table.
+     *
+     * @param table_sz_ Initial number of buckets, rounded up by the index policy; the filter
+     *                  is sized for as many keys.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::FilteredHashTbl(size_type table_sz_)
+        : m_table(table_sz_), m_filter(table_sz_)
+    {/*Empty*/}
+
+    /*!
+     * @brief Constructor that inserts the entries of a list (a repeated key keeps its last data).
+     *
+     * @param ilist The entries.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::FilteredHashTbl(
+        const std::initializer_list<entry_type> &ilist)
+        : m_table(ilist)
+    {
+        rebuild_filter(ilist.size());
+    }
+
+    /*!
+     * @brief Inserts a key-value pair; if the key already exists its data is replaced.
+     *
+     * @param key_ The key.
+     * @param data_item_ The data, copied.
+     * @return true if the key is new, false if the existing data was assigned.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::insert(const KeyType &key_, const DataType &data_item_)
+    {
+        if (!m_table.insert(key_, data_item_))
+            return false;
+        add_hash(KeyHash()(key_));
+        return true;
+    }
+
+    /*!
+     * @brief Returns the data of a key, inserting a default-constructed one if the key is absent.
+     *
+     * @param key_ The key.
+     * @return Reference to the data, valid until the key is erased.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    DataType& FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::operator[](const KeyType &key_)
+    {
+        auto before = m_table.size();
+        auto &data = m_table[key_];
+        if (m_table.size() != before)
+            add_hash(KeyHash()(key_)); // Rebuilding the filter leaves the table's nodes in place.
+        return data;
+    }
+
+    /*!
+     * @brief Copies the data of a key.
+     *
+     * @param key_ The key to look up.
+     * @param data_item_ Receives the data if the key is found.
+     * @return true if the key was found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::retrieve(const KeyType &key_, DataType &data_item_) const
+    {
+        const auto *data = lookup(key_);
+        if (data == nullptr)
+            return false;
+        data_item_ = *data;
+        return true;
+    }
+
+    /*!
+     * @brief retrieve() for a key given as any type the hash and equality accept.
+     *
+     * @param key_ The key to look up.
+     * @param data_item_ Receives the data if the key is found.
+     * @return true if the key was found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class K, class>
+    bool FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::retrieve(const K &key_, DataType &data_item_) const
+    {
+        const auto *data = lookup(key_);
+        if (data == nullptr)
+            return false;
+        data_item_ = *data;
+        return true;
+    }
+
+    /*!
+     * @brief Checks whether a key is in the table.
+     *
+     * @param key_ The key to look up.
+     * @return true if the key exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::contains(const KeyType &key_) const
+    {
+        return lookup(key_) != nullptr;
+    }
+
+    /*!
+     * @brief contains() for a key given as any type the hash and equality accept.
+     *
+     * @param key_ The key to look up.
+     * @return true if the key exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class K, class>
+    bool FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::contains(const K &key_) const
+    {
+        return lookup(key_) != nullptr;
+    }
+
+    /*!
+     * @brief Returns a pointer to the data of a key.
+     *
+     * @param key_ The key to look up.
+     * @return The data, or nullptr if the key is absent.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    DataType* FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::find(const KeyType &key_)
+    {
+        return const_cast<DataType*>(std::as_const(*this).lookup(key_));
+    }
+
+    /*!
+     * @brief Returns a pointer to the data of a key.
+     *
+     * @param key_ The key to look up.
+     * @return The data, or nullptr if the key is absent.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    const DataType* FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::find(const KeyType &key_) const
+    {
+        return lookup(key_);
+    }
+
+    /*!
+     * @brief find() for a key given as any type the hash and equality accept.
+     *
+     * @param key_ The key to look up.
+     * @return The data, or nullptr if the key is absent.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class K, class>
+    const DataType* FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::find(const K &key_) const
+    {
+        return lookup(key_);
+    }
+
+    /*!
+     * @brief Returns the data of a key.
+     *
+     * @param key_ The key to look up.
+     * @return Reference to the data.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    DataType& FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::at(const KeyType &key_)
+    {
+        auto *data = find(key_);
+        if (data == nullptr)
+            throw std::out_of_range("Key not found");
+        return *data;
+    }
+
+    /*!
+     * @brief Returns the data of a key.
+     *
+     * @param key_ The key to look up.
+     * @return Reference to the data.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    const DataType& FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::at(const KeyType &key_) const
+    {
+        const auto *data = find(key_);
+        if (data == nullptr)
+            throw std::out_of_range("Key not found");
+        return *data;
+    }
+
+    /*!
+     * @brief Removes a key; a key the filter rejects is not searched for.
+     *
+     * @param key_ The key to remove.
+     * @return true if the key was removed.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::erase(const KeyType &key_)
+    {
+        auto hash = KeyHash()(key_);
+        if (!m_filter.may_contain(hash) || !m_table.erase(key_))
+            return false;
+        m_filter.remove(hash);
+        return true;
+    }
+
+    /*!
+     * @brief Removes every element for which `pred_(key, data)` is true, and their hashes from the filter.
+     *
+     * @param pred_ Predicate called once per element; it must not modify the table.
+     * @return The number of elements removed.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class Predicate>
+    typename FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size_type
+    FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::erase_if(Predicate pred_)
+    {
+        return m_table.erase_if([&](const KeyType &key, const DataType &data) {
+            if (!pred_(key, data))
+                return false;
+            m_filter.remove(KeyHash()(key));
+            return true;
+        });
+    }
+
+    /*!
+     * @brief Removes every element and empties the filter (which keeps its size).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::clear()
+    {
+        m_table.clear();
+        m_filter.clear();
+    }
+
+    /*!
+     * @brief Rehashes the table into `n_` buckets (at least), then rebuilds the filter from it.
+     *
+     * Rebuilding drops the counters left stuck at their maximum by erased keys, and resizes the
+     * filter for the larger of size() and `n_` keys.
+     *
+     * @param n_ The requested bucket count.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::rehash(size_type n_)
+    {
+        m_table.rehash(n_);
+        rebuild_filter(std::max(m_table.size(), n_));
+    }
+
+    /*!
+     * @brief Makes room for `n_` keys in the table and in the filter.
+     *
+     * @param n_ The number of keys.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::reserve(size_type n_)
+    {
+        m_table.reserve(n_);
+        if (n_ > m_filter.capacity())
+            rebuild_filter(n_);
+    }
+
+    /*!
+     * @brief Takes a snapshot of the table's statistics, with the filter's fields filled in.
+     *
+     * @return The statistics (see HashTblStats); the lookup counters of the table only count
+     *         the lookups the filter let through.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    HashTblStats FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::stats() const
+    {
+        auto s = m_table.stats();
+        s.filter_bytes = m_filter.bytes();
+        s.filter_fpr = m_filter.estimated_fpr();
+        m_counters.fill(s);
+        return s;
+    }
+
+    /*!
+     * @brief Sets the table's and the filter's counters back to zero (no effect unless AC_HASHTBL_STATS is on).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::reset_stats()
+    {
+        m_table.reset_stats();
+        m_counters.reset();
+    }
+
+    /*!
+     * @brief Asks the filter, then the table if the filter did not rule the key out.
+     *
+     * @param key_ The key to look up.
+     * @return The data, or nullptr if the key is absent.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class K>
+    const DataType* FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::lookup(const K &key_) const
+    {
+        if (!m_filter.may_contain(KeyHash()(key_))) {
+            m_counters.reject();
+            return nullptr;
+        }
+        const auto *data = m_table.find(key_);
+        if (data == nullptr)
+            m_counters.false_positive();
+        return data;
+    }
+
+    /*!
+     * @brief Adds the hash of a new key to the filter, rebuilding it twice as large once the table outgrows it.
+     *
+     * @param hash_ The hash of the key just inserted.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::add_hash(std::size_t hash_)
+    {
+        if (m_table.size() > m_filter.capacity())
+            rebuild_filter(2 * m_table.size()); // Also adds hash_: the key is in the table already.
+        else
+            m_filter.insert(hash_);
+    }
+
+    /*!
+     * @brief Replaces the filter by one sized for `keys_` keys, holding the hash of every key of the table.
+     *
+     * @param keys_ The number of keys to size the filter for.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void FilteredHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::rebuild_filter(size_type keys_)
+    {
+        CountingBloomFilter filter(keys_);
+        m_table.for_each([&filter](const KeyType &key, const DataType &) { filter.insert(KeyHash()(key)); });
+        m_filter = std::move(filter);
+    }
+
+} // namespace ac
@@ -0,0 +1,103 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef FLAT_HASHTBL_H
+#define FLAT_HASHTBL_H
+
+#include <iostream>         // cout, endl, ostream
+#include <memory>           // std::allocator
+#include <cstdint>          // std::uint8_t, std::uint64_t
+#include <stdexcept>        // std::out_of_range, std::invalid_argument
+#include <functional>       // std::hash, std::equal_to
+#include <initializer_list>
+#include <utility>          // std::move, std::swap
+
+#include "hashtbl.h"        // HashEntry
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Open-addressing hash table with Robin Hood linear probing.
+     *
+     * Same interface as HashTbl, but every entry lives inline in a single flat
+     * array of slots, so a lookup touches one contiguous run of memory instead of
+     * chasing list nodes, and inserting never allocates (except when growing).
+     * Each slot has a one byte probe distance stored in a separate array:
+     * 0 marks an empty slot and `d` means the entry sits `d-1` slots away from its
+     * home position. Removal uses backward-shift deletion, so there are no tombstones.
+     */
+	template< class KeyType,
+		      class DataType,
+		      class KeyHash = std::hash< KeyType >,
+		      class KeyEqual = std::equal_to< KeyType > >
+	class FlatHashTbl {
+        public:
+            // Aliases
+            using entry_type = HashEntry<KeyType,DataType>;
+            using size_type  = std::size_t;
+
+            explicit FlatHashTbl( size_type table_sz_ = DEFAULT_SIZE );
+            FlatHashTbl( const FlatHashTbl& );
+            FlatHashTbl( const std::initializer_list< entry_type > & );
+            FlatHashTbl& operator=( const FlatHashTbl& );
+            FlatHashTbl& operator=( const std::initializer_list< entry_type > & );
+
+            virtual ~FlatHashTbl();
+
+            bool insert( const KeyType &, const DataType &  );
+            bool retrieve( const KeyType &, DataType & ) const;
+            bool erase( const KeyType & );
+            void clear();
+            bool empty() const;
+            inline size_type size() const { return m_count; };
+            inline size_type capacity() const { return m_capacity; };
+            DataType& at( const KeyType& );
+            DataType& operator[]( const KeyType& );
+            size_type count( const KeyType& ) const;
+            float max_load_factor() const;
+            void max_load_factor(float mlf);
+
+            friend std::ostream & operator<<(std::ostream & os_, const FlatHashTbl & ht_)
+            {
+                for (size_t i{0}; i < ht_.m_capacity; ++i) {
+                    os_ << "[" << i << "]->\n";
+                    if (ht_.m_dist[i] != EMPTY)
+                        os_ << ht_.m_slots[i].m_data << "\n";
+                }
+
+                os_ << std::endl;
+
+                return os_;
+            }
+
+        private:
+            using dist_type = std::uint8_t;
+
+            void allocate( size_type );
+            void release( void );
+            void grow( void );
+            void copy_from( const FlatHashTbl& );
+
+            size_type home( const KeyType& ) const;
+            size_type find_index( const KeyType& ) const;
+            size_type place( entry_type&& );
+            bool probe_fits( size_type ) const;
+
+        private:
+            size_type m_capacity{0}; //!< Number of slots (always a power of two).
+            size_type m_count{0};    //!< Number of stored entries.
+            unsigned m_shift{0};     //!< 64 - log2(m_capacity), used to map hashes to slots.
+            float m_factor_load{DEFAULT_LOAD}; //!< Maximum load factor before growing.
+            entry_type *m_slots{nullptr}; //!< Inline entry storage (raw memory, constructed on demand).
+            dist_type *m_dist{nullptr};   //!< Probe distance + 1 of each slot, 0 = empty.
+
+            static constexpr size_type DEFAULT_SIZE = 16;
+            static constexpr size_type MIN_SIZE = 8;
+            static constexpr float DEFAULT_LOAD = 0.875f;
+            static constexpr dist_type EMPTY = 0;
+            static constexpr dist_type MAX_DIST = 255; //!< Probe distance that forces a grow.
+            static constexpr size_type NOT_FOUND = static_cast<size_type>(-1);
+    };
+
+} // MyHashTable
+#include "flat_hashtbl.inl"
+#endif
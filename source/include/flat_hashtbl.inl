@@ -0,0 +1,479 @@
+#include "flat_hashtbl.h"
+
+/*!
+ * @file flat_hashtbl.inl
+ * @brief Implementation of the FlatHashTbl class (Robin Hood open addressing).
+ *
+ * Authors: Gabriel Victor and Thiago Raquel.
+ */
+
+namespace ac {
+    /*!
+     * @brief Constructor that initializes the table with room for at least `sz` slots.
+     *
+     * @param sz Requested number of slots, rounded up to a power of two.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::FlatHashTbl(size_type sz)
+    {
+        allocate(sz);
+    }
+
+    /*!
+     * @brief Constructor that initializes the table based on another existing table.
+     *
+     * @param source The table from which to copy the elements.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::FlatHashTbl(const FlatHashTbl &source)
+    {
+        copy_from(source);
+    }
+
+    /*!
+     * @brief Constructor that initializes the table based on an initializer list.
+     *
+     * @param ilist Initialization list containing key-value pairs.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::FlatHashTbl(const std::initializer_list<entry_type> &ilist)
+    {
+        // Size the table so that the whole list fits without growing.
+        allocate(static_cast<size_type>(ilist.size() / m_factor_load) + 1);
+        for (const auto &entry : ilist)
+            insert(entry.m_key, entry.m_data);
+    }
+
+    /*!
+     * @brief Assignment operator that replaces the table's elements with those of another table.
+     *
+     * @param clone The table to be copied.
+     * @return Reference to the table after the copy.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual> &
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::operator=(const FlatHashTbl &clone)
+    {
+        if (this != &clone) {
+            release();
+            copy_from(clone);
+        }
+        return *this;
+    }
+
+    /*!
+     * @brief Assignment operator that replaces the table's elements with those of an initializer list.
+     *
+     * @param ilist Initialization list containing key-value pairs.
+     * @return Reference to the table after the copy.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual> &
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::operator=(const std::initializer_list<entry_type> &ilist)
+    {
+        clear();
+        for (const auto &entry : ilist)
+            insert(entry.m_key, entry.m_data);
+        return *this;
+    }
+
+    /*!
+     * @brief Destructor that destroys every stored entry and frees the slot arrays.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::~FlatHashTbl()
+    {
+        release();
+    }
+
+    /*!
+     * @brief Inserts a new key-value pair into the table.
+     *
+     * @param key_ The key to be inserted.
+     * @param new_data_ The data associated with the key.
+     * @return true if the insertion was successful, false if the key already exists
+     * (in which case its data is updated).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::insert(const KeyType &key_, const DataType &new_data_)
+    {
+        auto idx = find_index(key_);
+        if (idx != NOT_FOUND) {
+            // The key already exists, update the data
+            m_slots[idx].m_data = new_data_;
+            return false;
+        }
+
+        place(entry_type(key_, new_data_));
+        return true;
+    }
+
+    /*!
+     * @brief Clears all elements from the table, keeping its capacity.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
+    {
+        for (size_type i{0}; i < m_capacity; ++i) {
+            if (m_dist[i] != EMPTY) {
+                m_slots[i].~entry_type();
+                m_dist[i] = EMPTY;
+            }
+        }
+        m_count = 0;
+    }
+
+    /*!
+     * @brief Checks if the table is empty.
+     *
+     * @return true if the table is empty, false otherwise.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::empty() const
+    {
+        return m_count == 0;
+    }
+
+    /*!
+     * @brief Retrieves the data associated with a given key.
+     *
+     * @param key_ The key to search for.
+     * @param data_item_ The variable to store the retrieved data.
+     * @return true if the retrieval was successful, false if the key does not exist.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::retrieve(const KeyType &key_, DataType &data_item_) const
+    {
+        auto idx = find_index(key_);
+        if (idx == NOT_FOUND)
+            return false;
+
+        data_item_ = m_slots[idx].m_data;
+        return true;
+    }
+
+    /*!
+     * @brief Removes the element with the provided key.
+     *
+     * The entries that follow the removed one in the same cluster are shifted one
+     * slot back (backward-shift deletion), so no tombstone is left behind.
+     *
+     * @param key_ The key of the element to be removed.
+     * @return true if the removal is successful, false if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::erase(const KeyType &key_)
+    {
+        auto idx = find_index(key_);
+        if (idx == NOT_FOUND)
+            return false;
+
+        const size_type mask = m_capacity - 1;
+        m_slots[idx].~entry_type();
+
+        // Pull back every following entry that is not in its home slot.
+        auto next = (idx + 1) & mask;
+        while (m_dist[next] > 1) {
+            ::new (static_cast<void*>(m_slots + idx)) entry_type(std::move(m_slots[next]));
+            m_slots[next].~entry_type();
+            m_dist[idx] = m_dist[next] - 1;
+            idx = next;
+            next = (next + 1) & mask;
+        }
+        m_dist[idx] = EMPTY;
+
+        m_count--;
+        return true;
+    }
+
+    /*!
+     * @brief Returns the number of elements stored with the given key.
+     *
+     * @param key_ The key to count.
+     * @return 1 if the key is in the table, 0 otherwise.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    typename FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::count(const KeyType &key_) const
+    {
+        return find_index(key_) == NOT_FOUND ? 0 : 1;
+    }
+
+    /*!
+     * @brief Retrieves the value associated with the specified key.
+     *
+     * @param key_ The key to retrieve the associated value.
+     * @return A reference to the value associated with the key.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    DataType& FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::at(const KeyType &key_)
+    {
+        auto idx = find_index(key_);
+        if (idx == NOT_FOUND)
+            throw std::out_of_range("Key not found");
+
+        return m_slots[idx].m_data;
+    }
+
+    /*!
+     * @brief Access or insert the value associated with the specified key.
+     *
+     * If the key is not found, a new element with a default-constructed value is inserted.
+     *
+     * @param key_ The key to access or insert.
+     * @return A reference to the value associated with the key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    DataType& FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::operator[](const KeyType &key_)
+    {
+        auto idx = find_index(key_);
+        if (idx == NOT_FOUND) {
+            idx = place(entry_type(key_, DataType{}));
+        }
+
+        return m_slots[idx].m_data;
+    }
+
+    /*!
+     * @brief Set the maximum load factor for the table.
+     *
+     * @param mlf The new maximum load factor, in the open interval (0, 1).
+     * @throws std::invalid_argument if `mlf` is out of range.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::max_load_factor(float mlf)
+    {
+        // An open-addressing table must always keep at least one empty slot.
+        if (!(mlf > 0.f && mlf < 1.f))
+            throw std::invalid_argument("max_load_factor must be in (0, 1)");
+        m_factor_load = mlf;
+    }
+
+    /*!
+     * @brief Get the current maximum load factor for the table.
+     *
+     * @return The current maximum load factor.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    float FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::max_load_factor() const
+    {
+        return m_factor_load;
+    }
+
+
+
+    /*=================== Métodos auxiliares ==============================*/
+    /*!
+     * @brief Allocates empty slot arrays with room for at least `sz` slots.
+     *
+     * @param sz Requested number of slots, rounded up to a power of two.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::allocate(size_type sz)
+    {
+        m_capacity = MIN_SIZE;
+        m_shift = 64 - 3;
+        while (m_capacity < sz) {
+            m_capacity <<= 1;
+            m_shift--;
+        }
+
+        m_slots = std::allocator<entry_type>().allocate(m_capacity);
+        m_dist = new dist_type[m_capacity](); // All slots start empty.
+        m_count = 0;
+    }
+
+    /*!
+     * @brief Destroys every stored entry and frees the slot arrays.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::release(void)
+    {
+        if (m_slots == nullptr)
+            return;
+
+        clear();
+        std::allocator<entry_type>().deallocate(m_slots, m_capacity);
+        delete [] m_dist;
+        m_slots = nullptr;
+        m_dist = nullptr;
+        m_capacity = 0;
+    }
+
+    /*!
+     * @brief Copies capacity, load factor and entries (at the same slots) from another table.
+     *
+     * @param source The table to copy from. The current table must hold no storage.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::copy_from(const FlatHashTbl &source)
+    {
+        m_factor_load = source.m_factor_load;
+        allocate(source.m_capacity);
+
+        // Same capacity means same home slots, so the layout can be copied verbatim.
+        for (size_type i{0}; i < m_capacity; ++i) {
+            if (source.m_dist[i] != EMPTY)
+                ::new (static_cast<void*>(m_slots + i)) entry_type(source.m_slots[i]);
+            m_dist[i] = source.m_dist[i];
+        }
+        m_count = source.m_count;
+    }
+
+    /*!
+     * @brief Doubles the number of slots and reinserts every entry.
+     *
+     * Entries are moved (not copied) into the new array.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::grow(void)
+    {
+        auto old_slots = m_slots;
+        auto old_dist = m_dist;
+        auto old_capacity = m_capacity;
+
+        allocate(old_capacity * 2);
+
+        for (size_type i{0}; i < old_capacity; ++i) {
+            if (old_dist[i] != EMPTY) {
+                place(std::move(old_slots[i]));
+                old_slots[i].~entry_type();
+            }
+        }
+
+        std::allocator<entry_type>().deallocate(old_slots, old_capacity);
+        delete [] old_dist;
+    }
+
+    /*!
+     * @brief Computes the home slot of a key.
+     *
+     * The hash is spread with a Fibonacci multiplier before taking its top bits, so
+     * weak hashes (e.g. the identity `std::hash<int>`) still fill the whole array.
+     *
+     * @param key_ The key.
+     * @return The index of the preferred slot for the key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    typename FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::home(const KeyType &key_) const
+    {
+        std::uint64_t h = KeyHash()(key_);
+        return static_cast<size_type>((h * 0x9E3779B97F4A7C15ull) >> m_shift);
+    }
+
+    /*!
+     * @brief Locates the slot holding a key.
+     *
+     * The probe stops as soon as it reaches a slot whose entry is closer to its own
+     * home than the key would be: by the Robin Hood invariant the key cannot be
+     * further along. Keys are only compared when the probe distances match.
+     *
+     * @param key_ The key to search for.
+     * @return The slot index, or NOT_FOUND.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    typename FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::find_index(const KeyType &key_) const
+    {
+        const size_type mask = m_capacity - 1;
+        auto idx = home(key_);
+        dist_type dist = 1;
+
+        while (true) {
+            auto d = m_dist[idx];
+            if (d < dist)
+                return NOT_FOUND;
+            if (d == dist && KeyEqual()(m_slots[idx].m_key, key_))
+                return idx;
+            idx = (idx + 1) & mask;
+            ++dist; // Stops at MAX_DIST at the latest, since no stored distance reaches it.
+        }
+    }
+
+    /*!
+     * @brief Places an entry whose key is known not to be in the table.
+     *
+     * Robin Hood rule: walking forward from the home slot, the carried entry swaps
+     * places with any resident that is closer to its own home, and the evicted
+     * resident continues the walk. The table grows when it would exceed the
+     * maximum load factor or when a probe distance would overflow; both are
+     * decided before any resident is displaced.
+     *
+     * @param entry_ The entry to place.
+     * @return The slot where `entry_` ended up.
+     * @throws std::length_error if the hash keeps overflowing the probe distance,
+     * which only happens when a huge number of keys share the same hash value.
+     * The table is left unchanged.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    typename FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
+    FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::place(entry_type &&entry_)
+    {
+        if (m_count + 1 > m_capacity * m_factor_load)
+            grow();
+        while (!probe_fits(home(entry_.m_key))) {
+            // Clusters this long mean the hash is degenerate; a bigger array spreads them.
+            if (m_count < m_capacity / 8)
+                throw std::length_error("FlatHashTbl: too many keys with the same hash");
+            grow();
+        }
+
+        entry_type carry(std::move(entry_));
+        bool displaced = false;  // Whether `carry` no longer holds the new entry.
+        size_type result = NOT_FOUND;
+
+        const size_type mask = m_capacity - 1;
+        auto idx = home(carry.m_key);
+        dist_type dist = 1;
+
+        while (true) {
+            if (m_dist[idx] == EMPTY) {
+                ::new (static_cast<void*>(m_slots + idx)) entry_type(std::move(carry));
+                m_dist[idx] = dist;
+                m_count++;
+                return displaced ? result : idx;
+            }
+
+            if (m_dist[idx] < dist) {
+                using std::swap;
+                swap(carry, m_slots[idx]);
+                swap(dist, m_dist[idx]);
+                if (!displaced) {
+                    displaced = true;
+                    result = idx;
+                }
+            }
+
+            idx = (idx + 1) & mask;
+            ++dist; // Below MAX_DIST: probe_fits() walked the same distances.
+        }
+    }
+
+    /*!
+     * @brief Dry run of place() on the probe distances alone: whether the walk from a home
+     * slot reaches an empty slot before any carried distance reaches MAX_DIST.
+     *
+     * The walk only depends on the distances, since a swap hands it the resident's distance.
+     *
+     * @param idx_ The home slot of the entry to place.
+     * @return true if place() can finish without growing.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool FlatHashTbl<KeyType, DataType, KeyHash, KeyEqual>::probe_fits(size_type idx_) const
+    {
+        const size_type mask = m_capacity - 1;
+        dist_type dist = 1;
+        while (dist != MAX_DIST) {
+            if (m_dist[idx_] == EMPTY)
+                return true;
+            if (m_dist[idx_] < dist)
+                dist = m_dist[idx_];
+            idx_ = (idx_ + 1) & mask;
+            ++dist;
+        }
+        return false;
+    }
+
+} // Namespace ac.
@@ -0,0 +1,104 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef FROZEN_HASHTBL_H
+#define FROZEN_HASHTBL_H
+
+#include <algorithm>    // std::stable_sort, std::fill
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <functional>   // std::hash, std::equal_to
+#include <limits>       // std::numeric_limits
+#include <numeric>      // std::iota
+#include <stdexcept>    // std::out_of_range, std::invalid_argument, std::runtime_error
+#include <utility>      // std::move
+#include <vector>
+
+#include "hashtbl.h"
+#include "hash_policy.h" // hash_mix, detail::mul_wide
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Immutable table over a fixed key set, indexed by a minimal perfect hash.
+     *
+     * Built once from a HashTbl (see freeze()), it places its `n` keys and data in two dense
+     * arrays of exactly `n` slots, and a lookup is one slot computation, one key compare and
+     * one data read: no chain, no probing, no empty slot.
+     *
+     * The perfect hash is PTHash-style. Keys are split into about `n / BUCKET_LOAD` buckets;
+     * each bucket gets a 32-bit pilot, searched at build time (largest buckets first) so that
+     * `mix(hash + pilot * step)` sends each key of the bucket to a slot no other key took. A lookup
+     * thus hashes the key, reads the pilot of its bucket and computes the slot; the pilots are
+     * the whole index, `32 / BUCKET_LOAD` bits per key (see bits_per_key()).
+     *
+     * A key absent from the set still maps to some slot, which the key compare rejects. Two
+     * distinct keys with the same `KeyHash` value cannot be separated, and make the build throw.
+     */
+	template< class KeyType,
+		      class DataType,
+		      class KeyHash = std::hash< KeyType >,
+		      class KeyEqual = std::equal_to< KeyType > >
+	class FrozenHashTbl {
+        public:
+            // Aliases
+            using key_type = KeyType;
+            using mapped_type = DataType;
+            using size_type  = std::size_t;
+
+            FrozenHashTbl() = default;
+            template <class IndexPolicy, class Allocator>
+            explicit FrozenHashTbl( const HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator> & );
+
+            bool retrieve( const KeyType &, DataType & ) const;
+            bool contains( const KeyType & ) const;
+            const DataType& at( const KeyType & ) const;
+            size_type count( const KeyType & ) const;
+            template <class Function> void for_each( Function && ) const;
+
+            inline bool empty() const { return m_keys.empty(); };
+            inline size_type size() const { return m_keys.size(); };
+            /// Bits of index (pilots) per key, on top of the keys and data themselves.
+            inline double bits_per_key() const { return empty() ? 0.0 : 32.0 * m_pilots.size() / size(); };
+
+        private:
+            /// Maps a 64-bit mixed hash into [0, n_) (Lemire's multiply-shift reduction).
+            static size_type reduce( std::uint64_t x_, size_type n_ )
+            {
+                return static_cast<size_type>(detail::mul_wide(x_, n_).m_hi);
+            }
+            std::uint64_t key_hash( std::size_t hash_ ) const { return hash_mix(hash_ ^ m_seed); };
+            /// Slot of a key hashed by key_hash(), in a table of `n_` slots, for a given pilot.
+            static size_type slot( std::uint64_t key_hash_, std::uint64_t pilot_, size_type n_ )
+            {
+                return reduce(hash_mix(key_hash_ + pilot_ * PILOT_STEP), n_);
+            }
+            size_type slot_of( const KeyType & ) const;
+            bool build( const std::vector<std::size_t> &, std::vector<size_type> & );
+
+        private:
+            std::vector<KeyType> m_keys;         //!< Key of each slot.
+            std::vector<DataType> m_data;        //!< Data of each slot.
+            std::vector<std::uint32_t> m_pilots; //!< Pilot of each bucket.
+            std::uint64_t m_seed{0};             //!< Seed of the key hashes that succeeded.
+
+            static constexpr size_type BUCKET_LOAD = 4;    //!< Average keys per bucket.
+            static constexpr unsigned MAX_ATTEMPTS = 16;   //!< Seeds tried before giving up.
+            static constexpr std::uint64_t PILOT_STEP = 0x9E3779B97F4A7C15ull; //!< Odd: pilots give distinct offsets.
+    };
+
+    /*!
+     * @brief Builds the FrozenHashTbl of a table's current contents.
+     *
+     * @param table_ The table to freeze (left unchanged).
+     * @return An immutable copy answering lookups with one probe.
+     */
+    template <class KeyType, class DataType, class KeyHash, class KeyEqual, class IndexPolicy, class Allocator>
+    FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>
+    freeze( const HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator> &table_ )
+    {
+        return FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>( table_ );
+    }
+
+} // namespace ac
+#include "frozen_hashtbl.inl"
+#endif
@@ -0,0 +1,229 @@
+#include "frozen_hashtbl.h"
+
+/*!
+ * @file frozen_hashtbl.inl
+ * @brief Implementation of the FrozenHashTbl class (minimal perfect hash over a fixed key set).
+ *
+ * Authors: Gabriel Victor and Thiago Raquel.
+ */
+
+namespace ac {
+    /*!
+     * @brief Constructor that freezes the current contents of a HashTbl.
+     *
+     * @param table_ The table whose elements are copied.
+     * @throws std::invalid_argument if two distinct keys have the same `KeyHash` value.
+     * @throws std::runtime_error if no seed yields a perfect hash (not expected in practice).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    template <class IndexPolicy, class Allocator>
+    FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>::FrozenHashTbl(
+        const HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator> &table_)
+    {
+        std::vector<const KeyType*> keys;
+        std::vector<const DataType*> data;
+        std::vector<std::size_t> hashes;
+        keys.reserve(table_.size());
+        data.reserve(table_.size());
+        hashes.reserve(table_.size());
+        table_.for_each([&](const KeyType &key, const DataType &value) {
+            keys.push_back(&key);
+            data.push_back(&value);
+            hashes.push_back(KeyHash()(key));
+        });
+        if (keys.empty())
+            return;
+
+        std::vector<size_type> slots;
+        if (!build(hashes, slots))
+            throw std::runtime_error("FrozenHashTbl: no perfect hash found");
+
+        // Lay the elements out in slot order
+        std::vector<size_type> owner(keys.size());
+        for (size_type i{0}; i < keys.size(); ++i)
+            owner[slots[i]] = i;
+        m_keys.reserve(keys.size());
+        m_data.reserve(keys.size());
+        for (auto i : owner) {
+            m_keys.push_back(*keys[i]);
+            m_data.push_back(*data[i]);
+        }
+    }
+
+    /*!
+     * @brief Searches the seed and the pilots of a minimal perfect hash of `hashes_`.
+     *
+     * Each attempt draws a seed, splits the keys into buckets and, from the largest bucket to
+     * the smallest, tries pilots 0, 1, 2, ... until every key of the bucket lands on a free
+     * slot. Large buckets go first, while most slots are free; single-key buckets fill the
+     * last slots. Another seed is only tried if some bucket exhausts the 32-bit pilots.
+     *
+     * @param hashes_ The `KeyHash` value of every key.
+     * @param slots_ Receives the slot of every key, a permutation of [0, n).
+     * @return true on success (m_seed and m_pilots are set), false if every seed failed.
+     * @throws std::invalid_argument if two keys have the same hash.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>::build(const std::vector<std::size_t> &hashes_,
+                                                                    std::vector<size_type> &slots_)
+    {
+        const size_type n = hashes_.size();
+        const size_type buckets = (n + BUCKET_LOAD - 1) / BUCKET_LOAD;
+        std::vector<std::uint64_t> key_hashes(n);
+        std::vector<size_type> bucket_of(n), start(buckets + 1), members(n), order(buckets);
+        std::vector<bool> taken(n);
+        slots_.assign(n, 0);
+
+        for (unsigned attempt{0}; attempt < MAX_ATTEMPTS; ++attempt) {
+            m_seed = hash_mix(attempt + 1);
+
+            // Group the keys by bucket (counting sort)
+            std::fill(start.begin(), start.end(), 0);
+            for (size_type i{0}; i < n; ++i) {
+                key_hashes[i] = key_hash(hashes_[i]);
+                bucket_of[i] = reduce(key_hashes[i], buckets);
+                ++start[bucket_of[i] + 1];
+            }
+            for (size_type b{0}; b < buckets; ++b)
+                start[b + 1] += start[b];
+            std::vector<size_type> cursor(start.begin(), start.end() - 1);
+            for (size_type i{0}; i < n; ++i)
+                members[cursor[bucket_of[i]]++] = i;
+
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+                return start[a + 1] - start[a] > start[b + 1] - start[b];
+            });
+
+            std::fill(taken.begin(), taken.end(), false);
+            m_pilots.assign(buckets, 0);
+            bool placed{true};
+            for (auto b : order) {
+                const size_type *first = members.data() + start[b];
+                const size_type size = start[b + 1] - start[b];
+                if (size == 0)
+                    break; // Sorted by size: the remaining buckets are empty too.
+
+                // No pilot separates two keys with the same hash
+                for (size_type i{0}; i < size; ++i)
+                    for (size_type j{i + 1}; j < size; ++j)
+                        if (hashes_[first[i]] == hashes_[first[j]])
+                            throw std::invalid_argument("FrozenHashTbl: distinct keys with the same hash");
+
+                placed = false;
+                for (std::uint64_t pilot{0}; pilot <= std::numeric_limits<std::uint32_t>::max() && !placed; ++pilot) {
+                    size_type k{0};
+                    for (; k < size; ++k) {
+                        auto s = slot(key_hashes[first[k]], pilot, n);
+                        if (taken[s])
+                            break;
+                        taken[s] = true;
+                        slots_[first[k]] = s;
+                    }
+                    if (k == size) {
+                        m_pilots[b] = static_cast<std::uint32_t>(pilot);
+                        placed = true;
+                    } else {
+                        while (k > 0)
+                            taken[slots_[first[--k]]] = false;
+                    }
+                }
+                if (!placed)
+                    break;
+            }
+            if (placed)
+                return true;
+        }
+        return false;
+    }
+
+    /*!
+     * @brief Computes the only slot where a key may be.
+     *
+     * @param key_ The key (the table must not be empty).
+     * @return The slot index.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    typename FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
+    FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>::slot_of(const KeyType &key_) const
+    {
+        auto kh = key_hash(KeyHash()(key_));
+        return slot(kh, m_pilots[reduce(kh, m_pilots.size())], m_keys.size());
+    }
+
+    /*!
+     * @brief Retrieves the data associated with a key.
+     *
+     * @param key_ The key to look up.
+     * @param data_item_ Receives the data if the key is found.
+     * @return true if the key was found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>::retrieve(const KeyType &key_, DataType &data_item_) const
+    {
+        if (empty())
+            return false;
+        auto s = slot_of(key_);
+        if (!KeyEqual()(m_keys[s], key_))
+            return false;
+        data_item_ = m_data[s];
+        return true;
+    }
+
+    /*!
+     * @brief Checks whether a key is in the table.
+     *
+     * @param key_ The key to look up.
+     * @return true if the key was found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>::contains(const KeyType &key_) const
+    {
+        return !empty() && KeyEqual()(m_keys[slot_of(key_)], key_);
+    }
+
+    /*!
+     * @brief Returns the data associated with a key.
+     *
+     * @param key_ The key to look up.
+     * @return Reference to the data.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    const DataType& FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>::at(const KeyType &key_) const
+    {
+        if (!empty()) {
+            auto s = slot_of(key_);
+            if (KeyEqual()(m_keys[s], key_))
+                return m_data[s];
+        }
+        throw std::out_of_range("Key not found");
+    }
+
+    /*!
+     * @brief Counts the elements with a key.
+     *
+     * @param key_ The key to look up.
+     * @return 1 if the key is in the table, 0 otherwise.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    typename FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
+    FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>::count(const KeyType &key_) const
+    {
+        return contains(key_) ? 1 : 0;
+    }
+
+    /*!
+     * @brief Calls `fn_(key, data)` for every element, in slot order.
+     *
+     * @param fn_ Function called once per element.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    template <class Function>
+    void FrozenHashTbl<KeyType, DataType, KeyHash, KeyEqual>::for_each(Function &&fn_) const
+    {
+        for (size_type i{0}; i < m_keys.size(); ++i)
+            fn_(m_keys[i], m_data[i]);
+    }
+
+} // namespace ac
@@ -0,0 +1,54 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef HASH_FUNCTORS_H
+#define HASH_FUNCTORS_H
+
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+#include <functional>  // std::hash
+#include <string>
+#include <string_view>
+
+#include "hash_policy.h" // detail::mul_wide
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Folds the hash of one more field into a running hash (wyhash's "mum" step).
+     *
+     * Both inputs are xored with odd constants, multiplied into 128 bits, and the two
+     * halves are xored together, so every input bit reaches every output bit and
+     * swapping two fields changes the result (plain `^` of the field hashes does
+     * neither; with `std::hash<int>` being the identity, it even lets fields cancel).
+     *
+     * @param seed_ The hash of the fields combined so far.
+     * @param value_ The hash of the next field.
+     * @return The combined hash.
+     */
+    constexpr std::size_t hash_combine( std::size_t seed_, std::size_t value_ )
+    {
+        const auto product = detail::mul_wide(seed_ ^ 0xA0761D6478BD642Full, value_ ^ 0xE7037ED1A0B428DBull);
+        return static_cast<std::size_t>(product.m_lo ^ product.m_hi);
+    }
+
+    /*!
+     * @brief Transparent hash for string keys.
+     *
+     * Hashes `std::string`, `std::string_view` and `const char*` alike, through
+     * `std::hash<std::string_view>` (which the standard requires to agree with
+     * `std::hash<std::string>`). Paired with `std::equal_to<>`, it lets a
+     * `HashTbl<std::string, D, ac::string_hash, std::equal_to<>>` be probed with a
+     * literal or a view without building a temporary `std::string`:
+     *
+     *     table.retrieve( "word", count );
+     */
+    struct string_hash {
+        using is_transparent = void;
+
+        std::size_t operator()( std::string_view sv_ ) const noexcept { return std::hash<std::string_view>{}(sv_); }
+        std::size_t operator()( const std::string &s_ ) const noexcept { return operator()(std::string_view{s_}); }
+        std::size_t operator()( const char *s_ ) const noexcept { return operator()(std::string_view{s_}); }
+    };
+
+} // namespace ac
+#endif
@@ -0,0 +1,198 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef HASH_POLICY_H
+#define HASH_POLICY_H
+
+#include <array>    // std::array
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint64_t
+#include <utility>  // std::index_sequence
+#include <stdexcept> // std::length_error
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Spreads the bits of a hash value (the 64-bit finalizer of MurmurHash3).
+     *
+     * Needed by policies that only look at some of the hash bits, since
+     * `std::hash` of an integer is the identity on common standard libraries.
+     *
+     * @param h The hash value.
+     * @return The mixed value.
+     */
+    constexpr std::uint64_t hash_mix( std::uint64_t h )
+    {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    namespace detail {
+        /// The 128-bit product of two 64-bit values, as its low and high halves.
+        struct WideProduct {
+            std::uint64_t m_lo;
+            std::uint64_t m_hi;
+        };
+
+        /// Full 64x64-bit multiplication: one instruction where the compiler has a 128-bit type.
+        constexpr WideProduct mul_wide( std::uint64_t a_, std::uint64_t b_ )
+        {
+#ifdef __SIZEOF_INT128__
+            const auto product = static_cast<unsigned __int128>(a_) * b_;
+            return { static_cast<std::uint64_t>(product), static_cast<std::uint64_t>(product >> 64) };
+#else
+            // Schoolbook on 32-bit halves; `mid` collects the carries into the high word.
+            const std::uint64_t a_lo = a_ & 0xFFFFFFFFull, a_hi = a_ >> 32;
+            const std::uint64_t b_lo = b_ & 0xFFFFFFFFull, b_hi = b_ >> 32;
+            const std::uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo, hh = a_hi * b_hi;
+            const std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFull) + (hl & 0xFFFFFFFFull);
+            return { (mid << 32) | (ll & 0xFFFFFFFFull), hh + (lh >> 32) + (hl >> 32) + (mid >> 32) };
+#endif
+        }
+
+        /// Bucket counts of prime_index_policy: each the smallest prime not below 2^(i/2 + 1).
+        inline constexpr std::array<std::uint64_t, 125> PRIMES {
+            2ull, 3ull, 5ull, 7ull, 11ull, 13ull, 17ull, 23ull, 37ull, 47ull, 67ull, 97ull, 131ull,
+            191ull, 257ull, 367ull, 521ull, 727ull, 1031ull, 1451ull, 2053ull, 2897ull, 4099ull,
+            5801ull, 8209ull, 11587ull, 16411ull, 23173ull, 32771ull, 46349ull, 65537ull, 92683ull,
+            131101ull, 185369ull, 262147ull, 370759ull, 524309ull, 741457ull, 1048583ull, 1482919ull,
+            2097169ull, 2965847ull, 4194319ull, 5931649ull, 8388617ull, 11863289ull, 16777259ull,
+            23726569ull, 33554467ull, 47453149ull, 67108879ull, 94906297ull, 134217757ull,
+            189812533ull, 268435459ull, 379625083ull, 536870923ull, 759250133ull, 1073741827ull,
+            1518500279ull, 2147483659ull, 3037000507ull, 4294967311ull, 6074001001ull, 8589934609ull,
+            12148002047ull, 17179869209ull, 24296004011ull, 34359738421ull, 48592008053ull,
+            68719476767ull, 97184016049ull, 137438953481ull, 194368032011ull, 274877906951ull,
+            388736063999ull, 549755813911ull, 777472128049ull, 1099511627791ull, 1554944255989ull,
+            2199023255579ull, 3109888512037ull, 4398046511119ull, 6219777023959ull, 8796093022237ull,
+            12439554047911ull, 17592186044423ull, 24879108095833ull, 35184372088891ull,
+            49758216191633ull, 70368744177679ull, 99516432383281ull, 140737488355333ull,
+            199032864766447ull, 281474976710677ull, 398065729532981ull, 562949953421381ull,
+            796131459065743ull, 1125899906842679ull, 1592262918131449ull, 2251799813685269ull,
+            3184525836262943ull, 4503599627370517ull, 6369051672525833ull, 9007199254740997ull,
+            12738103345051607ull, 18014398509482143ull, 25476206690103097ull, 36028797018963971ull,
+            50952413380206277ull, 72057594037928017ull, 101904826760412407ull, 144115188075855881ull,
+            203809653520824899ull, 288230376151711813ull, 407619307041649517ull, 576460752303423619ull,
+            815238614083298983ull, 1152921504606847009ull, 1630477228166598073ull,
+            2305843009213693967ull, 3260954456333195779ull, 4611686018427388039ull,
+            6521908912666391591ull, 9223372036854775837ull
+        };
+
+        using mod_fn = std::size_t (*)( std::size_t );
+
+        /// Modulo by a compile-time constant, which compiles to a multiply and a shift.
+        template <std::uint64_t P>
+        std::size_t mod( std::size_t hash_ ) { return static_cast<std::size_t>(hash_ % P); }
+
+        template <std::size_t... I>
+        constexpr std::array<mod_fn, sizeof...(I)> make_mods( std::index_sequence<I...> )
+        {
+            return {{ &mod<PRIMES[I]>... }};
+        }
+
+        /// One constant-divisor modulo per entry of PRIMES.
+        inline constexpr std::array<mod_fn, PRIMES.size()> MODS = make_mods(std::make_index_sequence<PRIMES.size()>{});
+    } // namespace detail
+
+    /*!
+     * @brief Bucket-index policy that keeps prime bucket counts (the default).
+     *
+     * Bucket counts come from a precomputed table of primes growing by about
+     * sqrt(2), so no trial division happens at run time. The modulo itself is done
+     * by a function specialized for each prime of the table: since the divisor is a
+     * compile-time constant, the compiler turns `h % P` into a multiply and a shift
+     * instead of a 64-bit division. The hash is used as is, so every bit counts.
+     *
+     * Every index policy provides the same three members:
+     * - `size_type reset( size_type n )`: selects the smallest supported bucket
+     *   count that is at least `n`, remembers it and returns it;
+     * - `size_type index( std::size_t hash ) const`: maps a hash into [0, bucket count);
+     * - `size_type bucket_count() const`: the bucket count selected last.
+     */
+    class prime_index_policy {
+        public:
+            using size_type = std::size_t;
+
+            size_type reset( size_type n_ )
+            {
+                size_type i{0};
+                while (i < detail::PRIMES.size() && detail::PRIMES[i] < n_)
+                    ++i;
+                if (i == detail::PRIMES.size())
+                    throw std::length_error("prime_index_policy: bucket count too large");
+                m_prime = i;
+                return bucket_count();
+            }
+
+            size_type index( std::size_t hash_ ) const { return detail::MODS[m_prime](hash_); }
+
+            size_type bucket_count() const { return static_cast<size_type>(detail::PRIMES[m_prime]); }
+
+        private:
+            size_type m_prime{0}; //!< Index of the current bucket count in detail::PRIMES.
+    };
+
+    /*!
+     * @brief Bucket-index policy with power-of-two bucket counts.
+     *
+     * The hash is mixed and then masked, which replaces the division by one AND.
+     * Mixing is essential here: without it only the low bits of the hash would
+     * matter.
+     */
+    class power2_index_policy {
+        public:
+            using size_type = std::size_t;
+
+            size_type reset( size_type n_ )
+            {
+                size_type count{1};
+                while (count < n_)
+                    count <<= 1;
+                m_mask = count - 1;
+                return count;
+            }
+
+            size_type index( std::size_t hash_ ) const { return static_cast<size_type>(hash_mix(hash_) & m_mask); }
+
+            size_type bucket_count() const { return m_mask + 1; }
+
+        private:
+            size_type m_mask{0}; //!< Bucket count minus one.
+    };
+
+    /*!
+     * @brief Bucket-index policy based on Lemire's fast range reduction.
+     *
+     * Maps a 64-bit value `x` into [0, n) as the high half of the 128-bit product
+     * `x * n`, which works for any bucket count with one multiplication.
+     * Bucket counts are rounded up to powers of two only to keep growth geometric;
+     * the reduction itself does not need them. It relies on the high bits of the
+     * hash, so the hash is mixed first.
+     */
+    class fast_range_index_policy {
+        public:
+            using size_type = std::size_t;
+
+            size_type reset( size_type n_ )
+            {
+                m_count = 1;
+                while (m_count < n_)
+                    m_count <<= 1;
+                return m_count;
+            }
+
+            size_type index( std::size_t hash_ ) const
+            {
+                return static_cast<size_type>(detail::mul_wide(hash_mix(hash_), m_count).m_hi);
+            }
+
+            size_type bucket_count() const { return m_count; }
+
+        private:
+            size_type m_count{1}; //!< Current bucket count.
+    };
+
+} // namespace ac
+#endif
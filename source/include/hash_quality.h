@@ -0,0 +1,182 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef HASH_QUALITY_H
+#define HASH_QUALITY_H
+
+#include <algorithm>   // std::max, std::sort, std::unique
+#include <bitset>      // std::bitset
+#include <climits>     // CHAR_BIT
+#include <cmath>       // std::sqrt, std::fabs
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uintmax_t
+#include <iostream>    // std::ostream
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "hash_policy.h" // prime_index_policy
+
+namespace ac // Associative container
+{
+    /// Result of analyze_hash(): how well a hash spreads a set of keys.
+    struct HashQualityReport {
+        std::size_t keys{0};    //!< Number of keys analyzed.
+        std::size_t buckets{0}; //!< Bucket count they were spread over.
+        /// histogram[k]: number of buckets holding exactly k keys (the last entry counts k or more).
+        std::vector<std::size_t> histogram;
+        std::size_t longest_chain{0};  //!< Largest number of keys in one bucket.
+        std::size_t distinct_hashes{0};//!< Number of different full hash values.
+        double chi_square{0};   //!< Pearson's chi-square of the bucket counts against a uniform spread.
+        double chi_square_z{0}; //!< (chi_square - df) / sqrt(2 df): about -3..3 for a random hash.
+        double avalanche_mean{0}; //!< Mean fraction of hash bits flipped by one input bit flip (ideal 0.5).
+        double avalanche_worst{0};//!< Largest |P(output bit flips) - 0.5| over the output bits (ideal 0).
+
+        friend std::ostream & operator<<( std::ostream & os_, const HashQualityReport & r_ )
+        {
+            os_ << "keys: " << r_.keys << ", buckets: " << r_.buckets
+                << ", distinct hashes: " << r_.distinct_hashes << "\n"
+                << "bucket occupancy (keys: buckets):";
+            for (std::size_t k{0}; k < r_.histogram.size(); ++k)
+                if (r_.histogram[k] != 0)
+                    os_ << " " << k << (k + 1 == r_.histogram.size() ? "+" : "") << ":" << r_.histogram[k];
+            os_ << "\nlongest chain: " << r_.longest_chain << "\n"
+                << "chi-square: " << r_.chi_square << " (z = " << r_.chi_square_z << ")\n"
+                << "avalanche: mean " << r_.avalanche_mean << ", worst bit bias " << r_.avalanche_worst << "\n";
+            return os_;
+        }
+    };
+
+    namespace detail {
+        // Bit access on keys, used to measure avalanche. Keys are integers, strings, or
+        // tuples of those; other key types can add overloads of key_bits() and flip_bit().
+
+        template <class T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+        std::size_t key_bits( const T & ) { return sizeof(T) * CHAR_BIT; }
+
+        template <class T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+        void flip_bit( T & key_, std::size_t bit_ )
+        {
+            using U = std::make_unsigned_t<T>;
+            key_ = static_cast<T>(static_cast<U>(key_) ^ static_cast<U>(std::uintmax_t{1} << bit_));
+        }
+
+        inline std::size_t key_bits( const std::string & key_ ) { return key_.size() * CHAR_BIT; }
+
+        inline void flip_bit( std::string & key_, std::size_t bit_ )
+        {
+            key_[bit_ / CHAR_BIT] = static_cast<char>(key_[bit_ / CHAR_BIT] ^ (1 << (bit_ % CHAR_BIT)));
+        }
+
+        template <class... Ts>
+        std::size_t key_bits( const std::tuple<Ts...> & key_ )
+        {
+            return std::apply([]( const auto &... fields_ ) { return (std::size_t{0} + ... + key_bits(fields_)); }, key_);
+        }
+
+        template <class... Ts>
+        void flip_bit( std::tuple<Ts...> & key_, std::size_t bit_ )
+        {
+            // Walk the fields until the one holding `bit_`.
+            std::apply([&]( auto &... fields_ ) {
+                auto visit = [&]( auto & field_ ) {
+                    auto bits = key_bits(field_);
+                    if (bit_ < bits) {
+                        flip_bit(field_, bit_);
+                        bit_ = static_cast<std::size_t>(-1); // Done: skip the other fields.
+                    }
+                    else if (bit_ != static_cast<std::size_t>(-1)) {
+                        bit_ -= bits;
+                    }
+                };
+                (visit(fields_), ...);
+            }, key_);
+        }
+    } // namespace detail
+
+    /*!
+     * @brief Measures how well `hash_` spreads `keys_` over `buckets_` buckets.
+     *
+     * Buckets are chosen by `IndexPolicy`, as in a HashTbl using that policy, so the
+     * report reflects the table's real collisions (e.g. a hash that is only bad in its
+     * low bits hurts power2_index_policy but not the prime one). The bucket count is
+     * rounded up by the policy.
+     *
+     * The avalanche score flips each input bit of (up to) `avalanche_samples_` keys and
+     * counts how many of the 64 hash bits change. Keys must support detail::key_bits()
+     * and detail::flip_bit() (integers, strings and tuples of them do).
+     *
+     * @param keys_ The keys to hash. Duplicates are analyzed as they are.
+     * @param buckets_ Wanted bucket count.
+     * @param hash_ The hash functor under test.
+     * @param avalanche_samples_ Number of keys used for the avalanche score (0 skips it).
+     * @return The report.
+     */
+    template <class IndexPolicy = prime_index_policy, class Key, class Hash>
+    HashQualityReport analyze_hash( const std::vector<Key> & keys_, std::size_t buckets_, const Hash & hash_,
+                                    std::size_t avalanche_samples_ = 1000 )
+    {
+        HashQualityReport report;
+        IndexPolicy policy;
+        report.keys = keys_.size();
+        report.buckets = policy.reset(std::max<std::size_t>(buckets_, 1));
+
+        // Bucket occupancy and distinct full hashes.
+        std::vector<std::size_t> counts(report.buckets, 0);
+        std::vector<std::size_t> hashes;
+        hashes.reserve(keys_.size());
+        for (const auto & key : keys_) {
+            auto h = static_cast<std::size_t>(hash_(key));
+            hashes.push_back(h);
+            ++counts[policy.index(h)];
+        }
+        std::sort(hashes.begin(), hashes.end());
+        report.distinct_hashes = static_cast<std::size_t>(std::unique(hashes.begin(), hashes.end()) - hashes.begin());
+
+        constexpr std::size_t HISTOGRAM_SIZE = 16;
+        report.histogram.assign(HISTOGRAM_SIZE, 0);
+        const double expected = static_cast<double>(report.keys) / static_cast<double>(report.buckets);
+        for (auto c : counts) {
+            ++report.histogram[std::min(c, HISTOGRAM_SIZE - 1)];
+            report.longest_chain = std::max(report.longest_chain, c);
+            if (expected > 0)
+                report.chi_square += (c - expected) * (c - expected) / expected;
+        }
+        if (report.buckets > 1) {
+            const double df = static_cast<double>(report.buckets - 1);
+            report.chi_square_z = (report.chi_square - df) / std::sqrt(2 * df);
+        }
+
+        // Avalanche: per output bit, how often it flips when one input bit does.
+        constexpr std::size_t OUT_BITS = sizeof(std::size_t) * CHAR_BIT;
+        std::vector<std::size_t> flips(OUT_BITS, 0);
+        std::size_t trials{0};
+        const auto samples = std::min(avalanche_samples_, keys_.size());
+        for (std::size_t s{0}; s < samples; ++s) {
+            // Samples evenly spread over the key set.
+            const auto & key = keys_[s * keys_.size() / samples];
+            const auto base = static_cast<std::size_t>(hash_(key));
+            const auto bits = detail::key_bits(key);
+            for (std::size_t b{0}; b < bits; ++b) {
+                auto flipped = key;
+                detail::flip_bit(flipped, b);
+                std::bitset<OUT_BITS> diff(base ^ static_cast<std::size_t>(hash_(flipped)));
+                for (std::size_t o{0}; o < OUT_BITS; ++o)
+                    flips[o] += diff[o];
+                ++trials;
+            }
+        }
+        if (trials > 0) {
+            double total{0};
+            for (auto f : flips) {
+                double p = static_cast<double>(f) / static_cast<double>(trials);
+                total += p;
+                report.avalanche_worst = std::max(report.avalanche_worst, std::fabs(p - 0.5));
+            }
+            report.avalanche_mean = total / OUT_BITS;
+        }
+        return report;
+    }
+
+} // namespace ac
+#endif
@@ -9,18 +9,82 @@
 #include <cmath>        // sqrt
 #include <iterator>     // std::begin(), std::end()
 #include <initializer_list>
-#include <utility> // std::pair
+#include <utility> // std::pair, std::piecewise_construct
+#include <memory>  // std::allocator, std::allocator_traits
+#include <type_traits> // std::enable_if_t, std::void_t
 #include <sstream>
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+
+#include "hash_policy.h" // prime_index_policy
+#include "hashtbl_stats.h" // HashTblStats, AC_HASHTBL_STATS
+
+// Hint to start loading a cache line early (no-op where the builtin is missing).
+#if defined(__GNUC__) || defined(__clang__)
+#define AC_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define AC_PREFETCH(addr) ((void)(addr))
+#endif
 
 namespace ac // Associative container
 {
+    namespace detail {
+        /// Whether a functor declares `is_transparent`, i.e. accepts keys of other types.
+        template <class F, class = void>
+        struct is_transparent : std::false_type {};
+        template <class F>
+        struct is_transparent<F, std::void_t<typename F::is_transparent>> : std::true_type {};
+
+        /// True when lookups with a `K` may skip building a key: both functors are transparent.
+        /// `K` only makes the value dependent, so it can drive SFINAE in member templates.
+        template <class Hash, class Equal, class K>
+        inline constexpr bool transparent_lookup_v = is_transparent<Hash>::value && is_transparent<Equal>::value;
+
+        /// Full hash value kept next to an entry (see cache_hash).
+        template <bool Cached>
+        struct EntryHash {
+            std::size_t m_hash{0}; //! KeyHash of the key, as computed by the owning table.
+
+            void store_hash( std::size_t hash_ ) { m_hash = hash_; }
+            bool hash_may_match( std::size_t hash_ ) const { return m_hash == hash_; }
+        };
+
+        /// No cached hash: nothing stored, every entry is a candidate.
+        template <>
+        struct EntryHash<false> {
+            void store_hash( std::size_t ) {}
+            bool hash_may_match( std::size_t ) const { return true; }
+        };
+    } // namespace detail
+
+    /*!
+     * @brief Whether the chain nodes of a HashTbl keyed by `KeyType` store the key's full hash.
+     *
+     * With a cached hash, HashTbl rehashes without calling `KeyHash` again, and a chain scan
+     * only calls `KeyEqual` on entries whose hash is the probe's. That pays off for keys that are
+     * expensive to hash or compare (strings, tuples), so it is on for every key except
+     * arithmetic, enum and pointer types, where it would only cost memory. Specialize it to
+     * change the choice for a key type:
+     *
+     *     template <> struct ac::cache_hash<MyKey> : std::false_type {};
+     */
+    template <class KeyType>
+    struct cache_hash : std::bool_constant< !std::is_arithmetic_v<KeyType>
+                                            && !std::is_enum_v<KeyType>
+                                            && !std::is_pointer_v<KeyType> > {};
+
 	template<class KeyType, class DataType>
 	struct HashEntry {
         KeyType m_key;   //! Data key
         DataType m_data; //! The data
 
         // Regular constructor.
-        HashEntry( KeyType kt_, DataType dt_ ) : m_key{kt_} , m_data{dt_}
+        HashEntry( KeyType kt_, DataType dt_ ) : m_key{std::move(kt_)} , m_data{std::move(dt_)}
+        {/*Empty*/}
+
+        // Builds the key from `kt_` and the data in place from `args_`.
+        template <class K, class... Args>
+        HashEntry( std::piecewise_construct_t, K && kt_, Args &&... args_ )
+            : m_key(std::forward<K>(kt_)) , m_data(std::forward<Args>(args_)...)
         {/*Empty*/}
 
         friend std::ostream & operator<<( std::ostream & os_, const HashEntry & he_ ) {
@@ -29,39 +93,127 @@ namespace ac // Associative container
         }
     };
 
+    namespace detail {
+        /*!
+         * @brief A HashEntry as HashTbl and CowHashTbl store it in a chain: with the key's hash
+         * when cache_hash says so.
+         *
+         * Kept out of HashEntry itself, which is also the slot of the open-addressing tables
+         * (FlatHashTbl, SwissHashTbl): they never read a cached hash, and their slot size is
+         * what they are for.
+         */
+        template <class KeyType, class DataType>
+        struct ChainEntry : HashEntry<KeyType, DataType>, EntryHash< cache_hash<KeyType>::value > {
+            using HashEntry<KeyType, DataType>::HashEntry;
+        };
+    } // namespace detail
+
+    /// Tag selecting the HashTbl constructor that copies a whole range (like C++23 `std::from_range`).
+    struct from_range_t { explicit from_range_t() = default; };
+    inline constexpr from_range_t from_range{};
+
+    namespace detail {
+        /// Enables a template only for iterator types (keeps `HashTbl(3, 4)` off the iterator-pair constructor).
+        template <class It>
+        using if_iterator = std::void_t< typename std::iterator_traits<It>::iterator_category >;
+
+        /// Key and data of the elements a HashTbl can be built from: entries and pairs.
+        template <class K, class D> const K& element_key( const HashEntry<K, D> &e_ ) { return e_.m_key; }
+        template <class K, class D> const D& element_data( const HashEntry<K, D> &e_ ) { return e_.m_data; }
+        template <class K, class D> const K& element_key( const std::pair<K, D> &p_ ) { return p_.first; }
+        template <class K, class D> const D& element_data( const std::pair<K, D> &p_ ) { return p_.second; }
+
+        struct parallel_access; // Defined by parallel_hashtbl.h, which builds and rehashes on a thread pool.
+    } // namespace detail
+
 	template< class KeyType,
 		      class DataType,
 		      class KeyHash = std::hash< KeyType >,
-		      class KeyEqual = std::equal_to< KeyType > >
+		      class KeyEqual = std::equal_to< KeyType >,
+		      class IndexPolicy = prime_index_policy,
+		      class Allocator = std::allocator< HashEntry< KeyType, DataType > > >
 	class HashTbl {
         public:
             // Aliases
+            using key_type = KeyType;
+            using mapped_type = DataType;
             using entry_type = HashEntry<KeyType,DataType>;
-            using list_type  = std::forward_list< entry_type >;
+            using node_type  = detail::ChainEntry<KeyType,DataType>; // entry_type plus its cached hash
+            using allocator_type = Allocator;
+            using list_type  = std::forward_list< node_type, typename std::allocator_traits<Allocator>::template rebind_alloc<node_type> >;
             using size_type  = std::size_t;
+            // Enables the lookup overloads taking any key type (heterogeneous lookup).
+            template <class K>
+            using if_transparent = std::enable_if_t< detail::transparent_lookup_v<KeyHash, KeyEqual, K> >;
 
-            explicit HashTbl( size_type table_sz_ = DEFAULT_SIZE );
+            explicit HashTbl( size_type table_sz_ = DEFAULT_SIZE, const Allocator & = Allocator() );
             HashTbl( const HashTbl& );
-            HashTbl( const std::initializer_list< entry_type > & );
+            HashTbl( const std::initializer_list< entry_type > &, const Allocator & = Allocator() );
+            template <class InputIt, class = detail::if_iterator<InputIt>>
+            HashTbl( InputIt, InputIt, size_type table_sz_ = 0, const Allocator & = Allocator() );
+            template <class Range>
+            HashTbl( from_range_t, Range &&, size_type table_sz_ = 0, const Allocator & = Allocator() );
+            HashTbl( HashTbl&& ) noexcept;
             HashTbl& operator=( const HashTbl& );
+            HashTbl& operator=( HashTbl&& ) noexcept( std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+                                                      || std::allocator_traits<Allocator>::is_always_equal::value );
             HashTbl& operator=( const std::initializer_list< entry_type > & );
+            void swap( HashTbl& ) noexcept;
 
             virtual ~HashTbl();
 
             bool insert( const KeyType &, const DataType &  );
+            bool insert( entry_type && );
+            template <class... Args> bool emplace( Args &&... );
+            template <class... Args> bool try_emplace( const KeyType &, Args &&... );
+            template <class... Args> bool try_emplace( KeyType &&, Args &&... );
+            template <class M> bool insert_or_assign( const KeyType &, M && );
+            template <class M> bool insert_or_assign( KeyType &&, M && );
             bool retrieve( const KeyType &, DataType & ) const;
+            template <class K, class = if_transparent<K>> bool retrieve( const K &, DataType & ) const;
+            bool contains( const KeyType & ) const;
+            template <class K, class = if_transparent<K>> bool contains( const K & ) const;
             bool erase( const KeyType & );
+            size_type retrieve_batch( const KeyType *, size_type, DataType *, bool * ) const;
+            size_type insert_batch( const KeyType *, const DataType *, size_type );
+            size_type erase_batch( const KeyType *, size_type );
+            template <class K, class = if_transparent<K>> bool erase( const K & );
             void clear();
+            template <class Predicate> size_type erase_if( Predicate );
             bool empty() const;
             inline size_type size() const { return m_count; };
             DataType& at( const KeyType& );
+            template <class K, class = if_transparent<K>> DataType& at( const K & );
+            DataType* find( const KeyType & );
+            const DataType* find( const KeyType & ) const;
+            template <class K, class = if_transparent<K>> DataType* find( const K & );
+            template <class K, class = if_transparent<K>> const DataType* find( const K & ) const;
             DataType& operator[]( const KeyType& );
             size_type count( const KeyType& ) const;
+            template <class K, class = if_transparent<K>> size_type count( const K & ) const;
             float max_load_factor() const;
             void max_load_factor(float mlf);
+            float min_load_factor() const;
+            void min_load_factor( float );
+            void shrink_to_fit();
+            size_type rehash_step() const;
+            void rehash_step(size_type buckets);
+            void rehash( size_type );
+            void reserve( size_type );
+            inline size_type bucket_count() const { return m_size; };
+            size_type bucket_size( size_type ) const;
+            float load_factor() const;
+            HashTblStats stats() const;
+            template <class Function> void for_each( Function && ) const;
+            void reset_stats();
+            inline bool rehashing() const { return m_old_table != nullptr; };
+            inline allocator_type get_allocator() const { return m_alloc; };
 
 
 
+            friend void swap( HashTbl &a_, HashTbl &b_ ) noexcept { a_.swap(b_); }
+            friend struct detail::parallel_access;
+
             friend std::ostream & operator<<(std::ostream & os_, const HashTbl & ht_)
             {
                 for (size_t i{0}; i < ht_.m_size; ++i) {
@@ -72,6 +224,13 @@ namespace ac // Associative container
                     }
                 }
 
+                // Buckets of the previous array that an incremental rehash has not moved yet.
+                for (size_t i{ht_.m_migrated}; ht_.m_old_table != nullptr && i < ht_.m_old_size; ++i) {
+                    os_ << "[old " << i << "]->\n";
+                    for (const auto& entry : ht_.m_old_table[i])
+                        os_ << entry.m_data << "\n";
+                }
+
                 // Adicionar uma linha em branco após imprimir todos os elementos
                 os_ << std::endl;
 
@@ -81,21 +240,49 @@ namespace ac // Associative container
 
 
         private:
+            using bucket_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<list_type>;
+            using bucket_traits = std::allocator_traits<bucket_allocator>;
+
+            list_type* allocate_buckets( size_type );
+            void free_buckets( list_type*, size_type );
             void rehash( void );
+            void begin_rehash( size_type );
+            size_type buckets_for( size_type ) const;
+            void migrate( size_type );
+            void grow_if_needed( void );
+            void shrink_if_needed( void );
+            template <class K, class... Args>
+            std::pair<node_type*, bool> emplace_key( std::size_t, K &&, Args &&... );
+            template <class K> list_type& bucket_of( const K& ) const;
+            list_type& bucket_at( std::size_t ) const;
+            std::size_t hash_of( const node_type& ) const;
+            template <class K> static bool key_matches( const node_type&, std::size_t, const K& );
+            template <class K> node_type* find_entry( const K& ) const;
+            template <class K> node_type* find_entry( const K&, std::size_t ) const;
+            template <class K> bool erase_key( std::size_t, const K& );
 
+            void swap_contents( HashTbl& ) noexcept;
             void initialize_hash(const HashTbl&);
             void initialize_hash_ilist( const std::initializer_list< entry_type > & );
 
-            bool isPrime(size_type)const;
-            int nextPrime(size_type)const;
-
         private:
             size_type m_size{0}; //!< Tamanho da tabela.
             size_type m_count{0};//!< Numero de elementos na tabel.
             float m_factor_load{0}; //!< fator
-            // std::unique_ptr< std::forward_list< entry_type > [] > m_table;
-            std::forward_list< entry_type > *m_table; //!< Tabela de listas para entradas de tabela.
+            float m_min_load{0};    //!< Load factor under which erasing shrinks the table (0: never).
+            IndexPolicy m_policy;   //!< Maps hash values to buckets and picks table sizes.
+            Allocator m_alloc;   //!< Allocates the bucket arrays and, through each bucket, the entries.
+            list_type *m_table{nullptr}; //!< Tabela de listas para entradas de tabela.
+            // Incremental rehash state: while m_old_table is not null, its buckets
+            // [m_migrated, m_old_size) have not been moved to m_table yet.
+            list_type *m_old_table{nullptr}; //!< Previous bucket array, during an incremental rehash.
+            size_type m_old_size{0};         //!< Number of buckets of m_old_table.
+            IndexPolicy m_old_policy;        //!< Index policy matching m_old_table.
+            size_type m_migrated{0};         //!< Old buckets already moved to m_table.
+            size_type m_rehash_step{0};      //!< Old buckets moved per mutating call (0 = all at once).
+            detail::TableCounters<AC_HASHTBL_STATS != 0> m_counters; //!< Lookup and rehash counters (empty unless enabled).
             static const short DEFAULT_SIZE = 11;
+            static constexpr size_type BATCH_WINDOW = 16; //!< Keys whose memory accesses overlap in the batch calls.
     };
 
 } // MyHashTable
@@ -12,22 +12,23 @@ namespace ac {
     /*!
      * @brief Constructor that initializes the table with a specified size.
      *
-     * @param sz Size of the table.
+     * @param sz Size of the table, rounded up by the index policy.
+     * @param alloc Allocator for the bucket array and the entry nodes.
      */
-	template< typename KeyType, typename DataType, typename KeyHash, typename KeyEqual >
-	HashTbl<KeyType,DataType,KeyHash,KeyEqual>::HashTbl( size_type sz )
+	template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+	HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::HashTbl( size_type sz, const Allocator &alloc )
+        : m_alloc{alloc}
     {
-        m_size = 0; m_size = sz;
-        // Checks if the size chosen by the user is prime, if not, finds the next prime.
-        if (!(isPrime(m_size)))
-            m_size = nextPrime(sz);
+        // The index policy rounds the size chosen by the user up to a size it supports
+        // (the next prime from its table, by default).
+        m_size = m_policy.reset(sz);
 
         // Number of data is zero.
         //m_count = 0;
         
 
         // Initializes the hash with the appropriate and prime size.
-        m_table = new std::forward_list<entry_type>[m_size];
+        m_table = allocate_buckets(m_size);
     }
 
     /*!
@@ -35,8 +36,9 @@ namespace ac {
      *
      * @param source The table from which to copy the elements.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    HashTbl<KeyType, DataType, KeyHash, KeyEqual>::HashTbl(const HashTbl &source)
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::HashTbl(const HashTbl &source)
+        : m_alloc{std::allocator_traits<Allocator>::select_on_container_copy_construction(source.m_alloc)}
     {
         // Function to initialize the constructor, the same one used with the operator =
         initialize_hash(source);
@@ -44,59 +46,207 @@ namespace ac {
         m_size = source.m_size;
     }
 
+    /*!
+     * @brief Move constructor: takes over the other table's bucket arrays, in constant time.
+     *
+     * No entry is copied or moved. The other table is left as a usable empty table of
+     * DEFAULT_SIZE buckets. Allocating them is the only work besides the pointer copies; as
+     * the constructor is noexcept, running out of memory there terminates the program.
+     *
+     * @param source The table whose elements are taken.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::HashTbl(HashTbl &&source) noexcept
+        : m_size{source.m_size}, m_count{source.m_count}, m_factor_load{source.m_factor_load},
+          m_min_load{source.m_min_load}, m_policy{source.m_policy}, m_alloc{std::move(source.m_alloc)},
+          m_table{source.m_table}, m_old_table{source.m_old_table}, m_old_size{source.m_old_size},
+          m_old_policy{source.m_old_policy}, m_migrated{source.m_migrated}, m_rehash_step{source.m_rehash_step}
+    {
+        source.m_old_table = nullptr;
+        source.m_old_size = source.m_count = source.m_migrated = 0;
+        source.m_size = source.m_policy.reset(DEFAULT_SIZE);
+        source.m_table = source.allocate_buckets(source.m_size);
+    }
+
     /*!
      * @brief Constructor that initializes the table based on an initializer list.
      *
      * @param ilist Initialization list containing key-value pairs.
+     * @param alloc Allocator for the bucket array and the entry nodes.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    HashTbl<KeyType, DataType, KeyHash, KeyEqual>::HashTbl(const std::initializer_list<entry_type> &ilist)
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::HashTbl(const std::initializer_list<entry_type> &ilist, const Allocator &alloc)
+        : m_alloc{alloc}
     {
         // Function to initialize the constructor, the same one used with the operator =
         initialize_hash_ilist(ilist);
-        m_count =  ilist.size();
     }
 
+    /*!
+     * @brief Constructor that builds the table from the elements of `[first, last)`.
+     *
+     * Elements are HashEntry objects or `std::pair`s of key and data; a repeated key keeps
+     * the last data, as with insert(). For forward iterators the table is sized once, for the
+     * whole range, so building it never rehashes.
+     *
+     * @param first Iterator to the first element.
+     * @param last Iterator past the last element.
+     * @param sz Minimum number of buckets.
+     * @param alloc Allocator for the bucket array and the entry nodes.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class InputIt, class>
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::HashTbl(InputIt first, InputIt last, size_type sz, const Allocator &alloc)
+        : m_alloc{alloc}
+    {
+        // A single-pass range cannot be counted in advance; it grows as usual.
+        size_type n{0};
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIt>::iterator_category>)
+            n = static_cast<size_type>(std::distance(first, last));
+
+        m_size = m_policy.reset(std::max(sz, buckets_for(n)));
+        m_table = allocate_buckets(m_size);
+        for (; first != last; ++first) {
+            const auto &element = *first;
+            insert(detail::element_key(element), detail::element_data(element));
+        }
+    }
+
+    /*!
+     * @brief Constructor that builds the table from a whole range, e.g. `HashTbl(ac::from_range, entries)`.
+     *
+     * @param range Container (or any type with begin() and end()) of entries or pairs.
+     * @param sz Minimum number of buckets.
+     * @param alloc Allocator for the bucket array and the entry nodes.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class Range>
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::HashTbl(from_range_t, Range &&range, size_type sz, const Allocator &alloc)
+        : HashTbl(std::begin(range), std::end(range), sz, alloc)
+    {/*Empty*/}
+
     /*!
      * @brief Assignment operator that replaces the table's elements with those of another table.
      *
      * @param clone The table to be copied.
      * @return Reference to the table after the copy.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    HashTbl<KeyType, DataType, KeyHash, KeyEqual> &
-    HashTbl<KeyType, DataType, KeyHash, KeyEqual>::operator=(const HashTbl &clone)
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator> &
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::operator=(const HashTbl &clone)
     {
+        if (this == &clone)
+            return *this;
+
+        // The current arrays go back to the allocator that made them, before it may be replaced
+        free_buckets(m_table, m_size);
+        free_buckets(m_old_table, m_old_size);
+        m_table = m_old_table = nullptr;
+        if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value)
+            m_alloc = clone.m_alloc;
+
         // Function to initialize the hash with the assignment operator =, the same one used with the constructor
         initialize_hash(clone);
         m_count = clone.m_count;
         return *this;
     }
 
+    /*!
+     * @brief Move assignment: takes over the other table's bucket arrays, in constant time.
+     *
+     * The two tables swap their contents, so the other one is left with this table's previous
+     * elements (and destroys them when it goes away). When the allocator does not propagate
+     * and the two allocators differ, the nodes cannot change hands and the elements are copied.
+     *
+     * @param source The table whose elements are taken.
+     * @return Reference to this table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator> &
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::operator=(HashTbl &&source)
+        noexcept( std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+                  || std::allocator_traits<Allocator>::is_always_equal::value )
+    {
+        using traits = std::allocator_traits<Allocator>;
+        if constexpr (!traits::propagate_on_container_move_assignment::value && !traits::is_always_equal::value) {
+            if (m_alloc != source.m_alloc)
+                return *this = static_cast<const HashTbl&>(source);
+        }
+        if (this != &source) {
+            if constexpr (traits::propagate_on_container_move_assignment::value) {
+                using std::swap;
+                swap(m_alloc, source.m_alloc);
+            }
+            swap_contents(source);
+        }
+        return *this;
+    }
+
+    /*!
+     * @brief Exchanges the contents of two tables, in constant time.
+     *
+     * The allocators are exchanged too if they propagate on swap; otherwise they must compare
+     * equal, as for the standard containers.
+     *
+     * @param other The table to swap with.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::swap(HashTbl &other) noexcept
+    {
+        if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(m_alloc, other.m_alloc);
+        }
+        swap_contents(other);
+    }
+
+    /*!
+     * @brief Exchanges everything but the allocators and the statistics counters.
+     *
+     * @param other The table to swap with.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::swap_contents(HashTbl &other) noexcept
+    {
+        using std::swap;
+        swap(m_size, other.m_size);
+        swap(m_count, other.m_count);
+        swap(m_factor_load, other.m_factor_load);
+        swap(m_min_load, other.m_min_load);
+        swap(m_policy, other.m_policy);
+        swap(m_table, other.m_table);
+        swap(m_old_table, other.m_old_table);
+        swap(m_old_size, other.m_old_size);
+        swap(m_old_policy, other.m_old_policy);
+        swap(m_migrated, other.m_migrated);
+        swap(m_rehash_step, other.m_rehash_step);
+    }
+
     /*!
      * @brief Assignment operator that replaces the table's elements with those of an initializer list.
      *
      * @param ilist Initialization list containing key-value pairs.
      * @return Reference to the table after the copy.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    HashTbl<KeyType, DataType, KeyHash, KeyEqual> &
-    HashTbl<KeyType, DataType, KeyHash, KeyEqual>::operator=(const std::initializer_list<entry_type> &ilist)
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator> &
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::operator=(const std::initializer_list<entry_type> &ilist)
     {
         // Function to initialize the hash with the assignment operator =, the same one used with the constructor
         initialize_hash_ilist(ilist);
-        m_count =  ilist.size();
         return *this;
     }
 
     /*!
      * @brief Destructor that frees the memory allocated by the table.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    HashTbl<KeyType, DataType, KeyHash, KeyEqual>::~HashTbl()
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::~HashTbl()
     {
         // Delete the hash.
-        delete[] m_table;
+        free_buckets(m_table, m_size);
+        free_buckets(m_old_table, m_old_size);
     }
 
     /*!
@@ -110,38 +260,126 @@ namespace ac {
      * using the hash function and then checks if the key already exists in the corresponding linked list.
      * If the key does not exist, a new key-value pair is inserted at the beginning of the list.
      * If the load on the table exceeds the specified load factor, the function calls rehash to
-     * reorganize the table and reduce the load.
+     * reorganize the table and reduce the load. While an incremental rehash is in progress the
+     * table does not grow again; the call moves at most `rehash_step()` old buckets instead.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::insert(const KeyType &key_, const DataType &new_data_)
+    {
+        return insert_or_assign(key_, new_data_);
+    }
+
+    /*!
+     * @brief Inserts a key-value pair, moving it into the table.
+     *
+     * Same behavior as insert(key, data): if the key already exists its data is replaced.
+     *
+     * @param entry_ The entry to be moved into the table.
+     * @return true if the insertion was successful, false if the key already exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::insert(entry_type &&entry_)
+    {
+        return insert_or_assign(std::move(entry_.m_key), std::move(entry_.m_data));
+    }
+
+    /*!
+     * @brief Builds an entry from `args_` directly inside a new list node and inserts it.
+     *
+     * The node is constructed before the key is known, so if the key already exists the node is
+     * discarded and the table is left unchanged (the existing data is NOT replaced).
+     *
+     * @param args_ Arguments forwarded to the HashEntry constructor, e.g. a key and a data.
+     * @return true if the entry was inserted, false if the key already exists.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual>::insert(const KeyType &key_, const DataType &new_data_)
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class... Args>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::emplace(Args &&... args_)
     {
-        // Calculate the hash index
-        auto hash_index = KeyHash()(key_) % m_size;
+        // Build the node in a temporary list, then link it into its bucket (no copy, no second allocation)
+        list_type node(m_alloc);
+        node.emplace_front(std::forward<Args>(args_)...);
+        const auto &key = node.front().m_key;
+        auto hash = KeyHash()(key);
+        node.front().store_hash(hash);
 
-        // Iterate over the linked list at the hash position
-        auto &hash_list = m_table[hash_index];
+        if (m_old_table != nullptr)
+            migrate(m_rehash_step);
 
-        // Check if the key already exists in the list
+        auto &hash_list = bucket_at(hash);
         auto it = std::find_if(hash_list.begin(), hash_list.end(),
-                            [&](const entry_type &entry) { return KeyEqual()(entry.m_key, key_); });
+                            [&](const node_type &entry) { return key_matches(entry, hash, key); });
+        if (it != hash_list.end())
+            return false;
 
-        if (it == hash_list.end()) {
-            // The key does not exist, add a new element to the list
-            //hash_list.emplace_front(key_, new_data_);
-            hash_list.push_front(HashEntry(key_, new_data_));
-           // std::cout << new_data_ << "\n";
-            m_count++;
+        hash_list.splice_after(hash_list.before_begin(), node);
+        m_count++;
+        grow_if_needed();
+        return true;
+    }
 
-            if (m_count / m_size > m_factor_load) {
-                rehash();
-            }
-            return true; // Successful insertion
-        } 
-        else {
-            // The key already exists, update the data
-            it->m_data = new_data_;
-            return false; // Unsuccessful insertion
-        }
+    /*!
+     * @brief Inserts a key whose data is constructed in place from `args_`, if the key is absent.
+     *
+     * If the key already exists nothing happens: `args_` are not even moved from.
+     *
+     * @param key_ The key to be inserted.
+     * @param args_ Arguments forwarded to the DataType constructor.
+     * @return true if the entry was inserted, false if the key already exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class... Args>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::try_emplace(const KeyType &key_, Args &&... args_)
+    {
+        return emplace_key(KeyHash()(key_), key_, std::forward<Args>(args_)...).second;
+    }
+
+    /*!
+     * @brief Inserts a key (moved into the table) whose data is constructed in place, if the key is absent.
+     *
+     * @param key_ The key to be moved into the table.
+     * @param args_ Arguments forwarded to the DataType constructor.
+     * @return true if the entry was inserted, false if the key already exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class... Args>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::try_emplace(KeyType &&key_, Args &&... args_)
+    {
+        return emplace_key(KeyHash()(key_), std::move(key_), std::forward<Args>(args_)...).second;
+    }
+
+    /*!
+     * @brief Inserts a key-value pair, or assigns the data if the key already exists.
+     *
+     * @param key_ The key to be inserted.
+     * @param data_ The data, forwarded (moved if it is an rvalue) into the table.
+     * @return true if the entry was inserted, false if the existing data was assigned.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class M>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::insert_or_assign(const KeyType &key_, M &&data_)
+    {
+        auto [entry, inserted] = emplace_key(KeyHash()(key_), key_, std::forward<M>(data_));
+        if (!inserted)
+            entry->m_data = std::forward<M>(data_); // Not consumed by emplace_key.
+        return inserted;
+    }
+
+    /*!
+     * @brief Inserts a key (moved into the table) and its data, or assigns the data if the key exists.
+     *
+     * @param key_ The key to be moved into the table.
+     * @param data_ The data, forwarded (moved if it is an rvalue) into the table.
+     * @return true if the entry was inserted, false if the existing data was assigned.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class M>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::insert_or_assign(KeyType &&key_, M &&data_)
+    {
+        auto [entry, inserted] = emplace_key(KeyHash()(key_), std::move(key_), std::forward<M>(data_));
+        if (!inserted)
+            entry->m_data = std::forward<M>(data_); // Not consumed by emplace_key.
+        return inserted;
     }
 
 
@@ -150,15 +388,20 @@ namespace ac {
  *
  * This function deletes the nodes from the linked lists at each index.
  */
-template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
+template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::clear()
 {
     // Delete nodes from the linked lists at each index
     for (size_t i{0}; i < m_size; ++i) {
         m_table[i].clear();
     }
 
+    // Drop any incremental rehash in progress, with the entries it still held
+    free_buckets(m_old_table, m_old_size);
+    m_old_table = nullptr;
+
     m_count = 0;
+    shrink_if_needed();
 }
 
     /*!
@@ -166,8 +409,8 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
      *
      * @return true if the table is empty, false otherwise.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual>::empty() const
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::empty() const
     {
         return m_count == 0;
     }
@@ -182,63 +425,466 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
      * This function iterates over the linked list at the hash position and checks if the key already
      * exists in the list. If the key exists, the associated data is stored in the provided variable.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual>::retrieve(const KeyType &key_, DataType &data_item_) const
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::retrieve(const KeyType &key_, DataType &data_item_) const
     {
-        // Iterate over the linked list at the hash position
-        size_t hash_value = KeyHash()(key_) % m_size;
-        auto &hash_list = m_table[hash_value];
-
-        // Check if the key already exists in the list
-        auto it = std::find_if(hash_list.begin(), hash_list.end(),
-                            [&](const entry_type &entry) { return KeyEqual()(entry.m_key, key_); });
-
-        if (it != hash_list.end()) {
+        auto *entry = find_entry(key_);
+        if (entry != nullptr) {
             // The key exists, store the associated data in the variable
-            data_item_ = it->m_data;
+            data_item_ = entry->m_data;
             return true; // Successful retrieval
         }
 
         return false; // Key not found
     }
 
+    /*!
+     * @brief Retrieves the data associated with a key given as any type the hash and equality accept.
+     *
+     * Only available when both `KeyHash` and `KeyEqual` declare `is_transparent`; no `KeyType` is built.
+     *
+     * @param key_ The key to search for.
+     * @param data_item_ The variable to store the retrieved data.
+     * @return true if the retrieval was successful, false if the key does not exist.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K, class>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::retrieve(const K &key_, DataType &data_item_) const
+    {
+        auto *entry = find_entry(key_);
+        if (entry != nullptr) {
+            data_item_ = entry->m_data;
+            return true;
+        }
+        return false;
+    }
+
+    /*!
+     * @brief Checks whether a key is stored in the table.
+     *
+     * @param key_ The key to search for.
+     * @return true if the key exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::contains(const KeyType &key_) const
+    {
+        return find_entry(key_) != nullptr;
+    }
+
+    /*!
+     * @brief Checks whether a key, given as any type the hash and equality accept, is stored.
+     *
+     * Only available when both `KeyHash` and `KeyEqual` declare `is_transparent`.
+     *
+     * @param key_ The key to search for.
+     * @return true if the key exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K, class>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::contains(const K &key_) const
+    {
+        return find_entry(key_) != nullptr;
+    }
+
     /*!
      * @brief Performs the rehashing process, increasing the size of the hash table and rearranging the elements.
      *
      * Rehashing is necessary when the load factor of the hash table reaches a limit, ensuring proper performance.
      * In this process, the size of the hash table is increased, and all elements are redistributed to the new positions.
+     *
+     * When `rehash_step()` is not zero the redistribution is incremental: the old bucket array is
+     * kept and each later mutating call moves `rehash_step()` of its buckets, so no single insertion
+     * pays for moving the whole table.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::rehash(void)
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::rehash(void)
     {
-        // Store the current size of the table
-        auto aux = m_size;
+        // Let the index policy pick the new size, at least twice the current one
+        begin_rehash(m_size * 2);
+
+        // Stop-the-world mode: move everything now
+        if (m_rehash_step == 0)
+            migrate(m_old_size);
+    }
 
-        // Check if twice the current size is a prime number
-        if (!(isPrime(m_size * 2)))
-            m_size = nextPrime(m_size * 2);
+    /*!
+     * @brief Rebuilds the table with at least `n` buckets, at once.
+     *
+     * The table never gets fewer buckets than its current elements need under the maximum
+     * load factor, so `rehash(0)` shrinks it to fit. A pending incremental rehash is finished.
+     *
+     * @param n Minimum number of buckets.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::rehash(size_type n)
+    {
+        begin_rehash(std::max(n, buckets_for(m_count)));
+        migrate(m_old_size);
+    }
+
+    /*!
+     * @brief Makes room for `n` elements: inserting up to `n` elements in total will not rehash.
+     *
+     * Only grows the table; the maximum load factor must be set first, since the number of
+     * buckets depends on it.
+     *
+     * @param n Number of elements the table must hold.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::reserve(size_type n)
+    {
+        if (buckets_for(n) > m_size)
+            rehash(buckets_for(n));
+    }
+
+    /*!
+     * @brief Returns the number of elements in bucket `n`.
+     *
+     * During an incremental rehash, elements still in the old bucket array are not counted.
+     *
+     * @param n Bucket index, less than bucket_count().
+     * @return The length of the bucket's chain.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::size_type
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::bucket_size(size_type n) const
+    {
+        return static_cast<size_type>(std::distance(m_table[n].begin(), m_table[n].end()));
+    }
+
+    /*!
+     * @brief Returns the average number of elements per bucket.
+     *
+     * @return size() / bucket_count().
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    float HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::load_factor() const
+    {
+        return static_cast<float>(m_count) / static_cast<float>(m_size);
+    }
+
+    /*!
+     * @brief Takes a snapshot of the table's chains, memory use and (if enabled) counters.
+     *
+     * Walks every bucket, so it costs O(bucket_count()); call it from monitoring code, not
+     * per operation. During an incremental rehash the old buckets not moved yet count as
+     * chains too, since lookups may walk them.
+     *
+     * @return The statistics (see HashTblStats).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    HashTblStats HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::stats() const
+    {
+        HashTblStats s;
+        size_type chains{0};
+        auto add_chain = [&](const list_type &list) {
+            auto length = static_cast<size_type>(std::distance(list.begin(), list.end()));
+            if (length >= s.chain_histogram.size())
+                s.chain_histogram.resize(length + 1);
+            ++s.chain_histogram[length];
+            s.max_chain = std::max(s.max_chain, length);
+            if (length > 0)
+                ++chains;
+        };
+        for (size_type i{0}; i < m_size; ++i)
+            add_chain(m_table[i]);
+        for (size_type i{m_migrated}; m_old_table != nullptr && i < m_old_size; ++i)
+            add_chain(m_old_table[i]);
+        s.mean_chain = chains == 0 ? 0 : static_cast<double>(m_count) / chains;
+
+        // Same layout as a forward_list node: the link, then the entry.
+        struct node_model { void *m_next; node_type m_entry; };
+        s.bytes_allocated = (m_size + (m_old_table != nullptr ? m_old_size : 0)) * sizeof(list_type)
+                            + m_count * sizeof(node_model);
+
+        m_counters.fill(s);
+        return s;
+    }
+
+    /*!
+     * @brief Calls `fn_(key, data)` for every element, in no particular order.
+     *
+     * `fn_` must not modify the table.
+     *
+     * @param fn_ Callable taking a `const KeyType&` and a `const DataType&`.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class Function>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::for_each(Function &&fn_) const
+    {
+        for (size_type i{0}; i < m_size; ++i)
+            for (const auto &entry : m_table[i])
+                fn_(entry.m_key, entry.m_data);
+        // Elements an incremental rehash has not moved yet
+        for (size_type i{m_migrated}; m_old_table != nullptr && i < m_old_size; ++i)
+            for (const auto &entry : m_old_table[i])
+                fn_(entry.m_key, entry.m_data);
+    }
+
+    /*!
+     * @brief Sets the lookup and rehash counters back to zero (no effect unless AC_HASHTBL_STATS is on).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::reset_stats()
+    {
+        m_counters.reset();
+    }
+
+    /*!
+     * @brief Makes the current bucket array the old one and allocates a new one of (at least) `n` buckets.
+     *
+     * The caller then moves the old buckets with migrate(), all at once or incrementally.
+     *
+     * @param n Requested number of buckets, rounded up by the index policy.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::begin_rehash(size_type n)
+    {
+        // Finish a previous incremental rehash, if any
+        if (m_old_table != nullptr)
+            migrate(m_old_size);
+
+        detail::RehashTimer<AC_HASHTBL_STATS != 0> timer(m_counters);
+        m_counters.rehash();
+
+        // The current array becomes the old one
+        m_old_table = m_table;
+        m_old_size = m_size;
+        m_old_policy = m_policy;
+        m_migrated = 0;
 
         // Create a new hash table with the new size
-        std::forward_list<entry_type> *m_table2 = new std::forward_list<entry_type>[m_size];
+        m_size = m_policy.reset(n);
+        m_table = allocate_buckets(m_size);
+    }
+
+    /*!
+     * @brief Returns the fewest buckets that hold `n` elements without growing.
+     *
+     * Growth is checked after each insertion as `size() / bucket_count() > max_load_factor()`,
+     * with an integer quotient, so the table grows once it holds `floor(mlf) + 1` elements per
+     * bucket.
+     *
+     * @param n Number of elements.
+     * @return The minimum bucket count.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::size_type
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::buckets_for(size_type n) const
+    {
+        return n / (static_cast<size_type>(m_factor_load) + 1) + 1;
+    }
 
-        // Move elements from the old table to the new table
-        for (size_t i = 0; i < aux; i++)
+    /*!
+     * @brief Moves up to `buckets_` buckets of the old array (incremental rehash) to the current one.
+     *
+     * Buckets are moved in index order. Once the last one is moved the old array is freed.
+     *
+     * @param buckets_ Maximum number of old buckets to move.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::migrate(size_type buckets_)
+    {
+        detail::RehashTimer<AC_HASHTBL_STATS != 0> timer(m_counters);
+        for (; buckets_ > 0 && m_migrated < m_old_size; --buckets_, ++m_migrated)
         {
-            for (const auto &entry : m_table[i])
+            auto &old_list = m_old_table[m_migrated];
+            while (!old_list.empty())
             {
                 // Calculate the new hash value for the key
-                size_t hash_value = KeyHash()(entry.m_key) % m_size;
+                size_t hash_value = m_policy.index(hash_of(old_list.front()));
 
-                // Add the element to the new position in the new table
-                m_table2[hash_value].emplace_front(entry.m_key, entry.m_data);
+                // Relink the first node at the front of its new list: no allocation, no copy
+                auto &new_list = m_table[hash_value];
+                new_list.splice_after(new_list.before_begin(), old_list, old_list.before_begin());
             }
         }
 
-        // Clear the old table
-        delete [] m_table;
+        if (m_migrated == m_old_size) {
+            // Clear the old table
+            free_buckets(m_old_table, m_old_size);
+            m_old_table = nullptr;
+        }
+    }
+
+    /*!
+     * @brief Shrinks the table after erasures took it under the minimum load factor.
+     *
+     * The new bucket array is twice what the remaining elements need, so the table must about
+     * double before it grows again, and halve before it shrinks again: a workload that erases
+     * and inserts around the threshold does not rehash back and forth. Does nothing while a
+     * rehash is in progress, or if the policy would not at least halve the bucket count.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::shrink_if_needed(void)
+    {
+        if (m_min_load <= 0 || m_old_table != nullptr || m_count >= m_min_load * m_size)
+            return;
+        size_type target = std::max<size_type>(DEFAULT_SIZE, 2 * buckets_for(m_count));
+        if (target > m_size / 2)
+            return;
+        begin_rehash(target);
+        // Same as growing: all at once, or spread over the next mutating calls
+        if (m_rehash_step == 0)
+            migrate(m_old_size);
+    }
+
+    /*!
+     * @brief Starts a rehash if the table went over its maximum load factor.
+     *
+     * Does nothing while an incremental rehash is still in progress.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::grow_if_needed(void)
+    {
+        if (m_old_table == nullptr && m_count / m_size > m_factor_load) {
+            rehash();
+        }
+    }
+
+    /*!
+     * @brief Finds a key, inserting it with data built from `args_` if it is absent.
+     *
+     * Shared by try_emplace(), insert_or_assign() and operator[]. `args_` are only used (and
+     * possibly moved from) when a new entry is created.
+     *
+     * @param hash The `KeyHash` of the key, computed by the caller.
+     * @param key_ The key, copied or moved into the new entry.
+     * @param args_ Arguments forwarded to the DataType constructor.
+     * @return The entry for the key and whether it was inserted by this call.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K, class... Args>
+    std::pair<typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::node_type*, bool>
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::emplace_key(std::size_t hash, K &&key_, Args &&... args_)
+    {
+        // Pay for a bounded part of a pending incremental rehash
+        if (m_old_table != nullptr)
+            migrate(m_rehash_step);
+
+        // Find the linked list where the key belongs
+        auto &hash_list = bucket_at(hash);
+
+        // Check if the key already exists in the list
+        auto it = std::find_if(hash_list.begin(), hash_list.end(),
+                            [&](const node_type &entry) { return key_matches(entry, hash, key_); });
+        if (it != hash_list.end())
+            return { &*it, false };
+
+        // The key does not exist, build a new element directly in a list node
+        hash_list.emplace_front(std::piecewise_construct, std::forward<K>(key_), std::forward<Args>(args_)...);
+        auto *entry = &hash_list.front();
+        entry->store_hash(hash);
+        m_count++;
+
+        // Rehashing relinks nodes, so `entry` stays valid
+        grow_if_needed();
+        return { entry, true };
+    }
+
+    /*!
+     * @brief Finds the bucket (linked list) where a key is, or would be, stored.
+     *
+     * During an incremental rehash, a key whose old bucket has not been moved yet still lives
+     * in the old array; otherwise it lives in the current one.
+     *
+     * @param key_ The key.
+     * @return The linked list for the key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::list_type &
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::bucket_of(const K &key_) const
+    {
+        return bucket_at(KeyHash()(key_));
+    }
+
+    /*!
+     * @brief Finds the bucket (linked list) for a hash value already computed by `KeyHash`.
+     *
+     * @param hash_ The hash of the key.
+     * @return The linked list for the key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::list_type &
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::bucket_at(std::size_t hash_) const
+    {
+        if (m_old_table != nullptr) {
+            auto old_index = m_old_policy.index(hash_);
+            if (old_index >= m_migrated)
+                return m_old_table[old_index];
+        }
+        return m_table[m_policy.index(hash_)];
+    }
+
+    /*!
+     * @brief Returns the `KeyHash` of an entry's key, from the entry itself when it caches it.
+     *
+     * @param entry_ An entry of this table.
+     * @return The hash of its key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    std::size_t HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::hash_of(const node_type &entry_) const
+    {
+        if constexpr (cache_hash<KeyType>::value)
+            return entry_.m_hash;
+        else
+            return KeyHash()(entry_.m_key);
+    }
+
+    /*!
+     * @brief Tests an entry against a key, rejecting it by the cached hash before calling `KeyEqual`.
+     *
+     * @param entry_ An entry of this table.
+     * @param hash_ The hash of `key_`.
+     * @param key_ The key.
+     * @return true if the entry holds the key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::key_matches(const node_type &entry_, std::size_t hash_, const K &key_)
+    {
+        return entry_.hash_may_match(hash_) && KeyEqual()(entry_.m_key, key_);
+    }
+
+    /*!
+     * @brief Finds the entry stored for a key.
+     *
+     * Shared by every lookup. `K` is `KeyType`, or any type accepted by transparent functors.
+     *
+     * @param key_ The key.
+     * @return The entry, or nullptr if the key is not in the table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::node_type *
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::find_entry(const K &key_) const
+    {
+        return find_entry(key_, KeyHash()(key_));
+    }
 
-        // Update the table to point to the new table
-        m_table = m_table2;
+    /*!
+     * @brief Finds the entry stored for a key whose hash is already known.
+     *
+     * @param key_ The key.
+     * @param hash The `KeyHash` of the key.
+     * @return The entry, or nullptr if the key is not in the table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::node_type *
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::find_entry(const K &key_, std::size_t hash) const
+    {
+        size_type probes{0};
+        for (auto &entry : bucket_at(hash)) {
+            ++probes;
+            if (key_matches(entry, hash, key_)) {
+                m_counters.lookup(true, probes);
+                return &entry;
+            }
+        }
+        m_counters.lookup(false, probes);
+        return nullptr;
     }
 
     /*!
@@ -249,25 +895,54 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
      * @param key_ The key of the element to be removed.
      * @return true if the removal is successful, false if the key is not found.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual>::erase(const KeyType &key_)
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::erase(const KeyType &key_)
     {
-        // Calculate the hash value for the key
-        size_t hash_value = KeyHash()(key_) % m_size;
+        return erase_key(KeyHash()(key_), key_);
+    }
 
-        // Get the linked list corresponding to the hash position
-        auto &hash_list = m_table[hash_value];
+    /*!
+     * @brief Removes the element whose key compares equal to `key_`, given as any type the hash
+     * and equality accept.
+     *
+     * Only available when both `KeyHash` and `KeyEqual` declare `is_transparent`.
+     *
+     * @param key_ The key of the element to be removed.
+     * @return true if the removal is successful, false if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K, class>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::erase(const K &key_)
+    {
+        return erase_key(KeyHash()(key_), key_);
+    }
 
-        // Search for the element with the provided key in the list
-        auto it = std::find_if(hash_list.begin(), hash_list.end(),
-                                [&](const entry_type &entry) { return KeyEqual()(entry.m_key, key_); });
+    /*!
+     * @brief Removes the element with the provided key; shared by both erase() overloads.
+     *
+     * @param hash The `KeyHash` of the key, computed by the caller.
+     * @param key_ The key of the element to be removed.
+     * @return true if the removal is successful, false if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K>
+    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::erase_key(std::size_t hash, const K &key_)
+    {
+        // Pay for a bounded part of a pending incremental rehash
+        if (m_old_table != nullptr)
+            migrate(m_rehash_step);
 
-        // Check if any element was removed
-        if (it != hash_list.end()) {
-            // Remove the removed elements from the list
-            hash_list.remove_if([&](const entry_type &entry) { return KeyEqual()(entry.m_key, key_); });
-            m_count--; // Update the element count in the table
-            return true;
+        // Get the linked list corresponding to the hash position
+        auto &hash_list = bucket_at(hash);
+
+        // One scan, one step behind: the node before the match is what erase_after needs
+        for (auto prev = hash_list.before_begin(), it = hash_list.begin(); it != hash_list.end(); prev = it++) {
+            if (key_matches(*it, hash, key_)) {
+                hash_list.erase_after(prev);
+                m_count--; // Update the element count in the table
+                shrink_if_needed();
+                return true;
+            }
         }
 
         // The key was not found in the hash table
@@ -275,20 +950,184 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
     }
 
     /*!
-     * @brief Returns the number of elements in the hash table.
+     * @brief Removes every element for which `pred_(key, data)` is true, in one sweep over all buckets.
      *
-     * @param key_ The key to count.
-     * @return The number of occurrences of the key in the hash table.
+     * Cheaper than erasing the matching keys one by one: no key is hashed and no chain is
+     * searched twice. With a minimum load factor set, the table then shrinks if it fell under it.
+     *
+     * @param pred_ Predicate called once per element; it must not modify the table.
+     * @return The number of elements removed.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
-    HashTbl<KeyType, DataType, KeyHash, KeyEqual>::count(const KeyType &key_) const
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class Predicate>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::size_type
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::erase_if(Predicate pred_)
     {
-        // Calculate the hash value for the key
-        size_t hash_value = KeyHash()(key_) % m_size;
+        size_type removed{0};
+        auto sweep = [&](list_type &list) {
+            for (auto prev = list.before_begin(); std::next(prev) != list.end();) {
+                const auto &entry = *std::next(prev);
+                if (pred_(entry.m_key, entry.m_data)) {
+                    list.erase_after(prev);
+                    ++removed;
+                } else {
+                    ++prev;
+                }
+            }
+        };
+        for (size_type i{0}; i < m_size; ++i)
+            sweep(m_table[i]);
+        // Elements an incremental rehash has not moved yet
+        for (size_type i{m_migrated}; m_old_table != nullptr && i < m_old_size; ++i)
+            sweep(m_old_table[i]);
+
+        m_count -= removed;
+        shrink_if_needed();
+        return removed;
+    }
 
+    /*!
+     * @brief Looks up `n_` keys at once, overlapping their cache misses.
+     *
+     * Keys are processed in windows of BATCH_WINDOW. For a window, every key is hashed and
+     * its bucket prefetched; then the first node of every non-empty bucket is prefetched;
+     * only then are the chains walked. The loads of one window are thus in flight together
+     * instead of one after the other, as in a loop of retrieve() calls.
+     *
+     * @param keys_ The keys to search for.
+     * @param n_ Number of keys.
+     * @param data_ Receives, at the same index, the data of each key found (others are untouched).
+     * @param found_ If not null, receives at the same index whether each key was found.
+     * @return The number of keys found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::size_type
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::retrieve_batch(const KeyType *keys_, size_type n_, DataType *data_, bool *found_) const
+    {
+        size_type found{0};
+        std::size_t hashes[BATCH_WINDOW];
+        list_type *lists[BATCH_WINDOW];
+        for (size_type base{0}; base < n_; base += BATCH_WINDOW) {
+            const auto window = std::min(BATCH_WINDOW, n_ - base);
+            // Stage 1: hash, then prefetch the bucket (the list object holding the head pointer).
+            for (size_type i{0}; i < window; ++i) {
+                hashes[i] = KeyHash()(keys_[base + i]);
+                lists[i] = &bucket_at(hashes[i]);
+                AC_PREFETCH(lists[i]);
+            }
+            // Stage 2: the bucket is (hopefully) cached now; prefetch the first node of the chain.
+            for (size_type i{0}; i < window; ++i)
+                if (!lists[i]->empty())
+                    AC_PREFETCH(&lists[i]->front());
+            // Stage 3: resolve.
+            for (size_type i{0}; i < window; ++i) {
+                const node_type *hit{nullptr};
+                size_type probes{0};
+                for (auto &entry : *lists[i]) {
+                    ++probes;
+                    if (key_matches(entry, hashes[i], keys_[base + i])) {
+                        hit = &entry;
+                        break;
+                    }
+                }
+                m_counters.lookup(hit != nullptr, probes);
+                if (hit != nullptr) {
+                    data_[base + i] = hit->m_data;
+                    ++found;
+                }
+                if (found_ != nullptr)
+                    found_[base + i] = hit != nullptr;
+            }
+        }
+        return found;
+    }
+
+    /*!
+     * @brief Inserts `n_` key-value pairs, replacing the data of keys already present.
+     *
+     * Same as calling insert() for each pair in order, but keys are hashed and their buckets
+     * prefetched a window at a time (see retrieve_batch()).
+     *
+     * @param keys_ The keys to be inserted.
+     * @param data_ The data associated with each key, at the same index.
+     * @param n_ Number of pairs.
+     * @return The number of keys that were not in the table before.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::size_type
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::insert_batch(const KeyType *keys_, const DataType *data_, size_type n_)
+    {
+        size_type inserted{0};
+        std::size_t hashes[BATCH_WINDOW];
+        for (size_type base{0}; base < n_; base += BATCH_WINDOW) {
+            const auto window = std::min(BATCH_WINDOW, n_ - base);
+            for (size_type i{0}; i < window; ++i) {
+                hashes[i] = KeyHash()(keys_[base + i]);
+                AC_PREFETCH(&bucket_at(hashes[i]));
+            }
+            for (size_type i{0}; i < window; ++i) {
+                auto &list = bucket_at(hashes[i]);
+                if (!list.empty())
+                    AC_PREFETCH(&list.front());
+            }
+            // A rehash in this loop only makes the prefetches above useless, not wrong.
+            for (size_type i{0}; i < window; ++i) {
+                auto [entry, is_new] = emplace_key(hashes[i], keys_[base + i], data_[base + i]);
+                if (is_new)
+                    ++inserted;
+                else
+                    entry->m_data = data_[base + i];
+            }
+        }
+        return inserted;
+    }
+
+    /*!
+     * @brief Removes `n_` keys, prefetching their buckets a window at a time (see retrieve_batch()).
+     *
+     * @param keys_ The keys to be removed.
+     * @param n_ Number of keys.
+     * @return The number of keys that were found and removed.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::size_type
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::erase_batch(const KeyType *keys_, size_type n_)
+    {
+        size_type erased{0};
+        std::size_t hashes[BATCH_WINDOW];
+        for (size_type base{0}; base < n_; base += BATCH_WINDOW) {
+            const auto window = std::min(BATCH_WINDOW, n_ - base);
+            for (size_type i{0}; i < window; ++i) {
+                hashes[i] = KeyHash()(keys_[base + i]);
+                AC_PREFETCH(&bucket_at(hashes[i]));
+            }
+            for (size_type i{0}; i < window; ++i) {
+                auto &list = bucket_at(hashes[i]);
+                if (!list.empty())
+                    AC_PREFETCH(&list.front());
+            }
+            for (size_type i{0}; i < window; ++i)
+                if (erase_key(hashes[i], keys_[base + i]))
+                    ++erased;
+        }
+        return erased;
+    }
+
+    /*!
+     * @brief Returns the number of elements in the bucket of a key.
+     *
+     * That is the length of the chain a lookup of the key walks, whether or not the key is in
+     * the table; MultiHashTbl::count() counts the values of one key.
+     *
+     * @param key_ The key whose bucket is counted.
+     * @return The number of elements hashed to the same bucket as the key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::size_type
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::count(const KeyType &key_) const
+    {
         // Get the linked list corresponding to the hash position
-        auto &hash_list = m_table[hash_value];
+        auto &hash_list = bucket_of(key_);
 
         size_type count{0};
 
@@ -299,6 +1138,23 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
         return count;
     }
 
+    /*!
+     * @brief count() for a key given as any type the hash and equality accept.
+     *
+     * Only available when both `KeyHash` and `KeyEqual` declare `is_transparent`.
+     *
+     * @param key_ The key to count.
+     * @return The same value as count() with the equivalent `KeyType`.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K, class>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::size_type
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::count(const K &key_) const
+    {
+        auto &hash_list = bucket_of(key_);
+        return static_cast<size_type>(std::distance(hash_list.begin(), hash_list.end()));
+    }
+
     /*!
      * @brief Retrieves the value associated with the specified key.
      *
@@ -310,24 +1166,93 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
      * @return A reference to the value associated with the key.
      * @throws std::out_of_range if the key is not found.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    DataType& HashTbl<KeyType, DataType, KeyHash, KeyEqual>::at(const KeyType &key_)
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    DataType& HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::at(const KeyType &key_)
     {
-        // Calculate the hash index
-        auto hash_index = KeyHash()(key_) % m_size;
+        auto *entry = find_entry(key_);
+        if (entry != nullptr) {
+            return entry->m_data;
+        }
 
-        // Iterate over the linked list at the hash position
-        auto &hash_list = m_table[hash_index];
+        throw std::out_of_range("Key not found");
+    }
 
-        // Check if the key already exists in the list
-        auto it = std::find_if(hash_list.begin(), hash_list.end(),
-                            [&](const entry_type &entry) { return KeyEqual()(entry.m_key, key_); });
+    /*!
+     * @brief at() for a key given as any type the hash and equality accept.
+     *
+     * Only available when both `KeyHash` and `KeyEqual` declare `is_transparent`.
+     *
+     * @param key_ The key to retrieve the associated value.
+     * @return A reference to the value associated with the key.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K, class>
+    DataType& HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::at(const K &key_)
+    {
+        auto *entry = find_entry(key_);
+        if (entry != nullptr)
+            return entry->m_data;
+        throw std::out_of_range("Key not found");
+    }
 
-        if (it != hash_list.end()) {
-            return it->m_data;
-        }
+    /*!
+     * @brief Finds the data associated with a key, without throwing when it is absent.
+     *
+     * @param key_ The key to look up.
+     * @return Pointer to the data, or nullptr if the key is not in the table. It stays valid
+     *         until the key is erased (rehashing relinks nodes and does not move entries).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    DataType* HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::find(const KeyType &key_)
+    {
+        auto *entry = find_entry(key_);
+        return entry != nullptr ? &entry->m_data : nullptr;
+    }
 
-        throw std::out_of_range("Key not found");
+    /*!
+     * @brief Finds the data associated with a key, without throwing when it is absent.
+     *
+     * @param key_ The key to look up.
+     * @return Pointer to the data, or nullptr if the key is not in the table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    const DataType* HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::find(const KeyType &key_) const
+    {
+        auto *entry = find_entry(key_);
+        return entry != nullptr ? &entry->m_data : nullptr;
+    }
+
+    /*!
+     * @brief find() for a key given as any type the hash and equality accept.
+     *
+     * Only available when both `KeyHash` and `KeyEqual` declare `is_transparent`.
+     *
+     * @param key_ The key to look up.
+     * @return Pointer to the data, or nullptr if the key is not in the table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K, class>
+    DataType* HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::find(const K &key_)
+    {
+        auto *entry = find_entry(key_);
+        return entry != nullptr ? &entry->m_data : nullptr;
+    }
+
+    /*!
+     * @brief find() for a key given as any type the hash and equality accept.
+     *
+     * Only available when both `KeyHash` and `KeyEqual` declare `is_transparent`.
+     *
+     * @param key_ The key to look up.
+     * @return Pointer to the data, or nullptr if the key is not in the table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    template <class K, class>
+    const DataType* HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::find(const K &key_) const
+    {
+        auto *entry = find_entry(key_);
+        return entry != nullptr ? &entry->m_data : nullptr;
     }
 
     /*!
@@ -341,32 +1266,12 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
      * @param key_ The key to access or insert.
      * @return A reference to the value associated with the key.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    DataType& HashTbl<KeyType, DataType, KeyHash, KeyEqual>::operator[](const KeyType &key_)
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    DataType& HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::operator[](const KeyType &key_)
     {
-        // Calculate the hash index
-        auto hash_index = KeyHash()(key_) % m_size;
-
-        // Iterate over the linked list at the hash position
-        auto &hash_list = m_table[hash_index];
-        
-
-        // Search for the element with the provided key in the list
-        auto it = std::find_if(hash_list.begin(), hash_list.end(),
-                            [&](const entry_type &entry) { return KeyEqual()(entry.m_key, key_); });
-
-        // Check if the key already exists in the list
-        if (it != hash_list.end()) {
-            // If the key already exists, return a reference to the value associated with the key
-            return it->m_data;
-        } 
-        else {
-            // If the key does not exist, insert a new element into the table
-            insert(key_, DataType{}); // Here you can use DataType{} or any desired default value
-            // Search again for the newly inserted element
-            hash_list.emplace_front(key_, DataType());
-            return hash_list.front().m_data; // Return a reference to the newly inserted value
-        }
+        // Find the key, or insert it with a value-initialized data.
+        // Nodes are never reallocated, so the entry stays put even if the insertion rehashed the table.
+        return emplace_key(KeyHash()(key_), key_).first->m_data;
     }
     /*!
      * @brief Set the maximum load factor for the hash table.
@@ -378,8 +1283,8 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
      *
      * @param mlf The new maximum load factor.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::max_load_factor(float mlf)
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::max_load_factor(float mlf)
     {
         m_factor_load = mlf;
     }
@@ -391,12 +1296,85 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
      *
      * @return The current maximum load factor.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    float HashTbl<KeyType, DataType, KeyHash, KeyEqual>::max_load_factor() const
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    float HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::max_load_factor() const
     {
         return m_factor_load;
     }
 
+    /*!
+     * @brief Sets the load factor under which erasing elements shrinks the table.
+     *
+     * With `lf > 0`, an `erase()`, `erase_batch()`, `erase_if()` or `clear()` that leaves
+     * `size() < lf * bucket_count()` rebuilds the table with twice the buckets its elements need
+     * (see shrink_if_needed()), returning the rest of the bucket array. Keep `lf` well under the
+     * load at which the table grows (e.g. a quarter of it). With 0 (the default) the table never
+     * shrinks by itself; shrink_to_fit() still does on demand.
+     *
+     * @param lf The new minimum load factor.
+     * @throws std::invalid_argument if `lf` is negative.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::min_load_factor(float lf)
+    {
+        if (lf < 0)
+            throw std::invalid_argument("min_load_factor must not be negative");
+        m_min_load = lf;
+    }
+
+    /*!
+     * @brief Get the load factor under which erasing elements shrinks the table.
+     *
+     * @return The minimum load factor, 0 meaning that the table never shrinks by itself.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    float HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::min_load_factor() const
+    {
+        return m_min_load;
+    }
+
+    /*!
+     * @brief Rebuilds the table with the fewest buckets its elements need, at once.
+     *
+     * Same as `rehash(0)`. Useful after a purge when the table will not grow back soon.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::shrink_to_fit()
+    {
+        rehash(0);
+    }
+
+    /*!
+     * @brief Set how many old buckets each mutating call moves during a rehash.
+     *
+     * With 0 (the default) the table is rehashed all at once, by the insertion that crosses the
+     * maximum load factor. With `n > 0` the rehash is incremental: the old bucket array is kept,
+     * lookups check whichever array holds the key, and every `insert()`, `erase()` or inserting
+     * `operator[]` moves at most `n` old buckets, which bounds the latency of each call.
+     *
+     * @param buckets Number of old buckets moved per mutating call.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::rehash_step(size_type buckets)
+    {
+        m_rehash_step = buckets;
+        // Going back to stop-the-world mode: finish now.
+        if (m_rehash_step == 0 && m_old_table != nullptr)
+            migrate(m_old_size);
+    }
+
+    /*!
+     * @brief Get how many old buckets each mutating call moves during a rehash.
+     *
+     * @return The number of buckets, 0 meaning that rehashing is not incremental.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::size_type
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::rehash_step() const
+    {
+        return m_rehash_step;
+    }
+
 
 
     /*=================== Métodos auxiliares ==============================*/
@@ -405,26 +1383,39 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
      *
      * This function initializes the current hash table by copying the contents of another hash table.
      * It adjusts the size, count, and table structure to match the source hash table and inserts each
-     * key-value pair from the source into the current hash table.
+     * key-value pair from the source into the current hash table. The table must hold no bucket
+     * array: the constructor has none yet, and operator= frees them first.
      *
      * @param source The source hash table to copy from.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::initialize_hash(const HashTbl& source) {
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::initialize_hash(const HashTbl& source) {
 
         
         // Copy the data from the source table
         m_size = source.m_size;
         m_count = source.m_count;
+        m_policy = source.m_policy;
+        m_factor_load = source.m_factor_load;
+        m_rehash_step = source.m_rehash_step;
+        m_min_load = source.m_min_load;
+
+        // Copy the part of an incremental rehash the source has not finished
+        if (source.m_old_table != nullptr) {
+            m_old_size = source.m_old_size;
+            m_old_policy = source.m_old_policy;
+            m_migrated = source.m_migrated;
+            m_old_table = allocate_buckets(m_old_size);
+            for (size_t i{m_migrated}; i < m_old_size; ++i)
+                m_old_table[i].assign(source.m_old_table[i].begin(), source.m_old_table[i].end());
+        }
 
         // Allocate a new table with the adjusted size
-        m_table = new std::forward_list<entry_type>[m_size];
-
-        //m_table = source.m_table;
+        m_table = allocate_buckets(m_size);
 
-        //Iterate through the source table and insert each key-value pair into the current table
+        //Iterate through the source table and copy each list; the nodes come from our own allocator
         for (size_t i{0}; i < source.m_size; ++i) {
-            m_table[i] = source.m_table[i];
+            m_table[i].assign(source.m_table[i].begin(), source.m_table[i].end());
         }
     }
 
@@ -439,17 +1430,23 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
      * @param ilist The initializer list containing key-value pairs.
      *
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::initialize_hash_ilist(
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::initialize_hash_ilist(
         const std::initializer_list<entry_type>& ilist) {
         
-        m_size = m_count = ilist.size();
+        // Free the previous contents, with any incremental rehash in progress
+        free_buckets(m_table, m_size);
+        free_buckets(m_old_table, m_old_size);
+        m_old_table = nullptr;
+
+        // Size the table once, for the whole list: the insertions below never rehash
+        m_size = m_policy.reset(buckets_for(ilist.size()));
         
-        // Set the size and count to match the initializer list size
-        m_count = ilist.size();
+        // The insertions count the elements (a repeated key only once)
+        m_count = 0;
 
         // Allocate a new table with the adjusted size
-        m_table = new std::forward_list<entry_type>[m_size];
+        m_table = allocate_buckets(m_size);
 
         // Iterate through the initializer list and insert each key-value pair into the current table
         for (const auto& entry : ilist) {
@@ -457,57 +1454,42 @@ void HashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
         }
     }
 
+
+
     /*!
-     * @brief Checks if a given number is a prime number.
+     * @brief Allocates `n` empty buckets with the table's allocator.
      *
-     * This function checks whether the provided number is a prime number.
-     * It returns true if the number is prime and false otherwise.
-     *
-     * @param num The number to be checked for primality.
-     * @return true if the number is prime, false otherwise.
+     * Each bucket list receives a copy of the allocator, so its nodes come from it too.
      *
+     * @param n Number of buckets.
+     * @return Pointer to the first bucket.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    bool HashTbl<KeyType, DataType, KeyHash, KeyEqual>::isPrime(size_type num) const {
-        // Check if the number is less than or equal to 1
-        if (num <= 1) {
-            return false; // 1 is not a prime number, and negatives are not prime either
-        }
-        // Iterate from 2 to the square root of the number
-        for (int i = 2; i * i <= num; ++i) {
-            // If the number is divisible by any value in the range, it is not prime
-            if (num % i == 0) {
-                return false;
-            }
-        }
-        // If no divisor is found, the number is prime
-        return true;
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    typename HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::list_type*
+    HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::allocate_buckets(size_type n) {
+        bucket_allocator alloc(m_alloc);
+        list_type *buckets = bucket_traits::allocate(alloc, n);
+        for (size_type i{0}; i < n; ++i)
+            bucket_traits::construct(alloc, buckets + i, m_alloc);
+        return buckets;
     }
 
     /*!
-     * @brief Finds the next prime number greater than the given number.
+     * @brief Destroys `n` buckets made by allocate_buckets(), with their entries, and frees the array.
      *
-     * This function finds the next prime number greater than the provided number.
-     * It iteratively increments the given number until a prime number is found.
-     *
-     * @param num The number for which the next prime is to be found.
-     * @return The next prime number greater than the provided number.
+     * @param buckets Pointer to the first bucket (may be null).
+     * @param n Number of buckets.
      */
-    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
-    int HashTbl<KeyType, DataType, KeyHash, KeyEqual>::nextPrime(size_type num) const {
-        // Continue incrementing the number until a prime number is found
-        while (true) {
-            ++num;
-
-            // If the current number is prime, return it
-            if (isPrime(num)) {
-                return num;
-            }
-        }
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy, typename Allocator>
+    void HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator>::free_buckets(list_type *buckets, size_type n) {
+        if (buckets == nullptr)
+            return;
+        bucket_allocator alloc(m_alloc);
+        for (size_type i{0}; i < n; ++i)
+            bucket_traits::destroy(alloc, buckets + i);
+        bucket_traits::deallocate(alloc, buckets, n);
     }
 
-
-
 } // Namespace ac.
 
 
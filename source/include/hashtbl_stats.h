@@ -0,0 +1,217 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef HASHTBL_STATS_H
+#define HASHTBL_STATS_H
+
+#include <atomic>    // std::atomic
+#include <chrono>    // std::chrono::steady_clock, std::chrono::nanoseconds
+#include <cstddef>   // std::size_t
+#include <ostream>
+#include <vector>
+
+// Define AC_HASHTBL_STATS to 1 to make HashTbl count lookups, probes and rehashes.
+// Every translation unit of a program must see the same value.
+#ifndef AC_HASHTBL_STATS
+#define AC_HASHTBL_STATS 0
+#endif
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief A snapshot of the shape and activity of a HashTbl, returned by `HashTbl::stats()`.
+     *
+     * The chain figures and the memory estimate are computed when the snapshot is taken, in
+     * every build. The counters (lookups, probes, rehashes) are only kept when the program
+     * is built with AC_HASHTBL_STATS=1; otherwise they stay zero and `counters_enabled` is false.
+     */
+    struct HashTblStats {
+        std::vector<std::size_t> chain_histogram; //!< [i]: number of buckets holding i elements.
+        std::size_t max_chain{0};       //!< Longest chain.
+        double mean_chain{0};           //!< Mean length of the non-empty chains.
+        std::size_t bytes_allocated{0}; //!< Bucket arrays plus entry nodes (not what keys and data own).
+
+        bool counters_enabled{false};   //!< Whether the fields below were counted.
+        std::size_t hits{0};            //!< Successful lookups.
+        std::size_t misses{0};          //!< Failed lookups.
+        std::size_t hit_probes{0};      //!< Entries visited by the successful lookups.
+        std::size_t miss_probes{0};     //!< Entries visited by the failed lookups.
+        std::size_t rehashes{0};        //!< Bucket arrays replaced.
+        std::chrono::nanoseconds rehash_time{0}; //!< Time spent allocating new arrays and moving nodes.
+
+        // Membership filter of a FilteredHashTbl (all zero for a plain HashTbl).
+        std::size_t filter_bytes{0};    //!< Size of the filter's counter blocks.
+        double filter_fpr{0};           //!< False-positive rate expected from the filter's current fill.
+        std::size_t filter_rejects{0};  //!< Lookups of absent keys answered by the filter alone (counter).
+        std::size_t filter_false_positives{0}; //!< Lookups the filter let through for an absent key (counter).
+
+        double probes_per_hit() const { return hits == 0 ? 0 : static_cast<double>(hit_probes) / hits; }
+        double probes_per_miss() const { return misses == 0 ? 0 : static_cast<double>(miss_probes) / misses; }
+        /// Share of the lookups of absent keys that the filter failed to reject.
+        double observed_filter_fpr() const
+        {
+            auto absent = filter_rejects + filter_false_positives;
+            return absent == 0 ? 0 : static_cast<double>(filter_false_positives) / absent;
+        }
+
+        friend std::ostream & operator<<( std::ostream & os_, const HashTblStats & s_ )
+        {
+            os_ << "chains: max " << s_.max_chain << ", mean " << s_.mean_chain << ", histogram [";
+            for (std::size_t i{0}; i < s_.chain_histogram.size(); ++i)
+                os_ << (i == 0 ? "" : " ") << s_.chain_histogram[i];
+            os_ << "]\nmemory: " << s_.bytes_allocated << " bytes\n";
+            if (s_.filter_bytes != 0)
+                os_ << "filter: " << s_.filter_bytes << " bytes, expected fpr " << s_.filter_fpr << "\n";
+            if (!s_.counters_enabled)
+                return os_ << "counters: disabled (build with AC_HASHTBL_STATS=1)\n";
+            os_ << "lookups: " << s_.hits << " hits (" << s_.probes_per_hit() << " probes each), "
+                << s_.misses << " misses (" << s_.probes_per_miss() << " probes each)\n"
+                << "rehashes: " << s_.rehashes << " in " << s_.rehash_time.count() << " ns\n";
+            if (s_.filter_bytes != 0)
+                os_ << "filter lookups: " << s_.filter_rejects << " rejected, " << s_.filter_false_positives
+                    << " false positives (fpr " << s_.observed_filter_fpr() << ")\n";
+            return os_;
+        }
+    };
+
+    namespace detail {
+        /*!
+         * @brief The counters a HashTbl keeps when AC_HASHTBL_STATS is on.
+         *
+         * Lookups are const and may run concurrently (e.g. under ConcurrentHashTbl's shared
+         * locks), so the counters are atomics. They are bumped with a relaxed load and store
+         * rather than a read-modify-write: concurrent lookups may lose a count, but no lookup
+         * waits for another.
+         */
+        template <bool Enabled>
+        class TableCounters {
+            public:
+                static constexpr bool enabled = true;
+
+                void lookup( bool hit_, std::size_t probes_ ) const
+                {
+                    if (hit_) {
+                        bump(m_hits, 1);
+                        bump(m_hit_probes, probes_);
+                    } else {
+                        bump(m_misses, 1);
+                        bump(m_miss_probes, probes_);
+                    }
+                }
+                void rehash() { bump(m_rehashes, 1); }
+                void rehash_time( std::chrono::nanoseconds t_ ) { bump(m_rehash_ns, static_cast<std::size_t>(t_.count())); }
+
+                void fill( HashTblStats &s_ ) const
+                {
+                    s_.counters_enabled = true;
+                    s_.hits = m_hits.load(std::memory_order_relaxed);
+                    s_.misses = m_misses.load(std::memory_order_relaxed);
+                    s_.hit_probes = m_hit_probes.load(std::memory_order_relaxed);
+                    s_.miss_probes = m_miss_probes.load(std::memory_order_relaxed);
+                    s_.rehashes = m_rehashes.load(std::memory_order_relaxed);
+                    s_.rehash_time = std::chrono::nanoseconds(m_rehash_ns.load(std::memory_order_relaxed));
+                }
+                void reset()
+                {
+                    for (auto *c : { &m_hits, &m_misses, &m_hit_probes, &m_miss_probes, &m_rehashes, &m_rehash_ns })
+                        c->store(0, std::memory_order_relaxed);
+                }
+
+                TableCounters() = default;
+                // Copies start from zero: the counters describe one table's own history.
+                TableCounters( const TableCounters& ) {}
+                TableCounters& operator=( const TableCounters& ) { return *this; }
+
+            private:
+                using counter = std::atomic<std::size_t>;
+                static void bump( counter &c_, std::size_t n_ )
+                {
+                    c_.store(c_.load(std::memory_order_relaxed) + n_, std::memory_order_relaxed);
+                }
+
+                mutable counter m_hits{0}, m_misses{0}, m_hit_probes{0}, m_miss_probes{0};
+                counter m_rehashes{0}, m_rehash_ns{0};
+        };
+
+        /// Statistics disabled: every call compiles to nothing.
+        template <>
+        class TableCounters<false> {
+            public:
+                static constexpr bool enabled = false;
+
+                void lookup( bool, std::size_t ) const {}
+                void rehash() {}
+                void rehash_time( std::chrono::nanoseconds ) {}
+                void fill( HashTblStats & ) const {}
+                void reset() {}
+        };
+
+        /*!
+         * @brief The filter counters a FilteredHashTbl keeps when AC_HASHTBL_STATS is on.
+         *
+         * Kept apart from the TableCounters of the wrapped HashTbl, which only sees the lookups
+         * the filter lets through. Bumped the same lossy, wait-free way.
+         */
+        template <bool Enabled>
+        class FilterCounters {
+            public:
+                void reject() const { bump(m_rejects); }
+                void false_positive() const { bump(m_false_positives); }
+
+                void fill( HashTblStats &s_ ) const
+                {
+                    s_.filter_rejects = m_rejects.load(std::memory_order_relaxed);
+                    s_.filter_false_positives = m_false_positives.load(std::memory_order_relaxed);
+                }
+                void reset()
+                {
+                    m_rejects.store(0, std::memory_order_relaxed);
+                    m_false_positives.store(0, std::memory_order_relaxed);
+                }
+
+                FilterCounters() = default;
+                // Copies start from zero, like TableCounters.
+                FilterCounters( const FilterCounters& ) {}
+                FilterCounters& operator=( const FilterCounters& ) { return *this; }
+
+            private:
+                using counter = std::atomic<std::size_t>;
+                static void bump( counter &c_ )
+                {
+                    c_.store(c_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                }
+
+                mutable counter m_rejects{0}, m_false_positives{0};
+        };
+
+        template <>
+        class FilterCounters<false> {
+            public:
+                void reject() const {}
+                void false_positive() const {}
+                void fill( HashTblStats & ) const {}
+                void reset() {}
+        };
+
+        /// Adds the time from its construction to its destruction to the rehash time (when counters are on).
+        template <bool Enabled>
+        class RehashTimer {
+            public:
+                explicit RehashTimer( TableCounters<Enabled> &c_ ) : m_counters{c_} {}
+                ~RehashTimer() { m_counters.rehash_time(std::chrono::steady_clock::now() - m_start); }
+                RehashTimer( const RehashTimer& ) = delete;
+                RehashTimer& operator=( const RehashTimer& ) = delete;
+
+            private:
+                TableCounters<Enabled> &m_counters;
+                std::chrono::steady_clock::time_point m_start{std::chrono::steady_clock::now()};
+        };
+
+        template <>
+        class RehashTimer<false> {
+            public:
+                explicit RehashTimer( TableCounters<false> & ) {}
+        };
+    } // namespace detail
+
+} // namespace ac
+#endif
@@ -0,0 +1,124 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef MEMBERSHIP_FILTER_H
+#define MEMBERSHIP_FILTER_H
+
+#include <algorithm> // std::max, std::fill
+#include <bitset>    // std::bitset
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint64_t
+#include <vector>
+
+#include "hash_policy.h" // hash_mix
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Blocked counting Bloom filter over 64-bit hash values.
+     *
+     * Each hash value picks one 64-byte block (a cache line) of 128 four-bit counters and
+     * HASHES counters inside it, so a query reads a single cache line. Counters make removal
+     * possible: insert() increments the chosen counters, remove() decrements them, and
+     * may_contain() is false as soon as one of them is zero. A counter reaching 15 sticks
+     * there (removals no longer decrement it), which keeps the filter free of false negatives.
+     *
+     * The filter never reports a value it holds as absent; it reports an absent value as
+     * present with a probability that grows with the number of values per block.
+     * estimated_fpr() computes it from the current fill.
+     */
+    class CountingBloomFilter {
+        public:
+            using size_type = std::size_t;
+
+            static constexpr size_type COUNTERS_PER_BLOCK = 128;
+            static constexpr size_type COUNTERS_PER_KEY = 12; //!< Sizing: about 1% false positives at capacity.
+            static constexpr unsigned HASHES = 4;             //!< Counters per value (7 hash bits each).
+
+            /// Sizes the filter for `keys_` values.
+            explicit CountingBloomFilter( size_type keys_ = 0 )
+                : m_blocks(std::max<size_type>(1, (keys_ * COUNTERS_PER_KEY + COUNTERS_PER_BLOCK - 1) / COUNTERS_PER_BLOCK))
+            {/*Empty*/}
+
+            void insert( std::uint64_t hash_ )
+            {
+                auto h = hash_mix(hash_);
+                auto &block = block_of(h);
+                for (unsigned i{0}; i < HASHES; ++i) {
+                    auto pos = counter_of(h, i);
+                    auto &word = block.m_words[pos / 16];
+                    unsigned shift = (pos % 16) * 4;
+                    if (((word >> shift) & 0xF) != 0xF)
+                        word += std::uint64_t{1} << shift;
+                }
+            }
+
+            /// Undoes one insert() of `hash_`, which the caller guarantees happened.
+            void remove( std::uint64_t hash_ )
+            {
+                auto h = hash_mix(hash_);
+                auto &block = block_of(h);
+                for (unsigned i{0}; i < HASHES; ++i) {
+                    auto pos = counter_of(h, i);
+                    auto &word = block.m_words[pos / 16];
+                    unsigned shift = (pos % 16) * 4;
+                    auto counter = (word >> shift) & 0xF;
+                    if (counter != 0 && counter != 0xF)
+                        word -= std::uint64_t{1} << shift;
+                }
+            }
+
+            /// false: `hash_` was never inserted (or removed since); true: it probably was.
+            bool may_contain( std::uint64_t hash_ ) const
+            {
+                auto h = hash_mix(hash_);
+                const auto &block = block_of(h);
+                for (unsigned i{0}; i < HASHES; ++i) {
+                    auto pos = counter_of(h, i);
+                    if (((block.m_words[pos / 16] >> ((pos % 16) * 4)) & 0xF) == 0)
+                        return false;
+                }
+                return true;
+            }
+
+            void clear() { std::fill(m_blocks.begin(), m_blocks.end(), Block{}); }
+
+            /// Number of values the filter was sized for.
+            size_type capacity() const { return m_blocks.size() * COUNTERS_PER_BLOCK / COUNTERS_PER_KEY; }
+            size_type bytes() const { return m_blocks.size() * sizeof(Block); }
+
+            /// False-positive rate of a query for an absent value, from the share of non-zero counters of each block.
+            double estimated_fpr() const
+            {
+                double sum{0};
+                for (const auto &block : m_blocks) {
+                    size_type used{0};
+                    for (auto word : block.m_words) {
+                        // One bit per non-zero counter, at the counter's lowest bit
+                        word |= word >> 1;
+                        word |= word >> 2;
+                        used += std::bitset<64>(word & 0x1111111111111111ull).count();
+                    }
+                    double p = static_cast<double>(used) / COUNTERS_PER_BLOCK;
+                    sum += p * p * p * p;
+                }
+                return sum / m_blocks.size();
+            }
+
+        private:
+            static_assert(HASHES == 4, "estimated_fpr() raises the fill to the power HASHES");
+
+            /// One cache line: 16 counters per word.
+            struct alignas(64) Block {
+                std::uint64_t m_words[8]{};
+            };
+
+            // The high 32 bits pick the block (multiply-shift), the low 28 bits the counters.
+            Block& block_of( std::uint64_t h_ ) { return m_blocks[((h_ >> 32) * m_blocks.size()) >> 32]; }
+            const Block& block_of( std::uint64_t h_ ) const { return m_blocks[((h_ >> 32) * m_blocks.size()) >> 32]; }
+            static unsigned counter_of( std::uint64_t h_, unsigned i_ ) { return static_cast<unsigned>(h_ >> (7 * i_)) & 127; }
+
+            std::vector<Block> m_blocks;
+    };
+
+} // namespace ac
+#endif
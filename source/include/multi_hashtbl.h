@@ -0,0 +1,85 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef MULTI_HASHTBL_H
+#define MULTI_HASHTBL_H
+
+#include <algorithm>        // std::remove_if
+#include <cstddef>          // std::size_t
+#include <functional>       // std::hash, std::equal_to
+#include <initializer_list>
+#include <utility>          // std::pair, std::move
+#include <vector>
+
+#include "hashtbl.h"
+#include "hash_policy.h" // prime_index_policy
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Hash table mapping each key to any number of values (a multimap).
+     *
+     * Each key has a single entry in a HashTbl, holding all of the key's values contiguously
+     * in a vector (its group). A lookup walks the chain of distinct keys only, however many
+     * values a key has. equal_range() returns the group as a pair of pointers, without copying
+     * anything, and count() is its size.
+     *
+     * Values of a key keep their insertion order. Pointers from equal_range() stay valid until
+     * a value is added to or erased from that key.
+     */
+	template< class KeyType,
+		      class DataType,
+		      class KeyHash = std::hash< KeyType >,
+		      class KeyEqual = std::equal_to< KeyType >,
+		      class IndexPolicy = prime_index_policy >
+	class MultiHashTbl {
+        public:
+            // Aliases
+            using key_type = KeyType;
+            using mapped_type = DataType;
+            using group_type = std::vector<DataType>;
+            using table_type = HashTbl<KeyType, group_type, KeyHash, KeyEqual, IndexPolicy>;
+            using size_type  = std::size_t;
+            template <class K>
+            using if_transparent = typename table_type::template if_transparent<K>;
+
+            explicit MultiHashTbl( size_type table_sz_ = DEFAULT_SIZE );
+            MultiHashTbl( const std::initializer_list< std::pair<KeyType, DataType> > & );
+
+            bool insert( const KeyType &, const DataType & );
+            bool insert( const KeyType &, DataType && );
+            std::pair<DataType*, DataType*> equal_range( const KeyType & );
+            std::pair<const DataType*, const DataType*> equal_range( const KeyType & ) const;
+            template <class K, class = if_transparent<K>>
+            std::pair<const DataType*, const DataType*> equal_range( const K & ) const;
+            size_type count( const KeyType & ) const;
+            template <class K, class = if_transparent<K>> size_type count( const K & ) const;
+            bool contains( const KeyType & ) const;
+            size_type erase( const KeyType & );
+            template <class Predicate> size_type erase_if( const KeyType &, Predicate );
+            void clear();
+            template <class Function> void for_each( Function && ) const;
+
+            inline bool empty() const { return m_count == 0; };
+            /// Number of values, over all keys.
+            inline size_type size() const { return m_count; };
+            /// Number of distinct keys.
+            inline size_type key_count() const { return m_table.size(); };
+            inline size_type bucket_count() const { return m_table.bucket_count(); };
+            /// Makes room for `n` distinct keys without rehashing.
+            inline void reserve( size_type n_ ) { m_table.reserve(n_); };
+            inline float max_load_factor() const { return m_table.max_load_factor(); };
+            inline void max_load_factor( float mlf_ ) { m_table.max_load_factor(mlf_); };
+
+        private:
+            template <class D> bool insert_value( const KeyType &, D && );
+
+        private:
+            table_type m_table;    //!< One entry (and one group) per distinct key.
+            size_type m_count{0};  //!< Number of values.
+
+            static constexpr size_type DEFAULT_SIZE = 11;
+    };
+
+} // namespace ac
+#include "multi_hashtbl.inl"
+#endif
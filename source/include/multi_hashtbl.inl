@@ -0,0 +1,250 @@
+#include "multi_hashtbl.h"
+
+/*!
+ * @file multi_hashtbl.inl
+ * @brief Implementation of the MultiHashTbl class (several values per key, grouped).
+ *
+ * Authors: Gabriel Victor and Thiago Raquel.
+ */
+
+namespace ac {
+    /*!
+     * @brief Constructor that creates an empty table.
+     *
+     * @param table_sz_ Initial number of buckets, rounded up by the index policy.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::MultiHashTbl(size_type table_sz_)
+        : m_table(table_sz_)
+    {/*Empty*/}
+
+    /*!
+     * @brief Constructor that inserts the pairs of a list, in order (a repeated key gets several values).
+     *
+     * @param ilist The key-value pairs.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::MultiHashTbl(
+        const std::initializer_list<std::pair<KeyType, DataType>> &ilist)
+        : m_table(DEFAULT_SIZE)
+    {
+        for (const auto &pair : ilist)
+            insert(pair.first, pair.second);
+    }
+
+    /*!
+     * @brief Adds a value to a key, after the values it already has.
+     *
+     * @param key_ The key.
+     * @param data_item_ The value, copied.
+     * @return true if it is the first value of the key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::insert(const KeyType &key_, const DataType &data_item_)
+    {
+        return insert_value(key_, data_item_);
+    }
+
+    /*!
+     * @brief Adds a value to a key, after the values it already has.
+     *
+     * @param key_ The key.
+     * @param data_item_ The value, moved into the table.
+     * @return true if it is the first value of the key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::insert(const KeyType &key_, DataType &&data_item_)
+    {
+        return insert_value(key_, std::move(data_item_));
+    }
+
+    /*!
+     * @brief Appends a value to the group of a key, creating the group if needed.
+     *
+     * @param key_ The key.
+     * @param data_item_ The value, forwarded into the group.
+     * @return true if the group was created.
+     * @throws Whatever building the value throws; the table is then unchanged.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class D>
+    bool MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::insert_value(const KeyType &key_, D &&data_item_)
+    {
+        // One lookup: the group is found, or made empty (the table holds no empty group)
+        auto &group = m_table[key_];
+        bool created = group.empty();
+        try {
+            group.push_back(std::forward<D>(data_item_));
+        } catch (...) {
+            // push_back left the group as it was: a group made for this value goes away again.
+            if (created)
+                m_table.erase(key_);
+            throw;
+        }
+        ++m_count;
+        return created;
+    }
+
+    /*!
+     * @brief Returns the values of a key, in insertion order, without copying them.
+     *
+     * @param key_ The key to look up.
+     * @return Pointers to the first value and past the last one (equal if the key is absent).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    std::pair<DataType*, DataType*>
+    MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::equal_range(const KeyType &key_)
+    {
+        auto *group = m_table.find(key_);
+        if (group == nullptr)
+            return { nullptr, nullptr };
+        return { group->data(), group->data() + group->size() };
+    }
+
+    /*!
+     * @brief Returns the values of a key, in insertion order, without copying them.
+     *
+     * @param key_ The key to look up.
+     * @return Pointers to the first value and past the last one (equal if the key is absent).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    std::pair<const DataType*, const DataType*>
+    MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::equal_range(const KeyType &key_) const
+    {
+        const auto *group = m_table.find(key_);
+        if (group == nullptr)
+            return { nullptr, nullptr };
+        return { group->data(), group->data() + group->size() };
+    }
+
+    /*!
+     * @brief equal_range() for a key given as any type the hash and equality accept.
+     *
+     * Only available when both `KeyHash` and `KeyEqual` declare `is_transparent`, e.g. to look
+     * a customer up by a `std::string_view` of the name.
+     *
+     * @param key_ The key to look up.
+     * @return Pointers to the first value and past the last one (equal if the key is absent).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class K, class>
+    std::pair<const DataType*, const DataType*>
+    MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::equal_range(const K &key_) const
+    {
+        const auto *group = m_table.find(key_);
+        if (group == nullptr)
+            return { nullptr, nullptr };
+        return { group->data(), group->data() + group->size() };
+    }
+
+    /*!
+     * @brief Counts the values of a key.
+     *
+     * @param key_ The key to count.
+     * @return The number of values of the key (0 if it is absent).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    typename MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size_type
+    MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::count(const KeyType &key_) const
+    {
+        const auto *group = m_table.find(key_);
+        return group != nullptr ? group->size() : 0;
+    }
+
+    /*!
+     * @brief count() for a key given as any type the hash and equality accept.
+     *
+     * @param key_ The key to count.
+     * @return The number of values of the key (0 if it is absent).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class K, class>
+    typename MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size_type
+    MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::count(const K &key_) const
+    {
+        const auto *group = m_table.find(key_);
+        return group != nullptr ? group->size() : 0;
+    }
+
+    /*!
+     * @brief Checks whether a key has any value.
+     *
+     * @param key_ The key to look up.
+     * @return true if the key is in the table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::contains(const KeyType &key_) const
+    {
+        return m_table.contains(key_);
+    }
+
+    /*!
+     * @brief Removes a key with all its values.
+     *
+     * @param key_ The key to remove.
+     * @return The number of values removed.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    typename MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size_type
+    MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::erase(const KeyType &key_)
+    {
+        auto removed = count(key_);
+        if (removed > 0) {
+            m_table.erase(key_);
+            m_count -= removed;
+        }
+        return removed;
+    }
+
+    /*!
+     * @brief Removes the values of a key for which `pred_(value)` is true.
+     *
+     * The other values keep their order; a key left without values is removed.
+     *
+     * @param key_ The key whose values are filtered.
+     * @param pred_ Predicate called once per value of the key.
+     * @return The number of values removed.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class Predicate>
+    typename MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size_type
+    MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::erase_if(const KeyType &key_, Predicate pred_)
+    {
+        auto *group = m_table.find(key_);
+        if (group == nullptr)
+            return 0;
+        auto kept = std::remove_if(group->begin(), group->end(), pred_);
+        size_type removed = static_cast<size_type>(group->end() - kept);
+        group->erase(kept, group->end());
+        if (group->empty())
+            m_table.erase(key_);
+        m_count -= removed;
+        return removed;
+    }
+
+    /*!
+     * @brief Removes every key and value.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::clear()
+    {
+        m_table.clear();
+        m_count = 0;
+    }
+
+    /*!
+     * @brief Calls `fn_(key, value)` for every value; the values of a key come one after another.
+     *
+     * @param fn_ Function called once per value; it must not modify the table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    template <class Function>
+    void MultiHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::for_each(Function &&fn_) const
+    {
+        m_table.for_each([&fn_](const KeyType &key, const group_type &group) {
+            for (const auto &value : group)
+                fn_(key, value);
+        });
+    }
+
+} // namespace ac
@@ -0,0 +1,186 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>   // std::size_t, std::max_align_t
+#include <cstdint>   // std::uintptr_t
+#include <new>       // ::operator new, std::bad_alloc
+#include <algorithm> // std::max
+#include <type_traits>
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Monotonic arena with free lists for small fixed-size blocks.
+     *
+     * Memory is carved out of large blocks with a bump pointer. Small chunks
+     * (up to MAX_SMALL bytes, e.g. the list nodes of a HashTbl) go back to a per-size
+     * free list on deallocation and are reused by the next allocation of the same
+     * size, so a table with steady insert/erase traffic stops calling `malloc`.
+     * Larger chunks (bucket arrays) are only reclaimed by release().
+     *
+     * release(), also called by the destructor, frees every block at once without
+     * visiting individual nodes. Sizing the first block for the whole job (see the
+     * constructor) makes that a single `free`.
+     *
+     * The pool is not thread-safe, just like HashTbl itself.
+     */
+    class NodePool {
+        public:
+            /*!
+             * @brief Creates an empty pool.
+             *
+             * @param first_block_ Size in bytes of the first block. Later blocks double in size.
+             */
+            explicit NodePool( std::size_t first_block_ = 64 * 1024 )
+                : m_next_block{ std::max<std::size_t>(first_block_, 1024) }
+            {/*Empty*/}
+
+            NodePool( const NodePool& ) = delete;
+            NodePool& operator=( const NodePool& ) = delete;
+
+            ~NodePool() { release(); }
+
+            /*!
+             * @brief Allocates `bytes_` bytes aligned to at least `align_`.
+             *
+             * @throws std::bad_alloc if the system is out of memory.
+             */
+            void* allocate( std::size_t bytes_, std::size_t align_ = alignof(std::max_align_t) )
+            {
+                bytes_ = round_up(bytes_, GRANULE);
+                if (bytes_ <= MAX_SMALL && align_ <= GRANULE) {
+                    auto &head = m_free[bytes_ / GRANULE - 1];
+                    if (head != nullptr) {
+                        auto *chunk = head;
+                        head = head->next;
+                        return chunk;
+                    }
+                }
+                return bump(bytes_, std::max(align_, GRANULE));
+            }
+
+            /*!
+             * @brief Gives back a chunk obtained from allocate() with the same size.
+             *
+             * Small chunks are kept for reuse, larger ones wait for release().
+             */
+            void deallocate( void *ptr_, std::size_t bytes_ ) noexcept
+            {
+                bytes_ = round_up(bytes_, GRANULE);
+                if (ptr_ == nullptr || bytes_ > MAX_SMALL)
+                    return;
+                auto *chunk = static_cast<FreeChunk*>(ptr_);
+                auto &head = m_free[bytes_ / GRANULE - 1];
+                chunk->next = head;
+                head = chunk;
+            }
+
+            /*!
+             * @brief Frees every block. All memory handed out by the pool becomes invalid.
+             */
+            void release() noexcept
+            {
+                while (m_blocks != nullptr) {
+                    auto *next = m_blocks->next;
+                    ::operator delete(m_blocks);
+                    m_blocks = next;
+                }
+                for (auto &head : m_free)
+                    head = nullptr;
+                m_cursor = m_end = nullptr;
+                m_reserved = 0;
+            }
+
+            /// Total bytes obtained from the system (headers included).
+            std::size_t bytes_reserved() const { return m_reserved; }
+
+        private:
+            struct Block { Block *next; };
+            struct FreeChunk { FreeChunk *next; };
+
+            static constexpr std::size_t GRANULE = alignof(std::max_align_t);
+            static constexpr std::size_t MAX_SMALL = 256;
+            static constexpr std::size_t HEADER = (sizeof(Block) + GRANULE - 1) / GRANULE * GRANULE;
+
+            static std::size_t round_up( std::size_t n_, std::size_t to_ ) { return (n_ + to_ - 1) / to_ * to_; }
+
+            void* bump( std::size_t bytes_, std::size_t align_ )
+            {
+                auto aligned = round_up(reinterpret_cast<std::uintptr_t>(m_cursor), align_);
+                if (m_cursor == nullptr || aligned + bytes_ > reinterpret_cast<std::uintptr_t>(m_end)) {
+                    new_block(bytes_ + align_);
+                    aligned = round_up(reinterpret_cast<std::uintptr_t>(m_cursor), align_);
+                }
+                m_cursor = reinterpret_cast<char*>(aligned + bytes_);
+                return reinterpret_cast<void*>(aligned);
+            }
+
+            void new_block( std::size_t min_bytes_ )
+            {
+                auto size = std::max(m_next_block, HEADER + min_bytes_);
+                auto *block = static_cast<Block*>(::operator new(size));
+                block->next = m_blocks;
+                m_blocks = block;
+                m_cursor = reinterpret_cast<char*>(block) + HEADER;
+                m_end = reinterpret_cast<char*>(block) + size;
+                m_reserved += size;
+                if (m_next_block < MAX_BLOCK)
+                    m_next_block *= 2;
+            }
+
+            static constexpr std::size_t MAX_BLOCK = std::size_t{64} << 20;
+
+            Block *m_blocks{nullptr};         //!< Every block obtained so far (most recent first).
+            char *m_cursor{nullptr};          //!< Next free byte of the current block.
+            char *m_end{nullptr};             //!< End of the current block.
+            std::size_t m_next_block;         //!< Size of the next block to obtain.
+            std::size_t m_reserved{0};        //!< Bytes obtained from the system.
+            FreeChunk *m_free[MAX_SMALL / GRANULE]{}; //!< One free list per small size.
+    };
+
+    /*!
+     * @brief Standard allocator that draws from a NodePool.
+     *
+     * Suitable as the `Allocator` argument of HashTbl:
+     *
+     *     ac::NodePool pool;
+     *     ac::HashTbl<int, int, std::hash<int>, std::equal_to<int>, ac::prime_index_policy,
+     *                 ac::PoolAllocator<ac::HashEntry<int, int>>> table( 11, pool );
+     *
+     * The allocator only refers to the pool, which must outlive every container using it.
+     */
+    template <class T>
+    class PoolAllocator {
+        public:
+            using value_type = T;
+            using propagate_on_container_copy_assignment = std::true_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+
+            PoolAllocator( NodePool &pool_ ) noexcept : m_pool{&pool_} {}
+
+            template <class U>
+            PoolAllocator( const PoolAllocator<U> &other_ ) noexcept : m_pool{other_.pool()} {}
+
+            T* allocate( std::size_t n_ )
+            {
+                return static_cast<T*>(m_pool->allocate(n_ * sizeof(T), alignof(T)));
+            }
+
+            void deallocate( T *ptr_, std::size_t n_ ) noexcept { m_pool->deallocate(ptr_, n_ * sizeof(T)); }
+
+            NodePool* pool() const noexcept { return m_pool; }
+
+            template <class U>
+            bool operator==( const PoolAllocator<U> &other_ ) const noexcept { return m_pool == other_.pool(); }
+            template <class U>
+            bool operator!=( const PoolAllocator<U> &other_ ) const noexcept { return m_pool != other_.pool(); }
+
+        private:
+            NodePool *m_pool; //!< The pool memory comes from (not owned).
+    };
+
+} // namespace ac
+#endif
@@ -0,0 +1,226 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef PARALLEL_HASHTBL_H
+#define PARALLEL_HASHTBL_H
+
+#include <algorithm>   // std::max, std::find_if
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <iterator>    // std::distance, std::next, std::iterator_traits
+#include <memory>      // std::allocator
+#include <type_traits> // std::true_type, std::false_type
+#include <utility>     // std::pair
+#include <vector>
+
+#include "hashtbl.h"
+#include "thread_pool.h" // ThreadPool
+
+/*!
+ * @file parallel_hashtbl.h
+ * @brief Building and rehashing a HashTbl on a ThreadPool (opt-in: hashtbl.h does not include it).
+ *
+ * Both give exactly the table the serial path gives, down to the order of the entries in each
+ * bucket. The work is split by ranges of source elements (or old buckets) and by parts of the
+ * new bucket array: first each task sorts its range by destination part, keeping the serial
+ * order; then each task owns a part and takes the sorted elements of every range in turn, so
+ * each bucket receives its entries in the serial order and only one task touches it.
+ */
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Whether several threads may allocate from an `Allocator` at once.
+     *
+     * parallel_build() allocates entries from every task, so it only accepts allocators known to
+     * allow it: std::allocator. Specialize it for a thread-safe allocator of your own:
+     *
+     *     template <class T> struct ac::concurrent_allocator<MyAllocator<T>> : std::true_type {};
+     *
+     * PoolAllocator must not be: its NodePool is not synchronized.
+     */
+    template <class Allocator>
+    struct concurrent_allocator : std::false_type {};
+    template <class T>
+    struct concurrent_allocator<std::allocator<T>> : std::true_type {};
+
+    namespace detail {
+        /// The HashTbl internals the parallel operations work on (HashTbl befriends it).
+        struct parallel_access {
+            using size_type = std::size_t;
+
+            /// A few parts per thread, so that a part with long chains does not hold the others up.
+            static size_type parts( const ThreadPool &pool_ ) { return pool_.size() == 1 ? 1 : 4 * pool_.size(); }
+
+            template <class K, class D, class H, class E, class P, class A, class ForwardIt>
+            static void build( HashTbl<K, D, H, E, P, A> &table_, ForwardIt first_, ForwardIt last_, ThreadPool &pool_, size_type sz_ )
+            {
+                using table_type = HashTbl<K, D, H, E, P, A>;
+                using node_type = typename table_type::node_type;
+
+                // Buckets for all the elements at once, as the serial range constructor sizes them
+                const auto n = static_cast<size_type>(std::distance(first_, last_));
+                P policy{table_.m_policy};
+                const auto size = policy.reset(std::max(sz_, table_.buckets_for(n)));
+                auto *buckets = table_.allocate_buckets(size);
+                table_.free_buckets(table_.m_table, table_.m_size);
+                table_.m_table = buckets;
+                table_.m_size = size;
+                table_.m_policy = policy;
+
+                const size_type parts = parallel_access::parts(pool_);
+                std::vector<ForwardIt> starts{first_};
+                for (size_type c{1}; c <= parts; ++c)
+                    starts.push_back(std::next(starts.back(), static_cast<std::ptrdiff_t>(n * c / parts - n * (c - 1) / parts)));
+
+                // Hash each chunk, grouping its elements by destination part, in range order
+                std::vector<std::vector<std::pair<ForwardIt, std::size_t>>> staged(parts * parts);
+                pool_.parallel_for(parts, [&](size_type c) {
+                    for (auto it = starts[c]; it != starts[c + 1]; ++it) {
+                        auto hash = H()(element_key(*it));
+                        staged[c * parts + table_.m_policy.index(hash) * parts / table_.m_size].emplace_back(it, hash);
+                    }
+                });
+
+                // Fill each part from every chunk in turn, as the serial insertions would
+                std::vector<size_type> counts(parts);
+                pool_.parallel_for(parts, [&](size_type p) {
+                    for (size_type c{0}; c < parts; ++c) {
+                        for (const auto &staged_element : staged[c * parts + p]) {
+                            const auto &it = staged_element.first;
+                            const auto hash = staged_element.second;
+                            const auto &key = element_key(*it);
+                            auto &list = table_.m_table[table_.m_policy.index(hash)];
+                            auto entry = std::find_if(list.begin(), list.end(),
+                                                      [&](const node_type &e) { return table_type::key_matches(e, hash, key); });
+                            if (entry != list.end()) {
+                                entry->m_data = element_data(*it);
+                                continue;
+                            }
+                            list.emplace_front(key, element_data(*it));
+                            list.front().store_hash(hash);
+                            ++counts[p];
+                        }
+                    }
+                });
+                for (auto count : counts)
+                    table_.m_count += count;
+            }
+
+            /// Moves every old bucket not migrated yet to the current array; nodes are relinked, never allocated.
+            template <class K, class D, class H, class E, class P, class A>
+            static void migrate( HashTbl<K, D, H, E, P, A> &table_, ThreadPool &pool_ )
+            {
+                using list_type = typename HashTbl<K, D, H, E, P, A>::list_type;
+
+                const size_type parts = parallel_access::parts(pool_);
+                if (parts == 1) {
+                    table_.migrate(table_.m_old_size); // Two passes on one thread would only be slower.
+                    return;
+                }
+
+                RehashTimer<AC_HASHTBL_STATS != 0> timer(table_.m_counters);
+                const size_type first = table_.m_migrated, remaining = table_.m_old_size - table_.m_migrated;
+
+                std::vector<list_type> staged;
+                staged.reserve(parts * parts);
+                for (size_type i{0}; i < parts * parts; ++i)
+                    staged.emplace_back(table_.m_alloc);
+
+                pool_.parallel_for(parts, [&](size_type c) {
+                    std::vector<typename list_type::iterator> tails;
+                    for (size_type p{0}; p < parts; ++p)
+                        tails.push_back(staged[c * parts + p].before_begin());
+                    for (auto b = first + remaining * c / parts; b < first + remaining * (c + 1) / parts; ++b) {
+                        auto &old_list = table_.m_old_table[b];
+                        while (!old_list.empty()) {
+                            auto p = table_.m_policy.index(table_.hash_of(old_list.front())) * parts / table_.m_size;
+                            staged[c * parts + p].splice_after(tails[p], old_list, old_list.before_begin());
+                            ++tails[p];
+                        }
+                    }
+                });
+
+                pool_.parallel_for(parts, [&](size_type p) {
+                    for (size_type c{0}; c < parts; ++c) {
+                        auto &list = staged[c * parts + p];
+                        while (!list.empty()) {
+                            auto &new_list = table_.m_table[table_.m_policy.index(table_.hash_of(list.front()))];
+                            new_list.splice_after(new_list.before_begin(), list, list.before_begin());
+                        }
+                    }
+                });
+
+                table_.m_migrated = table_.m_old_size;
+                table_.free_buckets(table_.m_old_table, table_.m_old_size);
+                table_.m_old_table = nullptr;
+            }
+
+            template <class K, class D, class H, class E, class P, class A>
+            static void rehash( HashTbl<K, D, H, E, P, A> &table_, size_type n_, ThreadPool &pool_ )
+            {
+                table_.begin_rehash(std::max(n_, table_.buckets_for(table_.m_count)));
+                migrate(table_, pool_);
+            }
+        };
+    } // namespace detail
+
+    /*!
+     * @brief Builds a table from `[first, last)` on a thread pool.
+     *
+     * Same table as `Table(first, last, sz, alloc)`, bit for bit. Entries are allocated from
+     * every task, so the allocator must be a concurrent_allocator.
+     *
+     * @param first Iterator to the first element (entry or pair; at least a forward iterator).
+     * @param last Iterator past the last element.
+     * @param pool Threads to build with (not one of its tasks calling).
+     * @param sz Minimum number of buckets.
+     * @param alloc Allocator for the bucket array and the entry nodes.
+     * @return The table.
+     */
+    template <class Table, class ForwardIt, class = detail::if_iterator<ForwardIt>>
+    Table parallel_build( ForwardIt first, ForwardIt last, ThreadPool &pool, std::size_t sz = 0,
+                          const typename Table::allocator_type &alloc = typename Table::allocator_type() )
+    {
+        static_assert(std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<ForwardIt>::iterator_category>,
+                      "parallel_build needs forward iterators");
+        static_assert(concurrent_allocator<typename Table::allocator_type>::value,
+                      "parallel_build allocates from several threads: specialize ac::concurrent_allocator "
+                      "for this allocator if it is thread-safe");
+        Table table(1, alloc);
+        detail::parallel_access::build(table, first, last, pool, sz);
+        return table;
+    }
+
+    /*!
+     * @brief Builds a table from a whole range on a thread pool (see the iterator-pair overload).
+     *
+     * @param range Container (or any type with forward iterators) of entries or pairs.
+     * @param pool Threads to build with.
+     * @param sz Minimum number of buckets.
+     * @param alloc Allocator for the bucket array and the entry nodes.
+     * @return The table.
+     */
+    template <class Table, class Range>
+    Table parallel_build( Range &&range, ThreadPool &pool, std::size_t sz = 0,
+                          const typename Table::allocator_type &alloc = typename Table::allocator_type() )
+    {
+        return parallel_build<Table>(std::begin(range), std::end(range), pool, sz, alloc);
+    }
+
+    /*!
+     * @brief Rebuilds a table with at least `n` buckets, moving the entries on a thread pool.
+     *
+     * Same result as `table.rehash(n)`, bit for bit, and like it finishes a pending incremental
+     * rehash first. Nodes are only relinked, so any allocator is fine.
+     *
+     * @param table The table.
+     * @param n Minimum number of buckets.
+     * @param pool Threads to move the entries with (not one of its tasks calling).
+     */
+    template <class K, class D, class H, class E, class P, class A>
+    void parallel_rehash( HashTbl<K, D, H, E, P, A> &table, std::size_t n, ThreadPool &pool )
+    {
+        detail::parallel_access::rehash(table, n, pool);
+    }
+
+} // namespace ac
+#endif
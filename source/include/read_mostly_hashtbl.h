@@ -0,0 +1,104 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef READ_MOSTLY_HASHTBL_H
+#define READ_MOSTLY_HASHTBL_H
+
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t
+#include <functional>   // std::hash, std::equal_to
+#include <memory>       // std::unique_ptr
+#include <mutex>        // std::mutex, std::lock_guard
+#include <stdexcept>    // std::out_of_range
+
+#include "epoch.h"       // EpochDomain, RetireList
+#include "hash_policy.h" // prime_index_policy
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Concurrent hash table whose lookups never lock, for read-mostly workloads.
+     *
+     * Chains are singly linked lists of immutable nodes reached through atomic pointers.
+     * Readers only load those pointers inside an EpochDomain::Guard: they take no lock and
+     * write nothing but their own epoch slot. Writers are serialized by one mutex and publish
+     * every change with a single atomic pointer store:
+     * - an insertion links a new node at the head of its chain;
+     * - replacing data links a copy of the node in place of the old one;
+     * - an erase unlinks the node;
+     * - a rehash builds a complete new bucket array, with copies of every node, and swaps it in.
+     * Whatever a store replaces is retired and freed once no reader can still see it.
+     *
+     * Since data may be freed as soon as a reader leaves, lookups return copies (`at()`
+     * returns by value) and there is no operator[].
+     */
+	template< class KeyType,
+		      class DataType,
+		      class KeyHash = std::hash< KeyType >,
+		      class KeyEqual = std::equal_to< KeyType >,
+		      class IndexPolicy = prime_index_policy >
+	class ReadMostlyHashTbl {
+        public:
+            // Aliases
+            using size_type = std::size_t;
+
+            explicit ReadMostlyHashTbl( size_type table_sz_ = DEFAULT_SIZE );
+            ReadMostlyHashTbl( const ReadMostlyHashTbl& ) = delete;
+            ReadMostlyHashTbl& operator=( const ReadMostlyHashTbl& ) = delete;
+
+            virtual ~ReadMostlyHashTbl();
+
+            bool insert( const KeyType &, const DataType & );
+            bool erase( const KeyType & );
+            void clear();
+
+            bool retrieve( const KeyType &, DataType & ) const;
+            bool contains( const KeyType & ) const;
+            DataType at( const KeyType & ) const;
+            size_type count( const KeyType & ) const;
+
+            inline size_type size() const { return m_count.load(std::memory_order_relaxed); };
+            inline bool empty() const { return size() == 0; };
+            size_type bucket_count() const;
+            float max_load_factor() const;
+            void max_load_factor( float mlf );
+            size_type pending_reclaim();
+
+        private:
+            /// Immutable once published, except for the link to the next node.
+            struct Node {
+                KeyType m_key;
+                DataType m_data;
+                std::size_t m_hash;
+                std::atomic<Node*> m_next;
+
+                Node( const KeyType &k_, const DataType &d_, std::size_t h_, Node *next_ )
+                    : m_key{k_}, m_data{d_}, m_hash{h_}, m_next{next_} {}
+            };
+
+            /// A bucket array and the policy that indexes it, published as one pointer.
+            struct Buckets {
+                IndexPolicy m_policy;
+                size_type m_size;
+                std::unique_ptr<std::atomic<Node*>[]> m_heads;
+
+                explicit Buckets( size_type sz_ );
+                ~Buckets();
+                std::atomic<Node*>& head( std::size_t hash_ ) { return m_heads[m_policy.index(hash_)]; }
+            };
+
+            const Node* find_node( const KeyType &, std::size_t ) const;
+            void rehash( void );
+
+        private:
+            std::atomic<Buckets*> m_buckets;    //!< Current bucket array (read by everyone).
+            std::atomic<size_type> m_count{0};  //!< Number of elements.
+            float m_factor_load{1.0f};          //!< Maximum load factor.
+            std::mutex m_write_mutex;           //!< Serializes writers.
+            RetireList m_retired;               //!< Nodes and arrays waiting for the readers to move on.
+
+            static constexpr size_type DEFAULT_SIZE = 11;
+    };
+
+} // namespace ac
+#include "read_mostly_hashtbl.inl"
+#endif
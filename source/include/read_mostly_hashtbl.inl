@@ -0,0 +1,299 @@
+#include "read_mostly_hashtbl.h"
+
+/*!
+ * @file read_mostly_hashtbl.inl
+ * @brief Implementation of the ReadMostlyHashTbl class (lock-free lookups, epoch-based reclamation).
+ *
+ * Authors: Gabriel Victor and Thiago Raquel.
+ */
+
+namespace ac {
+    /*!
+     * @brief Creates an array of empty buckets.
+     *
+     * @param sz Requested number of buckets, rounded up by the index policy.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::Buckets::Buckets(size_type sz)
+    {
+        m_size = m_policy.reset(sz);
+        m_heads.reset(new std::atomic<Node*>[m_size]);
+        for (size_type i{0}; i < m_size; ++i)
+            m_heads[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    /*!
+     * @brief Frees the nodes still linked from the array.
+     *
+     * Nodes unlinked earlier were retired on their own, so every node is freed exactly once.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::Buckets::~Buckets()
+    {
+        for (size_type i{0}; i < m_size; ++i) {
+            auto *node = m_heads[i].load(std::memory_order_relaxed);
+            while (node != nullptr) {
+                auto *next = node->m_next.load(std::memory_order_relaxed);
+                delete node;
+                node = next;
+            }
+        }
+    }
+
+    /*!
+     * @brief Constructor that initializes the table with a specified size.
+     *
+     * @param sz Size of the table, rounded up by the index policy.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::ReadMostlyHashTbl(size_type sz)
+        : m_buckets{new Buckets(sz)}
+    {/*Empty*/}
+
+    /*!
+     * @brief Destructor. No other thread may use the table any more.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::~ReadMostlyHashTbl()
+    {
+        delete m_buckets.load(std::memory_order_relaxed);
+        // m_retired frees the rest.
+    }
+
+    /*!
+     * @brief Walks the chain of a hash in the current bucket array. Call inside an epoch guard.
+     *
+     * @param key_ The key.
+     * @param hash_ Its hash.
+     * @return The node holding the key, or nullptr.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    const typename ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::Node *
+    ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::find_node(const KeyType &key_,
+                                                                                    std::size_t hash_) const
+    {
+        auto *buckets = m_buckets.load(std::memory_order_acquire);
+        for (auto *node = buckets->head(hash_).load(std::memory_order_acquire); node != nullptr;
+             node = node->m_next.load(std::memory_order_acquire))
+            if (node->m_hash == hash_ && KeyEqual()(node->m_key, key_))
+                return node;
+        return nullptr;
+    }
+
+    /*!
+     * @brief Retrieves a copy of the data associated with a key, without locking.
+     *
+     * @param key_ The key to search for.
+     * @param data_item_ Receives the data.
+     * @return true if the key exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::retrieve(const KeyType &key_,
+                                                                                        DataType &data_item_) const
+    {
+        EpochDomain::Guard guard;
+        auto *node = find_node(key_, KeyHash()(key_));
+        if (node == nullptr)
+            return false;
+        data_item_ = node->m_data;
+        return true;
+    }
+
+    /*!
+     * @brief Checks whether a key is stored, without locking.
+     *
+     * @param key_ The key to search for.
+     * @return true if the key exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::contains(const KeyType &key_) const
+    {
+        EpochDomain::Guard guard;
+        return find_node(key_, KeyHash()(key_)) != nullptr;
+    }
+
+    /*!
+     * @brief Returns a copy of the data associated with a key, without locking.
+     *
+     * @param key_ The key to search for.
+     * @return The data.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    DataType ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::at(const KeyType &key_) const
+    {
+        EpochDomain::Guard guard;
+        auto *node = find_node(key_, KeyHash()(key_));
+        if (node == nullptr)
+            throw std::out_of_range("Key not found");
+        return node->m_data;
+    }
+
+    /*!
+     * @brief Returns the number of elements with the key (0 or 1), without locking.
+     *
+     * @param key_ The key to count.
+     * @return 1 if the key exists, 0 otherwise.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    typename ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size_type
+    ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::count(const KeyType &key_) const
+    {
+        return contains(key_) ? 1 : 0;
+    }
+
+    /*!
+     * @brief Inserts a key-value pair, replacing the data if the key already exists.
+     *
+     * A replaced entry is swapped for a new node, so readers see either the old or the new
+     * data, never a partly written one.
+     *
+     * @param key_ The key to be inserted.
+     * @param data_item_ The data associated with the key.
+     * @return true if the key was new, false if its data was replaced.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::insert(const KeyType &key_,
+                                                                                      const DataType &data_item_)
+    {
+        std::lock_guard lock(m_write_mutex);
+        auto hash = KeyHash()(key_);
+        auto &head = m_buckets.load(std::memory_order_relaxed)->head(hash);
+
+        // Writers are serialized, so the chain can be walked with relaxed loads.
+        for (auto *link = &head; auto *node = link->load(std::memory_order_relaxed);
+             link = &node->m_next) {
+            if (node->m_hash == hash && KeyEqual()(node->m_key, key_)) {
+                auto *copy = new Node(key_, data_item_, hash, node->m_next.load(std::memory_order_relaxed));
+                link->store(copy, std::memory_order_release);
+                m_retired.retire(node);
+                return false;
+            }
+        }
+
+        head.store(new Node(key_, data_item_, hash, head.load(std::memory_order_relaxed)), std::memory_order_release);
+        auto count = m_count.load(std::memory_order_relaxed) + 1;
+        m_count.store(count, std::memory_order_relaxed);
+
+        if (static_cast<float>(count) / m_buckets.load(std::memory_order_relaxed)->m_size > m_factor_load)
+            rehash();
+        return true;
+    }
+
+    /*!
+     * @brief Removes a key and its data.
+     *
+     * @param key_ The key to remove.
+     * @return true if the key was found and removed.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    bool ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::erase(const KeyType &key_)
+    {
+        std::lock_guard lock(m_write_mutex);
+        auto hash = KeyHash()(key_);
+        auto &head = m_buckets.load(std::memory_order_relaxed)->head(hash);
+
+        for (auto *link = &head; auto *node = link->load(std::memory_order_relaxed);
+             link = &node->m_next) {
+            if (node->m_hash == hash && KeyEqual()(node->m_key, key_)) {
+                // Readers standing on `node` still follow its (unchanged) next link.
+                link->store(node->m_next.load(std::memory_order_relaxed), std::memory_order_release);
+                m_retired.retire(node);
+                m_count.store(m_count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*!
+     * @brief Removes every element by publishing an empty bucket array of the same size.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::clear()
+    {
+        std::lock_guard lock(m_write_mutex);
+        auto *old = m_buckets.load(std::memory_order_relaxed);
+        m_buckets.store(new Buckets(old->m_size), std::memory_order_release);
+        m_retired.retire(old);
+        m_count.store(0, std::memory_order_relaxed);
+    }
+
+    /*!
+     * @brief Publishes a bucket array twice as large holding copies of every node.
+     *
+     * Nodes cannot be relinked into the new chains in place: a reader walking an old chain
+     * would be diverted into a new one and miss keys. The old array keeps its nodes and is
+     * retired as a whole. Called with the writer lock held.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::rehash(void)
+    {
+        auto *old = m_buckets.load(std::memory_order_relaxed);
+        auto *fresh = new Buckets(old->m_size * 2);
+        for (size_type i{0}; i < old->m_size; ++i) {
+            for (auto *node = old->m_heads[i].load(std::memory_order_relaxed); node != nullptr;
+                 node = node->m_next.load(std::memory_order_relaxed)) {
+                auto &head = fresh->head(node->m_hash);
+                head.store(new Node(node->m_key, node->m_data, node->m_hash, head.load(std::memory_order_relaxed)),
+                           std::memory_order_relaxed);
+            }
+        }
+        // The release store publishes the whole new array at once.
+        m_buckets.store(fresh, std::memory_order_release);
+        m_retired.retire(old);
+    }
+
+    /*!
+     * @brief Returns the current number of buckets.
+     *
+     * @return The bucket count.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    typename ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size_type
+    ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::bucket_count() const
+    {
+        EpochDomain::Guard guard;
+        return m_buckets.load(std::memory_order_acquire)->m_size;
+    }
+
+    /*!
+     * @brief Get the maximum load factor.
+     *
+     * @return The maximum load factor.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    float ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::max_load_factor() const
+    {
+        return m_factor_load;
+    }
+
+    /*!
+     * @brief Set the maximum load factor, used by the next insertions.
+     *
+     * @param mlf The new maximum load factor.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    void ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::max_load_factor(float mlf)
+    {
+        std::lock_guard lock(m_write_mutex);
+        m_factor_load = mlf;
+    }
+
+    /*!
+     * @brief Frees the retired memory no reader can see any more.
+     *
+     * Writers already do this from time to time; calling it lets an idle table release
+     * memory sooner.
+     *
+     * @return The number of retired objects still waiting.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual, typename IndexPolicy>
+    typename ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::size_type
+    ReadMostlyHashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy>::pending_reclaim()
+    {
+        std::lock_guard lock(m_write_mutex);
+        return m_retired.reclaim();
+    }
+
+} // Namespace ac.
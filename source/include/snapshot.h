@@ -0,0 +1,312 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t, std::uint32_t
+#include <cstdio>       // std::rename, std::remove
+#include <cstring>      // std::memcpy, std::memcmp
+#include <fstream>
+#include <functional>   // std::hash
+#include <memory>       // std::unique_ptr
+#include <stdexcept>    // std::runtime_error, std::out_of_range
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>      // std::index_sequence
+#include <vector>
+
+// Snapshots are mapped with mmap where POSIX provides it, and read into memory elsewhere.
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, munmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+#define AC_SNAPSHOT_MMAP 1
+#endif
+
+#include "hashtbl.h"
+#include "hash_policy.h" // hash_mix
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief How a key or data type is stored in a snapshot file.
+     *
+     * Each value takes a fixed-size slot in its record; variable-length bytes (string
+     * characters) go to the file's blob and the slot keeps their offset, so the file holds no
+     * pointer and can be mapped at any address. A codec provides:
+     * - `slot_size`: bytes of the slot;
+     * - `tag`: identifies the type, stored in the file header so that a file is never read
+     *   with other types than it was written with;
+     * - `write(value, slot, blob)`: fills the slot, appending to the blob if needed;
+     * - `view(slot, blob)`: a cheap value comparable with `==` to the type, used for lookups
+     *   (e.g. a `std::string_view` into the mapped blob for a `std::string`);
+     * - `read(slot, blob)`: the stored value.
+     *
+     * Codecs exist for arithmetic and enum types, `std::string`, `std::string_view` and tuples
+     * of those; specialize `snapshot_codec<T>` for other types. A trivially copyable struct
+     * known to hold no pointer is stored byte for byte once `snapshot_trivial<T>` is
+     * specialized to true. Other types, in particular those holding pointers (which would be
+     * written as addresses meaningless in any other process), do not compile.
+     */
+    template <class T, class = void>
+    struct snapshot_codec {
+        static_assert(sizeof(T) == 0, "no snapshot_codec for this type: specialize ac::snapshot_codec, "
+                                      "or ac::snapshot_trivial if it is trivially copyable and holds no pointer");
+    };
+
+    /// Types a snapshot stores byte for byte: arithmetic and enum types, plus those specialized to true.
+    template <class T>
+    struct snapshot_trivial : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T>> {};
+
+    template <class T>
+    struct snapshot_codec<T, std::enable_if_t<snapshot_trivial<T>::value>> {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot_trivial types are copied with memcpy");
+
+        using view_type = T;
+        static constexpr std::size_t slot_size = sizeof(T);
+        static constexpr std::uint64_t tag = (std::uint64_t{sizeof(T)} << 8) | (std::is_floating_point_v<T> << 2)
+                                             | (std::is_signed_v<T> << 1) | std::is_integral_v<T>;
+
+        static void write( const T &v_, unsigned char *slot_, std::string & ) { std::memcpy(slot_, &v_, sizeof(T)); }
+        static view_type view( const unsigned char *slot_, const char * )
+        {
+            T v;
+            std::memcpy(&v, slot_, sizeof(T));
+            return v;
+        }
+        static T read( const unsigned char *slot_, const char *blob_ ) { return view(slot_, blob_); }
+    };
+
+    template <>
+    struct snapshot_codec<std::string> {
+        using view_type = std::string_view;
+        static constexpr std::size_t slot_size = 2 * sizeof(std::uint64_t); // Blob offset and length.
+        static constexpr std::uint64_t tag = 0x5354; // "ST"
+
+        static void write( const std::string &v_, unsigned char *slot_, std::string &blob_ )
+        {
+            const std::uint64_t where[2] = { blob_.size(), v_.size() };
+            std::memcpy(slot_, where, slot_size);
+            blob_ += v_;
+        }
+        static view_type view( const unsigned char *slot_, const char *blob_ )
+        {
+            std::uint64_t where[2];
+            std::memcpy(where, slot_, slot_size);
+            return { blob_ + where[0], static_cast<std::size_t>(where[1]) };
+        }
+        static std::string read( const unsigned char *slot_, const char *blob_ ) { return std::string(view(slot_, blob_)); }
+    };
+
+    /// Stored like `std::string`, bytes in the blob; what read() returns points into the mapping.
+    template <>
+    struct snapshot_codec<std::string_view> {
+        using view_type = std::string_view;
+        static constexpr std::size_t slot_size = snapshot_codec<std::string>::slot_size;
+        static constexpr std::uint64_t tag = 0x5356; // "SV"
+
+        static void write( std::string_view v_, unsigned char *slot_, std::string &blob_ )
+        {
+            const std::uint64_t where[2] = { blob_.size(), v_.size() };
+            std::memcpy(slot_, where, slot_size);
+            blob_ += v_;
+        }
+        static view_type view( const unsigned char *slot_, const char *blob_ )
+        {
+            return snapshot_codec<std::string>::view(slot_, blob_);
+        }
+        static std::string_view read( const unsigned char *slot_, const char *blob_ ) { return view(slot_, blob_); }
+    };
+
+    /// Tuples: the slots of the elements, one after the other.
+    template <class... Ts>
+    struct snapshot_codec<std::tuple<Ts...>> {
+        using view_type = std::tuple<typename snapshot_codec<Ts>::view_type...>;
+        static constexpr std::size_t slot_size = (snapshot_codec<Ts>::slot_size + ... + 0);
+        static constexpr std::uint64_t tag = [] {
+            std::uint64_t t{0x5455}; // "TU"
+            ((t = t * 31 + snapshot_codec<Ts>::tag), ...);
+            return t;
+        }();
+
+        static void write( const std::tuple<Ts...> &v_, unsigned char *slot_, std::string &blob_ )
+        {
+            write_each(v_, slot_, blob_, std::index_sequence_for<Ts...>{});
+        }
+        static view_type view( const unsigned char *slot_, const char *blob_ )
+        {
+            return view_each(slot_, blob_, std::index_sequence_for<Ts...>{});
+        }
+        static std::tuple<Ts...> read( const unsigned char *slot_, const char *blob_ )
+        {
+            return read_each(slot_, blob_, std::index_sequence_for<Ts...>{});
+        }
+
+    private:
+        /// Offset of element I in the slot.
+        template <std::size_t I>
+        static constexpr std::size_t offset()
+        {
+            constexpr std::size_t sizes[] = { snapshot_codec<Ts>::slot_size..., 0 };
+            std::size_t sum{0};
+            for (std::size_t i{0}; i < I; ++i)
+                sum += sizes[i];
+            return sum;
+        }
+        template <std::size_t... I>
+        static void write_each( const std::tuple<Ts...> &v_, unsigned char *slot_, std::string &blob_,
+                                std::index_sequence<I...> )
+        {
+            (snapshot_codec<Ts>::write(std::get<I>(v_), slot_ + offset<I>(), blob_), ...);
+        }
+        template <std::size_t... I>
+        static view_type view_each( const unsigned char *slot_, const char *blob_, std::index_sequence<I...> )
+        {
+            return view_type{ snapshot_codec<Ts>::view(slot_ + offset<I>(), blob_)... };
+        }
+        template <std::size_t... I>
+        static std::tuple<Ts...> read_each( const unsigned char *slot_, const char *blob_, std::index_sequence<I...> )
+        {
+            return std::tuple<Ts...>{ snapshot_codec<Ts>::read(slot_ + offset<I>(), blob_)... };
+        }
+    };
+
+    namespace detail {
+        /*!
+         * @brief Header at offset 0 of a snapshot file.
+         *
+         * The file is laid out as: this header; `bucket_count + 1` 64-bit indices, bucket `b`
+         * holding records `[start[b], start[b + 1])`; the records; the blob. A record is the key's
+         * full hash (64 bits), the key slot and the data slot, padded to 8 bytes. Every field is
+         * in the writer's byte order, recorded by `m_endian`.
+         */
+        struct SnapshotHeader {
+            char m_magic[8];               //!< SNAPSHOT_MAGIC.
+            std::uint32_t m_version;       //!< SNAPSHOT_VERSION.
+            std::uint32_t m_endian;        //!< SNAPSHOT_ENDIAN as the writer stored it.
+            std::uint64_t m_key_tag;       //!< snapshot_codec<KeyType>::tag.
+            std::uint64_t m_data_tag;      //!< snapshot_codec<DataType>::tag.
+            std::uint64_t m_hash_probe;    //!< KeyHash of a value-initialized key: detects a different hash function.
+            std::uint64_t m_count;         //!< Number of records.
+            std::uint64_t m_bucket_count;  //!< Number of buckets (a power of two).
+            std::uint64_t m_record_size;   //!< Bytes per record.
+            std::uint64_t m_buckets_offset;
+            std::uint64_t m_records_offset;
+            std::uint64_t m_blob_offset;
+            std::uint64_t m_file_size;
+            std::uint64_t m_checksum;      //!< snapshot_checksum() of the bytes after the header.
+        };
+
+        inline constexpr char SNAPSHOT_MAGIC[8] = { 'A', 'C', 'H', 'T', 'S', 'N', 'A', 'P' };
+        inline constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+        inline constexpr std::uint32_t SNAPSHOT_ENDIAN = 0x01020304;
+
+        /// A 64-bit checksum read a word at a time, so that verifying a file costs about as much as reading it.
+        inline std::uint64_t snapshot_checksum( const unsigned char *p_, std::size_t n_ )
+        {
+            std::uint64_t h{0x9E3779B97F4A7C15ull ^ n_};
+            std::size_t i{0};
+            for (; i + 8 <= n_; i += 8) {
+                std::uint64_t w;
+                std::memcpy(&w, p_ + i, 8);
+                h = (h ^ w) * 0xFF51AFD7ED558CCDull;
+                h ^= h >> 32;
+            }
+            for (; i < n_; ++i)
+                h = (h ^ p_[i]) * 0x100000001B3ull;
+            return hash_mix(h);
+        }
+
+        inline std::uint64_t load_u64( const unsigned char *p_ )
+        {
+            std::uint64_t v;
+            std::memcpy(&v, p_, sizeof v);
+            return v;
+        }
+
+        /// Bytes per record for a key and a data type.
+        template <class KeyType, class DataType>
+        constexpr std::size_t snapshot_record_size()
+        {
+            auto raw = sizeof(std::uint64_t) + snapshot_codec<KeyType>::slot_size + snapshot_codec<DataType>::slot_size;
+            return (raw + 7) / 8 * 8;
+        }
+
+        /// KeyHash of a value-initialized key, or 0 for keys that cannot be value-initialized.
+        template <class KeyType, class KeyHash>
+        std::uint64_t snapshot_hash_probe()
+        {
+            if constexpr (std::is_default_constructible_v<KeyType>)
+                return KeyHash()(KeyType{});
+            else
+                return 0;
+        }
+    } // namespace detail
+
+    template <class KeyType, class DataType, class KeyHash, class KeyEqual, class IndexPolicy, class Allocator>
+    void save_snapshot( const HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator> &,
+                        const std::string & );
+
+    /*!
+     * @brief Read-only hash table served straight from a snapshot file mapped in memory.
+     *
+     * Opening maps the file written by save_snapshot() and checks its header (and, by
+     * default, its checksum); nothing is rebuilt, so opening costs one pass over the file at
+     * most, and lookups then read the mapped pages directly. Keys are compared through their
+     * codec view with `==` (KeyEqual is not used), so `==` must agree with the table's
+     * KeyEqual. KeyHash must be the function the file was written with, and must give the
+     * same values in every process (std::hash does, within one standard library).
+     *
+     * Lookups return copies of the data: the mapped bytes are not a DataType object.
+     */
+    template< class KeyType,
+              class DataType,
+              class KeyHash = std::hash< KeyType > >
+    class MappedHashTbl {
+        public:
+            // Aliases
+            using size_type = std::size_t;
+
+            explicit MappedHashTbl( const std::string &path_, bool verify_ = true );
+            MappedHashTbl( const MappedHashTbl& ) = delete;
+            MappedHashTbl& operator=( const MappedHashTbl& ) = delete;
+            MappedHashTbl( MappedHashTbl && ) noexcept;
+            MappedHashTbl& operator=( MappedHashTbl && ) noexcept;
+
+            virtual ~MappedHashTbl();
+
+            bool retrieve( const KeyType &, DataType & ) const;
+            bool contains( const KeyType & ) const;
+            DataType at( const KeyType & ) const;
+            size_type count( const KeyType & ) const;
+
+            inline size_type size() const { return static_cast<size_type>(m_header.m_count); };
+            inline bool empty() const { return size() == 0; };
+            inline size_type bucket_count() const { return static_cast<size_type>(m_header.m_bucket_count); };
+
+        private:
+            using key_codec = snapshot_codec<KeyType>;
+            using data_codec = snapshot_codec<DataType>;
+
+            void validate( bool );
+            const unsigned char* find_record( const KeyType & ) const;
+            void unmap();
+
+        private:
+            const unsigned char *m_base{nullptr};    //!< First byte of the file contents.
+            std::size_t m_length{0};                 //!< Bytes of the file.
+            bool m_mapped{false};                    //!< Whether m_base is a mapping (otherwise it is m_buffer).
+            std::unique_ptr<unsigned char[]> m_buffer; //!< File contents, where mmap is not available.
+            detail::SnapshotHeader m_header{};       //!< Copy of the file header.
+            const unsigned char *m_buckets{nullptr}; //!< Bucket start indices.
+            const unsigned char *m_records{nullptr}; //!< First record.
+            const char *m_blob{nullptr};             //!< Variable-length bytes.
+    };
+
+} // namespace ac
+#include "snapshot.inl"
+#endif
@@ -0,0 +1,360 @@
+#include "snapshot.h"
+
+/*!
+ * @file snapshot.inl
+ * @brief Implementation of save_snapshot() and of the MappedHashTbl class.
+ *
+ * Authors: Gabriel Victor and Thiago Raquel.
+ */
+
+namespace ac {
+    /*!
+     * @brief Writes the elements of a table to a snapshot file that MappedHashTbl can map.
+     *
+     * The file is written next to `path_` and renamed over it once complete, so a reader never
+     * sees a partial file. Records are grouped by bucket (`hash_mix(hash)` modulo a power of
+     * two at least the element count), so a lookup reads one index pair and one short run of
+     * records.
+     *
+     * @param table_ The table to save.
+     * @param path_ Path of the snapshot file.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    template <class KeyType, class DataType, class KeyHash, class KeyEqual, class IndexPolicy, class Allocator>
+    void save_snapshot(const HashTbl<KeyType, DataType, KeyHash, KeyEqual, IndexPolicy, Allocator> &table_,
+                       const std::string &path_)
+    {
+        using key_codec = snapshot_codec<KeyType>;
+        using data_codec = snapshot_codec<DataType>;
+        constexpr std::size_t record_size = detail::snapshot_record_size<KeyType, DataType>();
+
+        const std::uint64_t count = table_.size();
+        std::uint64_t bucket_count{1};
+        while (bucket_count < count)
+            bucket_count <<= 1;
+        const std::uint64_t mask = bucket_count - 1;
+
+        // Counting sort by bucket: first the bucket sizes, then each element at its place.
+        struct Element { std::uint64_t m_hash; const KeyType *m_key; const DataType *m_data; };
+        std::vector<Element> elements;
+        elements.reserve(count);
+        std::vector<std::uint64_t> start(bucket_count + 1, 0);
+        table_.for_each([&](const KeyType &key, const DataType &data) {
+            std::uint64_t hash = KeyHash()(key);
+            elements.push_back({ hash, &key, &data });
+            ++start[(hash_mix(hash) & mask) + 1];
+        });
+        for (std::uint64_t b{0}; b < bucket_count; ++b)
+            start[b + 1] += start[b];
+
+        std::vector<unsigned char> records(count * record_size, 0);
+        std::string blob;
+        std::vector<std::uint64_t> next(start.begin(), start.end() - 1);
+        for (const auto &e : elements) {
+            auto *record = records.data() + next[hash_mix(e.m_hash) & mask]++ * record_size;
+            std::memcpy(record, &e.m_hash, sizeof e.m_hash);
+            key_codec::write(*e.m_key, record + sizeof e.m_hash, blob);
+            data_codec::write(*e.m_data, record + sizeof e.m_hash + key_codec::slot_size, blob);
+        }
+
+        detail::SnapshotHeader header{};
+        std::memcpy(header.m_magic, detail::SNAPSHOT_MAGIC, sizeof header.m_magic);
+        header.m_version = detail::SNAPSHOT_VERSION;
+        header.m_endian = detail::SNAPSHOT_ENDIAN;
+        header.m_key_tag = key_codec::tag;
+        header.m_data_tag = data_codec::tag;
+        header.m_hash_probe = detail::snapshot_hash_probe<KeyType, KeyHash>();
+        header.m_count = count;
+        header.m_bucket_count = bucket_count;
+        header.m_record_size = record_size;
+        header.m_buckets_offset = sizeof(header);
+        header.m_records_offset = header.m_buckets_offset + start.size() * sizeof(std::uint64_t);
+        header.m_blob_offset = header.m_records_offset + records.size();
+        header.m_file_size = header.m_blob_offset + blob.size();
+
+        // Everything after the header, in file order, for the checksum and the write.
+        std::vector<unsigned char> body(header.m_file_size - sizeof(header));
+        auto *out = body.data();
+        std::memcpy(out, start.data(), start.size() * sizeof(std::uint64_t));
+        out += start.size() * sizeof(std::uint64_t);
+        if (!records.empty())
+            std::memcpy(out, records.data(), records.size());
+        out += records.size();
+        if (!blob.empty())
+            std::memcpy(out, blob.data(), blob.size());
+        header.m_checksum = detail::snapshot_checksum(body.data(), body.size());
+
+        const std::string tmp_path = path_ + ".tmp";
+        {
+            std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+            if (!file)
+                throw std::runtime_error("save_snapshot: cannot write " + tmp_path);
+        }
+        if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+            std::remove(tmp_path.c_str());
+            throw std::runtime_error("save_snapshot: cannot rename " + tmp_path + " to " + path_);
+        }
+    }
+
+    /*!
+     * @brief Maps a snapshot file and checks that it holds a table of these types.
+     *
+     * @param path_ Path of a file written by save_snapshot().
+     * @param verify_ Whether to check the checksum and the bucket index. This reads the whole
+     *                file once (which also brings it into the page cache); without it pages are
+     *                only read when a lookup touches them, and a corrupted file is undefined
+     *                behavior.
+     * @throws std::runtime_error if the file cannot be read, is not a snapshot of these types,
+     *         or fails verification.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    MappedHashTbl<KeyType, DataType, KeyHash>::MappedHashTbl(const std::string &path_, bool verify_)
+    {
+#ifdef AC_SNAPSHOT_MMAP
+        int fd = ::open(path_.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("MappedHashTbl: cannot open " + path_);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("MappedHashTbl: cannot stat " + path_);
+        }
+        m_length = static_cast<std::size_t>(st.st_size);
+        if (m_length >= sizeof(detail::SnapshotHeader)) {
+            void *p = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                m_base = static_cast<const unsigned char*>(p);
+                m_mapped = true;
+            }
+        }
+        ::close(fd); // The mapping keeps the file alive.
+        if (m_length >= sizeof(detail::SnapshotHeader) && !m_mapped)
+            throw std::runtime_error("MappedHashTbl: cannot map " + path_);
+#else
+        std::ifstream file(path_, std::ios::binary | std::ios::ate);
+        if (!file)
+            throw std::runtime_error("MappedHashTbl: cannot open " + path_);
+        m_length = static_cast<std::size_t>(file.tellg());
+        m_buffer.reset(new unsigned char[m_length]);
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(m_buffer.get()), static_cast<std::streamsize>(m_length));
+        if (!file)
+            throw std::runtime_error("MappedHashTbl: cannot read " + path_);
+        m_base = m_buffer.get();
+#endif
+        try {
+            validate(verify_);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    /*!
+     * @brief Move constructor: takes over the mapping.
+     *
+     * @param other The table to move from; left empty (lookups find nothing).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    MappedHashTbl<KeyType, DataType, KeyHash>::MappedHashTbl(MappedHashTbl &&other) noexcept
+        : m_base{other.m_base}, m_length{other.m_length}, m_mapped{other.m_mapped},
+          m_buffer{std::move(other.m_buffer)}, m_header{other.m_header}, m_buckets{other.m_buckets},
+          m_records{other.m_records}, m_blob{other.m_blob}
+    {
+        other.m_base = nullptr;
+        other.m_mapped = false;
+        other.m_header = {};
+        other.m_buckets = other.m_records = nullptr;
+        other.m_blob = nullptr;
+    }
+
+    /*!
+     * @brief Move assignment: releases the current mapping and takes over the other's.
+     *
+     * @param other The table to move from; left empty (lookups find nothing).
+     * @return Reference to this table.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    MappedHashTbl<KeyType, DataType, KeyHash> &
+    MappedHashTbl<KeyType, DataType, KeyHash>::operator=(MappedHashTbl &&other) noexcept
+    {
+        if (this != &other) {
+            unmap();
+            m_base = other.m_base;
+            m_length = other.m_length;
+            m_mapped = other.m_mapped;
+            m_buffer = std::move(other.m_buffer);
+            m_header = other.m_header;
+            m_buckets = other.m_buckets;
+            m_records = other.m_records;
+            m_blob = other.m_blob;
+            other.m_base = nullptr;
+            other.m_mapped = false;
+            other.m_header = {};
+            other.m_buckets = other.m_records = nullptr;
+            other.m_blob = nullptr;
+        }
+        return *this;
+    }
+
+    /*!
+     * @brief Destructor that unmaps the file.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    MappedHashTbl<KeyType, DataType, KeyHash>::~MappedHashTbl()
+    {
+        unmap();
+    }
+
+    /*!
+     * @brief Checks the header against the types and the file size, and optionally the contents.
+     *
+     * @param verify_ Whether to check the checksum and that the bucket index stays in range.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    void MappedHashTbl<KeyType, DataType, KeyHash>::validate(bool verify_)
+    {
+        auto fail = [](const char *what) { throw std::runtime_error(std::string("MappedHashTbl: ") + what); };
+
+        if (m_length < sizeof(m_header))
+            fail("file too small for a snapshot");
+        std::memcpy(&m_header, m_base, sizeof(m_header));
+        if (std::memcmp(m_header.m_magic, detail::SNAPSHOT_MAGIC, sizeof(m_header.m_magic)) != 0)
+            fail("not a snapshot file");
+        if (m_header.m_version != detail::SNAPSHOT_VERSION)
+            fail("unsupported snapshot version");
+        if (m_header.m_endian != detail::SNAPSHOT_ENDIAN)
+            fail("snapshot written with another byte order");
+        if (m_header.m_key_tag != key_codec::tag || m_header.m_data_tag != data_codec::tag
+            || m_header.m_record_size != detail::snapshot_record_size<KeyType, DataType>())
+            fail("snapshot written for other key or data types");
+        if (m_header.m_hash_probe != detail::snapshot_hash_probe<KeyType, KeyHash>())
+            fail("snapshot written with another hash function");
+
+        const auto nb = m_header.m_bucket_count;
+        if (nb == 0 || (nb & (nb - 1)) != 0
+            || m_header.m_file_size != m_length
+            || m_header.m_buckets_offset != sizeof(m_header)
+            || m_header.m_records_offset != m_header.m_buckets_offset + (nb + 1) * sizeof(std::uint64_t)
+            || m_header.m_blob_offset != m_header.m_records_offset + m_header.m_count * m_header.m_record_size
+            || m_header.m_blob_offset > m_length)
+            fail("inconsistent snapshot layout");
+
+        m_buckets = m_base + m_header.m_buckets_offset;
+        m_records = m_base + m_header.m_records_offset;
+        m_blob = reinterpret_cast<const char*>(m_base + m_header.m_blob_offset);
+
+        if (verify_) {
+            if (detail::snapshot_checksum(m_base + sizeof(m_header), m_length - sizeof(m_header)) != m_header.m_checksum)
+                fail("checksum mismatch");
+            std::uint64_t previous{0};
+            for (std::uint64_t b{0}; b <= nb; ++b) {
+                auto s = detail::load_u64(m_buckets + b * sizeof(std::uint64_t));
+                if (s < previous || s > m_header.m_count)
+                    fail("corrupted bucket index");
+                previous = s;
+            }
+            if (previous != m_header.m_count)
+                fail("corrupted bucket index");
+        }
+    }
+
+    /*!
+     * @brief Finds the record of a key in the mapped file.
+     *
+     * @param key_ The key.
+     * @return The record, or nullptr.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    const unsigned char* MappedHashTbl<KeyType, DataType, KeyHash>::find_record(const KeyType &key_) const
+    {
+        if (m_buckets == nullptr)
+            return nullptr; // Moved from.
+        const std::uint64_t hash = KeyHash()(key_);
+        const auto b = hash_mix(hash) & (m_header.m_bucket_count - 1);
+        const auto first = detail::load_u64(m_buckets + b * sizeof(std::uint64_t));
+        const auto last = detail::load_u64(m_buckets + (b + 1) * sizeof(std::uint64_t));
+        for (auto i = first; i < last; ++i) {
+            const auto *record = m_records + i * m_header.m_record_size;
+            if (detail::load_u64(record) == hash && key_codec::view(record + sizeof(hash), m_blob) == key_)
+                return record;
+        }
+        return nullptr;
+    }
+
+    /*!
+     * @brief Retrieves a copy of the data associated with a key.
+     *
+     * @param key_ The key to search for.
+     * @param data_item_ Receives the data.
+     * @return true if the key exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    bool MappedHashTbl<KeyType, DataType, KeyHash>::retrieve(const KeyType &key_, DataType &data_item_) const
+    {
+        const auto *record = find_record(key_);
+        if (record == nullptr)
+            return false;
+        data_item_ = data_codec::read(record + sizeof(std::uint64_t) + key_codec::slot_size, m_blob);
+        return true;
+    }
+
+    /*!
+     * @brief Checks whether a key is stored.
+     *
+     * @param key_ The key to search for.
+     * @return true if the key exists.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    bool MappedHashTbl<KeyType, DataType, KeyHash>::contains(const KeyType &key_) const
+    {
+        return find_record(key_) != nullptr;
+    }
+
+    /*!
+     * @brief Returns a copy of the data associated with a key.
+     *
+     * @param key_ The key to search for.
+     * @return The data.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    DataType MappedHashTbl<KeyType, DataType, KeyHash>::at(const KeyType &key_) const
+    {
+        const auto *record = find_record(key_);
+        if (record == nullptr)
+            throw std::out_of_range("Key not found");
+        return data_codec::read(record + sizeof(std::uint64_t) + key_codec::slot_size, m_blob);
+    }
+
+    /*!
+     * @brief Returns the number of elements with the key (0 or 1).
+     *
+     * @param key_ The key to count.
+     * @return 1 if the key exists, 0 otherwise.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    typename MappedHashTbl<KeyType, DataType, KeyHash>::size_type
+    MappedHashTbl<KeyType, DataType, KeyHash>::count(const KeyType &key_) const
+    {
+        return contains(key_) ? 1 : 0;
+    }
+
+    /*!
+     * @brief Releases the mapping (or the buffer holding the file).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash>
+    void MappedHashTbl<KeyType, DataType, KeyHash>::unmap()
+    {
+#ifdef AC_SNAPSHOT_MMAP
+        if (m_mapped)
+            ::munmap(const_cast<unsigned char*>(m_base), m_length);
+#endif
+        m_mapped = false;
+        m_buffer.reset();
+        m_base = nullptr;
+    }
+
+} // Namespace ac.
@@ -0,0 +1,139 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef STATIC_HASHTBL_H
+#define STATIC_HASHTBL_H
+
+#include <array>            // std::array
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint64_t
+#include <functional>       // std::equal_to
+#include <initializer_list>
+#include <stdexcept>        // std::out_of_range, std::length_error
+#include <string_view>
+#include <type_traits>      // std::enable_if_t, std::is_integral_v, std::is_enum_v
+#include <utility>          // std::pair
+
+#include "hash_policy.h"    // detail::PRIMES
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief Hash usable in constant expressions, the default of StaticHashTbl.
+     *
+     * `std::hash` is not `constexpr`, so a table built at compile time needs its own. Defined
+     * for integral and enum keys (the value itself, like `std::hash`: the prime capacity of
+     * StaticHashTbl uses every bit) and for `std::string_view` (FNV-1a); give StaticHashTbl
+     * another `constexpr` functor for other key types.
+     */
+    template <class KeyType, class = void>
+    struct static_hash;
+
+    template <class KeyType>
+    struct static_hash<KeyType, std::enable_if_t< std::is_integral_v<KeyType> || std::is_enum_v<KeyType> >> {
+        constexpr std::size_t operator()( KeyType key_ ) const noexcept
+        {
+            if constexpr (std::is_enum_v<KeyType>)
+                return static_cast<std::size_t>(static_cast<std::underlying_type_t<KeyType>>(key_));
+            else
+                return static_cast<std::size_t>(key_);
+        }
+    };
+
+    template <>
+    struct static_hash<std::string_view> {
+        constexpr std::size_t operator()( std::string_view sv_ ) const noexcept
+        {
+            std::uint64_t h{0xCBF29CE484222325ull};
+            for (char c : sv_)
+                h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    namespace detail {
+        /// Slots of a StaticHashTbl holding up to `n_` elements: the smallest prime of PRIMES
+        /// above 1.5 n, so the load factor stays under 2/3 and every probe sequence meets an empty slot.
+        constexpr std::size_t static_capacity( std::size_t n_ )
+        {
+            std::size_t i{0};
+            while (i + 1 < PRIMES.size() && PRIMES[i] < n_ + n_ / 2 + 1)
+                ++i;
+            return static_cast<std::size_t>(PRIMES[i]);
+        }
+    } // namespace detail
+
+    /*!
+     * @brief Fixed-capacity hash table with inline storage, usable in constant expressions.
+     *
+     * Holds at most `N` elements in an array of `capacity()` slots that lives inside the
+     * object: nothing is ever allocated. The capacity is a prime chosen at compile time, so
+     * mapping a hash to a slot is a modulo by a constant (a multiply and a shift). Collisions
+     * are resolved by linear probing, and erasing shifts the following entries back, so there
+     * are no tombstones.
+     *
+     * Every member is `constexpr`. With literal key and data types (integers, enums,
+     * `std::string_view`, ...) and a `constexpr` hash, a table built from a literal list is
+     * constructed by the compiler and, declared `constexpr`, lands in read-only data:
+     *
+     *     static constexpr ac::StaticHashTbl<char, int, 3> table{ {'a', 27}, {'b', 3}, {'c', 1} };
+     *     static_assert( table.at('b') == 3 );
+     *
+     * Inserting an `N+1`-th key throws `std::length_error` (a compile error in a constant
+     * expression).
+     */
+	template< class KeyType,
+		      class DataType,
+		      std::size_t N,
+		      class KeyHash = static_hash< KeyType >,
+		      class KeyEqual = std::equal_to< KeyType > >
+	class StaticHashTbl {
+        public:
+            // Aliases
+            using key_type = KeyType;
+            using mapped_type = DataType;
+            using value_type = std::pair<KeyType, DataType>;
+            using size_type  = std::size_t;
+
+            constexpr StaticHashTbl() = default;
+            constexpr StaticHashTbl( std::initializer_list< value_type > );
+
+            constexpr bool insert( const KeyType &, const DataType & );
+            constexpr bool retrieve( const KeyType &, DataType & ) const;
+            constexpr bool contains( const KeyType & ) const;
+            constexpr bool erase( const KeyType & );
+            constexpr void clear();
+            constexpr DataType& at( const KeyType & );
+            constexpr const DataType& at( const KeyType & ) const;
+            constexpr size_type count( const KeyType & ) const;
+            template <class Function> constexpr void for_each( Function && ) const;
+
+            constexpr bool empty() const { return m_count == 0; };
+            constexpr size_type size() const { return m_count; };
+            /// Most elements the table may hold.
+            static constexpr size_type max_size() { return N; };
+            /// Number of slots (a prime above 1.5 max_size()).
+            static constexpr size_type capacity() { return CAPACITY; };
+
+        private:
+            /// An element; `m_used` is false in empty slots.
+            struct Slot {
+                KeyType m_key{};
+                DataType m_data{};
+                bool m_used{false};
+            };
+
+            static constexpr size_type home( const KeyType & );
+            static constexpr size_type next( size_type i_ ) { return i_ + 1 == CAPACITY ? 0 : i_ + 1; };
+            constexpr size_type find_index( const KeyType & ) const;
+
+        private:
+            static constexpr size_type CAPACITY = detail::static_capacity(N);
+            static constexpr size_type NOT_FOUND = static_cast<size_type>(-1);
+
+            std::array<Slot, CAPACITY> m_slots{}; //!< Inline element storage.
+            size_type m_count{0};                 //!< Number of elements.
+    };
+
+} // namespace ac
+#include "static_hashtbl.inl"
+#endif
@@ -0,0 +1,213 @@
+#include "static_hashtbl.h"
+
+/*!
+ * @file static_hashtbl.inl
+ * @brief Implementation of the StaticHashTbl class (fixed capacity, inline storage, constexpr).
+ *
+ * Authors: Gabriel Victor and Thiago Raquel.
+ */
+
+namespace ac {
+    /*!
+     * @brief Constructor that inserts the pairs of a list, in order (a repeated key keeps the last data).
+     *
+     * @param ilist The key-value pairs.
+     * @throws std::length_error if the list has more than `N` distinct keys.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::StaticHashTbl(std::initializer_list<value_type> ilist)
+    {
+        for (const auto &pair : ilist)
+            insert(pair.first, pair.second);
+    }
+
+    /*!
+     * @brief Slot where the probe sequence of a key starts.
+     *
+     * @param key_ The key.
+     * @return Its hash modulo the (compile-time) capacity.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr typename StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::size_type
+    StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::home(const KeyType &key_)
+    {
+        return static_cast<size_type>(KeyHash()(key_) % CAPACITY);
+    }
+
+    /*!
+     * @brief Finds the slot of a key.
+     *
+     * @param key_ The key.
+     * @return The slot index, or NOT_FOUND if the key is absent.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr typename StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::size_type
+    StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::find_index(const KeyType &key_) const
+    {
+        // The capacity exceeds N, so the probe always reaches an empty slot
+        for (auto i = home(key_); m_slots[i].m_used; i = next(i))
+            if (KeyEqual()(m_slots[i].m_key, key_))
+                return i;
+        return NOT_FOUND;
+    }
+
+    /*!
+     * @brief Inserts a key-value pair, replacing the data if the key already exists.
+     *
+     * @param key_ The key to be inserted.
+     * @param data_item_ The data associated with the key.
+     * @return true if the key was new, false if its data was replaced.
+     * @throws std::length_error if the key is new and the table already holds `N` elements.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr bool StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::insert(const KeyType &key_,
+                                                                                  const DataType &data_item_)
+    {
+        auto i = home(key_);
+        for (; m_slots[i].m_used; i = next(i)) {
+            if (KeyEqual()(m_slots[i].m_key, key_)) {
+                m_slots[i].m_data = data_item_;
+                return false;
+            }
+        }
+        if (m_count == N)
+            throw std::length_error("StaticHashTbl: capacity exceeded");
+
+        m_slots[i].m_key = key_;
+        m_slots[i].m_data = data_item_;
+        m_slots[i].m_used = true;
+        ++m_count;
+        return true;
+    }
+
+    /*!
+     * @brief Retrieves the data associated with a key.
+     *
+     * @param key_ The key to look up.
+     * @param data_item_ Receives the data if the key is found.
+     * @return true if the key was found.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr bool StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::retrieve(const KeyType &key_,
+                                                                                    DataType &data_item_) const
+    {
+        auto i = find_index(key_);
+        if (i == NOT_FOUND)
+            return false;
+        data_item_ = m_slots[i].m_data;
+        return true;
+    }
+
+    /*!
+     * @brief Checks whether a key is in the table.
+     *
+     * @param key_ The key to look up.
+     * @return true if the key was found.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr bool StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::contains(const KeyType &key_) const
+    {
+        return find_index(key_) != NOT_FOUND;
+    }
+
+    /*!
+     * @brief Removes the element with a key.
+     *
+     * The entries that follow it in the same cluster are shifted back when that brings them
+     * closer to their home slot, so lookups never need tombstones.
+     *
+     * @param key_ The key of the element to be removed.
+     * @return true if the key was found and removed.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr bool StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::erase(const KeyType &key_)
+    {
+        auto hole = find_index(key_);
+        if (hole == NOT_FOUND)
+            return false;
+
+        for (auto j = next(hole); m_slots[j].m_used; j = next(j)) {
+            // The entry at j may fill the hole unless its home lies cyclically in (hole, j]
+            auto h = home(m_slots[j].m_key);
+            bool stays = hole < j ? (hole < h && h <= j) : (hole < h || h <= j);
+            if (!stays) {
+                m_slots[hole] = m_slots[j];
+                hole = j;
+            }
+        }
+        m_slots[hole] = Slot{};
+        --m_count;
+        return true;
+    }
+
+    /*!
+     * @brief Removes every element.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr void StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::clear()
+    {
+        for (auto &slot : m_slots)
+            slot = Slot{};
+        m_count = 0;
+    }
+
+    /*!
+     * @brief Returns the data associated with a key.
+     *
+     * @param key_ The key to look up.
+     * @return Reference to the data.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr DataType& StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::at(const KeyType &key_)
+    {
+        auto i = find_index(key_);
+        if (i == NOT_FOUND)
+            throw std::out_of_range("Key not found");
+        return m_slots[i].m_data;
+    }
+
+    /*!
+     * @brief Returns the data associated with a key.
+     *
+     * @param key_ The key to look up.
+     * @return Reference to the data.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr const DataType& StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::at(const KeyType &key_) const
+    {
+        auto i = find_index(key_);
+        if (i == NOT_FOUND)
+            throw std::out_of_range("Key not found");
+        return m_slots[i].m_data;
+    }
+
+    /*!
+     * @brief Counts the elements with a key.
+     *
+     * @param key_ The key to look up.
+     * @return 1 if the key is in the table, 0 otherwise.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    constexpr typename StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::size_type
+    StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::count(const KeyType &key_) const
+    {
+        return contains(key_) ? 1 : 0;
+    }
+
+    /*!
+     * @brief Calls `fn_(key, data)` for every element, in slot order.
+     *
+     * @param fn_ Function called once per element; it must not modify the table.
+     */
+    template <typename KeyType, typename DataType, std::size_t N, typename KeyHash, typename KeyEqual>
+    template <class Function>
+    constexpr void StaticHashTbl<KeyType, DataType, N, KeyHash, KeyEqual>::for_each(Function &&fn_) const
+    {
+        for (const auto &slot : m_slots)
+            if (slot.m_used)
+                fn_(slot.m_key, slot.m_data);
+    }
+
+} // namespace ac
@@ -0,0 +1,180 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef SWISS_HASHTBL_H
+#define SWISS_HASHTBL_H
+
+#include <iostream>         // cout, endl, ostream
+#include <memory>           // std::allocator
+#include <cstdint>          // std::int8_t, std::uint32_t, std::uint64_t
+#include <cstring>          // std::memset
+#include <stdexcept>        // std::out_of_range, std::invalid_argument
+#include <functional>       // std::hash, std::equal_to
+#include <initializer_list>
+#include <utility>          // std::move
+
+#include "hashtbl.h"        // HashEntry
+
+// SSE2 is part of x86-64, so the vector path is on by default there.
+// Define AC_SWISS_NO_SIMD to force the portable scalar path.
+#if defined(__SSE2__) && !defined(AC_SWISS_NO_SIMD)
+#define AC_SWISS_SSE2 1
+#include <emmintrin.h>      // _mm_cmpeq_epi8, _mm_movemask_epi8
+#else
+#define AC_SWISS_SSE2 0
+#endif
+
+namespace ac // Associative container
+{
+    namespace detail {
+        /// Control byte values. Full slots store the 7 low bits of the hash (0..127).
+        enum ctrl_t : std::int8_t {
+            CTRL_EMPTY   = -128, // 0b10000000
+            CTRL_DELETED = -2,   // 0b11111110
+        };
+
+        /// Number of control bytes inspected at once.
+        constexpr std::size_t GROUP_WIDTH = 16;
+
+        /// Index of the lowest set bit of a non-zero match mask.
+        inline std::size_t ctz( std::uint32_t mask_ ) {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctz(mask_));
+#else
+            std::size_t i{0};
+            for (; (mask_ & 1) == 0; mask_ >>= 1)
+                ++i;
+            return i;
+#endif
+        }
+
+        /*!
+         * @brief Portable view of a group of 16 control bytes.
+         *
+         * Each `match*()` method returns a bit mask where bit `i` is set when the
+         * i-th control byte of the group satisfies the condition.
+         */
+        struct GroupScalar {
+            std::int8_t m_ctrl[GROUP_WIDTH];
+
+            explicit GroupScalar( const std::int8_t *ctrl_ ) { std::memcpy(m_ctrl, ctrl_, GROUP_WIDTH); }
+
+            std::uint32_t match( std::int8_t h2_ ) const {
+                std::uint32_t mask{0};
+                for (std::size_t i{0}; i < GROUP_WIDTH; ++i)
+                    mask |= std::uint32_t(m_ctrl[i] == h2_) << i;
+                return mask;
+            }
+            std::uint32_t match_empty() const { return match(CTRL_EMPTY); }
+            std::uint32_t match_empty_or_deleted() const {
+                std::uint32_t mask{0};
+                for (std::size_t i{0}; i < GROUP_WIDTH; ++i)
+                    mask |= std::uint32_t(m_ctrl[i] < 0) << i;
+                return mask;
+            }
+        };
+
+#if AC_SWISS_SSE2
+        /// SSE2 view of a group of 16 control bytes (one compare per query).
+        struct GroupSse2 {
+            __m128i m_ctrl;
+
+            explicit GroupSse2( const std::int8_t *ctrl_ )
+                : m_ctrl{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl_)) } {}
+
+            std::uint32_t match( std::int8_t h2_ ) const {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2_), m_ctrl)));
+            }
+            std::uint32_t match_empty() const { return match(CTRL_EMPTY); }
+            // Empty and deleted are the only negative control bytes: the sign bits are the answer.
+            std::uint32_t match_empty_or_deleted() const {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(m_ctrl));
+            }
+        };
+        using Group = GroupSse2;
+#else
+        using Group = GroupScalar;
+#endif
+    } // namespace detail
+
+    /*!
+     * @brief Open-addressing hash table with Swiss-table style group probing.
+     *
+     * Same interface as HashTbl. Entries live inline in one slot array, and a
+     * separate array holds one control byte per slot: empty, deleted, or the 7 low
+     * bits of the (mixed) hash. Slots are probed in aligned groups of 16; the
+     * control bytes of a group are compared against the key's tag in one SSE2
+     * instruction, so `KeyEqual` is only called on slots whose tag matches.
+     */
+	template< class KeyType,
+		      class DataType,
+		      class KeyHash = std::hash< KeyType >,
+		      class KeyEqual = std::equal_to< KeyType > >
+	class SwissHashTbl {
+        public:
+            // Aliases
+            using entry_type = HashEntry<KeyType,DataType>;
+            using size_type  = std::size_t;
+
+            explicit SwissHashTbl( size_type table_sz_ = DEFAULT_SIZE );
+            SwissHashTbl( const SwissHashTbl& );
+            SwissHashTbl( const std::initializer_list< entry_type > & );
+            SwissHashTbl& operator=( const SwissHashTbl& );
+            SwissHashTbl& operator=( const std::initializer_list< entry_type > & );
+
+            virtual ~SwissHashTbl();
+
+            bool insert( const KeyType &, const DataType &  );
+            bool retrieve( const KeyType &, DataType & ) const;
+            DataType* find( const KeyType & );
+            const DataType* find( const KeyType & ) const;
+            bool erase( const KeyType & );
+            void clear();
+            bool empty() const;
+            inline size_type size() const { return m_count; };
+            inline size_type capacity() const { return m_capacity; };
+            DataType& at( const KeyType& );
+            DataType& operator[]( const KeyType& );
+            size_type count( const KeyType& ) const;
+            float max_load_factor() const;
+            void max_load_factor(float mlf);
+
+            friend std::ostream & operator<<(std::ostream & os_, const SwissHashTbl & ht_)
+            {
+                for (size_t i{0}; i < ht_.m_capacity; ++i) {
+                    os_ << "[" << i << "]->\n";
+                    if (ht_.m_ctrl[i] >= 0)
+                        os_ << ht_.m_slots[i].m_data << "\n";
+                }
+
+                os_ << std::endl;
+
+                return os_;
+            }
+
+        private:
+            void allocate( size_type );
+            void release( void );
+            void resize( size_type );
+            void copy_from( const SwissHashTbl& );
+
+            static std::uint64_t mixed_hash( const KeyType& );
+            size_type find_index( const KeyType&, std::uint64_t ) const;
+            size_type find_free( std::uint64_t ) const;
+            size_type place( entry_type&&, std::uint64_t );
+
+        private:
+            size_type m_capacity{0}; //!< Number of slots (a power of two, multiple of the group width).
+            size_type m_count{0};    //!< Number of stored entries.
+            size_type m_deleted{0};  //!< Number of tombstones (deleted control bytes).
+            float m_factor_load{DEFAULT_LOAD}; //!< Maximum (entries + tombstones) / capacity.
+            entry_type *m_slots{nullptr}; //!< Inline entry storage (raw memory, constructed on demand).
+            std::int8_t *m_ctrl{nullptr}; //!< One control byte per slot.
+
+            static constexpr size_type DEFAULT_SIZE = 16;
+            static constexpr float DEFAULT_LOAD = 0.875f;
+            static constexpr size_type NOT_FOUND = static_cast<size_type>(-1);
+    };
+
+} // MyHashTable
+#include "swiss_hashtbl.inl"
+#endif
@@ -0,0 +1,493 @@
+#include "swiss_hashtbl.h"
+
+/*!
+ * @file swiss_hashtbl.inl
+ * @brief Implementation of the SwissHashTbl class (control-byte group probing).
+ *
+ * Authors: Gabriel Victor and Thiago Raquel.
+ */
+
+namespace ac {
+    /*!
+     * @brief Constructor that initializes the table with room for at least `sz` slots.
+     *
+     * @param sz Requested number of slots, rounded up to a power of two (minimum 16).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::SwissHashTbl(size_type sz)
+    {
+        allocate(sz);
+    }
+
+    /*!
+     * @brief Constructor that initializes the table based on another existing table.
+     *
+     * @param source The table from which to copy the elements.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::SwissHashTbl(const SwissHashTbl &source)
+    {
+        copy_from(source);
+    }
+
+    /*!
+     * @brief Constructor that initializes the table based on an initializer list.
+     *
+     * @param ilist Initialization list containing key-value pairs.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::SwissHashTbl(const std::initializer_list<entry_type> &ilist)
+    {
+        // Size the table so that the whole list fits without growing.
+        allocate(static_cast<size_type>(ilist.size() / m_factor_load) + 1);
+        for (const auto &entry : ilist)
+            insert(entry.m_key, entry.m_data);
+    }
+
+    /*!
+     * @brief Assignment operator that replaces the table's elements with those of another table.
+     *
+     * @param clone The table to be copied.
+     * @return Reference to the table after the copy.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual> &
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::operator=(const SwissHashTbl &clone)
+    {
+        if (this != &clone) {
+            release();
+            copy_from(clone);
+        }
+        return *this;
+    }
+
+    /*!
+     * @brief Assignment operator that replaces the table's elements with those of an initializer list.
+     *
+     * @param ilist Initialization list containing key-value pairs.
+     * @return Reference to the table after the copy.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual> &
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::operator=(const std::initializer_list<entry_type> &ilist)
+    {
+        clear();
+        for (const auto &entry : ilist)
+            insert(entry.m_key, entry.m_data);
+        return *this;
+    }
+
+    /*!
+     * @brief Destructor that destroys every stored entry and frees the arrays.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::~SwissHashTbl()
+    {
+        release();
+    }
+
+    /*!
+     * @brief Inserts a new key-value pair into the table.
+     *
+     * @param key_ The key to be inserted.
+     * @param new_data_ The data associated with the key.
+     * @return true if the insertion was successful, false if the key already exists
+     * (in which case its data is updated).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::insert(const KeyType &key_, const DataType &new_data_)
+    {
+        auto hash = mixed_hash(key_);
+        auto idx = find_index(key_, hash);
+        if (idx != NOT_FOUND) {
+            // The key already exists, update the data
+            m_slots[idx].m_data = new_data_;
+            return false;
+        }
+
+        place(entry_type(key_, new_data_), hash);
+        return true;
+    }
+
+    /*!
+     * @brief Clears all elements from the table, keeping its capacity.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::clear()
+    {
+        for (size_type i{0}; i < m_capacity; ++i) {
+            if (m_ctrl[i] >= 0)
+                m_slots[i].~entry_type();
+        }
+        std::memset(m_ctrl, detail::CTRL_EMPTY, m_capacity);
+        m_count = 0;
+        m_deleted = 0;
+    }
+
+    /*!
+     * @brief Checks if the table is empty.
+     *
+     * @return true if the table is empty, false otherwise.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::empty() const
+    {
+        return m_count == 0;
+    }
+
+    /*!
+     * @brief Retrieves the data associated with a given key.
+     *
+     * @param key_ The key to search for.
+     * @param data_item_ The variable to store the retrieved data.
+     * @return true if the retrieval was successful, false if the key does not exist.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::retrieve(const KeyType &key_, DataType &data_item_) const
+    {
+        auto idx = find_index(key_, mixed_hash(key_));
+        if (idx == NOT_FOUND)
+            return false;
+
+        data_item_ = m_slots[idx].m_data;
+        return true;
+    }
+
+    /*!
+     * @brief Looks up a key without copying its data.
+     *
+     * @param key_ The key to search for.
+     * @return A pointer to the data associated with the key, or nullptr if the key
+     * does not exist. The pointer is invalidated by the next insertion.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    DataType* SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::find(const KeyType &key_)
+    {
+        auto idx = find_index(key_, mixed_hash(key_));
+        return idx == NOT_FOUND ? nullptr : &m_slots[idx].m_data;
+    }
+
+    /*!
+     * @brief Looks up a key without copying its data (read-only).
+     *
+     * @param key_ The key to search for.
+     * @return A pointer to the data associated with the key, or nullptr if the key does not exist.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    const DataType* SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::find(const KeyType &key_) const
+    {
+        auto idx = find_index(key_, mixed_hash(key_));
+        return idx == NOT_FOUND ? nullptr : &m_slots[idx].m_data;
+    }
+
+    /*!
+     * @brief Removes the element with the provided key.
+     *
+     * The slot becomes empty again if its group still has an empty slot (no probe
+     * ever went past that group); otherwise it becomes a tombstone so that probes
+     * for keys stored further along keep going.
+     *
+     * @param key_ The key of the element to be removed.
+     * @return true if the removal is successful, false if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    bool SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::erase(const KeyType &key_)
+    {
+        auto idx = find_index(key_, mixed_hash(key_));
+        if (idx == NOT_FOUND)
+            return false;
+
+        m_slots[idx].~entry_type();
+
+        auto group_start = idx & ~(detail::GROUP_WIDTH - 1);
+        if (detail::Group(m_ctrl + group_start).match_empty() != 0) {
+            m_ctrl[idx] = detail::CTRL_EMPTY;
+        }
+        else {
+            m_ctrl[idx] = detail::CTRL_DELETED;
+            m_deleted++;
+        }
+
+        m_count--;
+        return true;
+    }
+
+    /*!
+     * @brief Returns the number of elements stored with the given key.
+     *
+     * @param key_ The key to count.
+     * @return 1 if the key is in the table, 0 otherwise.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    typename SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::count(const KeyType &key_) const
+    {
+        return find_index(key_, mixed_hash(key_)) == NOT_FOUND ? 0 : 1;
+    }
+
+    /*!
+     * @brief Retrieves the value associated with the specified key.
+     *
+     * @param key_ The key to retrieve the associated value.
+     * @return A reference to the value associated with the key.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    DataType& SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::at(const KeyType &key_)
+    {
+        auto idx = find_index(key_, mixed_hash(key_));
+        if (idx == NOT_FOUND)
+            throw std::out_of_range("Key not found");
+
+        return m_slots[idx].m_data;
+    }
+
+    /*!
+     * @brief Access or insert the value associated with the specified key.
+     *
+     * If the key is not found, a new element with a default-constructed value is inserted.
+     *
+     * @param key_ The key to access or insert.
+     * @return A reference to the value associated with the key.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    DataType& SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::operator[](const KeyType &key_)
+    {
+        auto hash = mixed_hash(key_);
+        auto idx = find_index(key_, hash);
+        if (idx == NOT_FOUND)
+            idx = place(entry_type(key_, DataType{}), hash);
+
+        return m_slots[idx].m_data;
+    }
+
+    /*!
+     * @brief Set the maximum load factor for the table.
+     *
+     * Tombstones count towards the load, since they lengthen probes just like entries.
+     *
+     * @param mlf The new maximum load factor, in the open interval (0, 1).
+     * @throws std::invalid_argument if `mlf` is out of range.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::max_load_factor(float mlf)
+    {
+        // Probes stop at the first group with an empty slot, so there must always be one.
+        if (!(mlf > 0.f && mlf < 1.f))
+            throw std::invalid_argument("max_load_factor must be in (0, 1)");
+        m_factor_load = mlf;
+    }
+
+    /*!
+     * @brief Get the current maximum load factor for the table.
+     *
+     * @return The current maximum load factor.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    float SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::max_load_factor() const
+    {
+        return m_factor_load;
+    }
+
+
+
+    /*=================== Métodos auxiliares ==============================*/
+    /*!
+     * @brief Allocates empty arrays with room for at least `sz` slots.
+     *
+     * @param sz Requested number of slots, rounded up to a power of two (minimum one group).
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::allocate(size_type sz)
+    {
+        m_capacity = detail::GROUP_WIDTH;
+        while (m_capacity < sz)
+            m_capacity <<= 1;
+
+        m_slots = std::allocator<entry_type>().allocate(m_capacity);
+        m_ctrl = new std::int8_t[m_capacity];
+        std::memset(m_ctrl, detail::CTRL_EMPTY, m_capacity);
+        m_count = 0;
+        m_deleted = 0;
+    }
+
+    /*!
+     * @brief Destroys every stored entry and frees the arrays.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::release(void)
+    {
+        if (m_slots == nullptr)
+            return;
+
+        clear();
+        std::allocator<entry_type>().deallocate(m_slots, m_capacity);
+        delete [] m_ctrl;
+        m_slots = nullptr;
+        m_ctrl = nullptr;
+        m_capacity = 0;
+    }
+
+    /*!
+     * @brief Copies capacity, load factor and entries (at the same slots) from another table.
+     *
+     * @param source The table to copy from. The current table must hold no storage.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::copy_from(const SwissHashTbl &source)
+    {
+        m_factor_load = source.m_factor_load;
+        allocate(source.m_capacity);
+
+        for (size_type i{0}; i < m_capacity; ++i) {
+            if (source.m_ctrl[i] >= 0)
+                ::new (static_cast<void*>(m_slots + i)) entry_type(source.m_slots[i]);
+        }
+        std::memcpy(m_ctrl, source.m_ctrl, m_capacity);
+        m_count = source.m_count;
+        m_deleted = source.m_deleted;
+    }
+
+    /*!
+     * @brief Moves every entry into new arrays with `new_capacity` slots.
+     *
+     * Also drops all tombstones.
+     *
+     * @param new_capacity The number of slots of the new arrays.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    void SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::resize(size_type new_capacity)
+    {
+        auto old_slots = m_slots;
+        auto old_ctrl = m_ctrl;
+        auto old_capacity = m_capacity;
+
+        allocate(new_capacity);
+
+        for (size_type i{0}; i < old_capacity; ++i) {
+            if (old_ctrl[i] >= 0) {
+                auto hash = mixed_hash(old_slots[i].m_key);
+                auto idx = find_free(hash);
+                ::new (static_cast<void*>(m_slots + idx)) entry_type(std::move(old_slots[i]));
+                m_ctrl[idx] = static_cast<std::int8_t>(hash & 0x7F);
+                m_count++;
+                old_slots[i].~entry_type();
+            }
+        }
+
+        std::allocator<entry_type>().deallocate(old_slots, old_capacity);
+        delete [] old_ctrl;
+    }
+
+    /*!
+     * @brief Hashes a key and spreads its bits.
+     *
+     * The low 7 bits become the control tag and the remaining bits select the
+     * first group, so weak hashes (e.g. the identity `std::hash<int>`) are mixed first.
+     *
+     * @param key_ The key.
+     * @return The mixed 64-bit hash.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    std::uint64_t SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::mixed_hash(const KeyType &key_)
+    {
+        std::uint64_t h = KeyHash()(key_);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    /*!
+     * @brief Locates the slot holding a key.
+     *
+     * Groups are visited in triangular order (g, g+1, g+3, g+6, ...), which covers
+     * every group when their number is a power of two. Within a group only slots
+     * whose tag matches are compared with `KeyEqual`. The search stops at the first
+     * group with an empty slot.
+     *
+     * @param key_ The key to search for.
+     * @param hash_ The mixed hash of the key.
+     * @return The slot index, or NOT_FOUND.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    typename SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::find_index(const KeyType &key_, std::uint64_t hash_) const
+    {
+        const size_type group_mask = m_capacity / detail::GROUP_WIDTH - 1;
+        const auto h2 = static_cast<std::int8_t>(hash_ & 0x7F);
+        size_type group = (hash_ >> 7) & group_mask;
+
+        for (size_type step{1}; step <= group_mask + 1; ++step) {
+            const auto base = group * detail::GROUP_WIDTH;
+            detail::Group g(m_ctrl + base);
+
+            for (auto mask = g.match(h2); mask != 0; mask &= mask - 1) {
+                auto idx = base + detail::ctz(mask);
+                if (KeyEqual()(m_slots[idx].m_key, key_))
+                    return idx;
+            }
+            if (g.match_empty() != 0)
+                return NOT_FOUND;
+
+            group = (group + step) & group_mask;
+        }
+        return NOT_FOUND;
+    }
+
+    /*!
+     * @brief Finds the first empty or deleted slot along the probe sequence of a hash.
+     *
+     * @param hash_ The mixed hash of the key to be placed.
+     * @return The slot index. There is always one, since the load factor is below 1.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    typename SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::find_free(std::uint64_t hash_) const
+    {
+        const size_type group_mask = m_capacity / detail::GROUP_WIDTH - 1;
+        size_type group = (hash_ >> 7) & group_mask;
+
+        for (size_type step{1}; ; ++step) {
+            const auto base = group * detail::GROUP_WIDTH;
+            auto mask = detail::Group(m_ctrl + base).match_empty_or_deleted();
+            if (mask != 0)
+                return base + detail::ctz(mask);
+
+            group = (group + step) & group_mask;
+        }
+    }
+
+    /*!
+     * @brief Places an entry whose key is known not to be in the table.
+     *
+     * When entries plus tombstones would exceed the maximum load, the table is
+     * rebuilt first: at the same capacity if tombstones are the problem, otherwise
+     * at twice the capacity.
+     *
+     * @param entry_ The entry to place.
+     * @param hash_ The mixed hash of the entry's key.
+     * @return The slot where the entry was placed.
+     */
+    template <typename KeyType, typename DataType, typename KeyHash, typename KeyEqual>
+    typename SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::size_type
+    SwissHashTbl<KeyType, DataType, KeyHash, KeyEqual>::place(entry_type &&entry_, std::uint64_t hash_)
+    {
+        if (m_count + m_deleted + 1 > m_capacity * m_factor_load) {
+            if (m_deleted > m_count / 2)
+                resize(m_capacity);
+            else
+                resize(m_capacity * 2);
+        }
+
+        auto idx = find_free(hash_);
+        if (m_ctrl[idx] == detail::CTRL_DELETED)
+            m_deleted--;
+
+        ::new (static_cast<void*>(m_slots + idx)) entry_type(std::move(entry_));
+        m_ctrl[idx] = static_cast<std::int8_t>(hash_ & 0x7F);
+        m_count++;
+        return idx;
+    }
+
+} // Namespace ac.
@@ -0,0 +1,129 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>          // std::max
+#include <chrono>             // std::chrono::milliseconds
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <functional>         // std::function
+#include <future>             // std::packaged_task, std::future
+#include <memory>             // std::make_shared
+#include <mutex>              // std::mutex, std::unique_lock
+#include <queue>
+#include <thread>
+#include <type_traits>        // std::invoke_result_t
+#include <vector>
+
+namespace ac // Associative container
+{
+    /*!
+     * @brief A fixed set of worker threads running submitted tasks in FIFO order.
+     *
+     * submit() returns a future for the task's result (or exception). The destructor runs
+     * every task already submitted, then joins the workers.
+     */
+    class ThreadPool {
+        public:
+            using size_type = std::size_t;
+
+            /// Starts `threads_` workers (at least one; 0 means one per hardware thread).
+            explicit ThreadPool( size_type threads_ = 0 )
+            {
+                if (threads_ == 0)
+                    threads_ = std::max<size_type>(1, std::thread::hardware_concurrency());
+                m_workers.reserve(threads_);
+                for (size_type i{0}; i < threads_; ++i)
+                    m_workers.emplace_back([this] { work(); });
+            }
+            ThreadPool( const ThreadPool& ) = delete;
+            ThreadPool& operator=( const ThreadPool& ) = delete;
+
+            ~ThreadPool()
+            {
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_stopping = true;
+                }
+                m_ready.notify_all();
+                for (auto &worker : m_workers)
+                    worker.join();
+            }
+
+            /*!
+             * @brief Queues `fn_()` to run on a worker.
+             *
+             * @param fn_ Callable taking no argument.
+             * @return A future for its result; get() rethrows what the task threw.
+             */
+            template <class Function>
+            std::future<std::invoke_result_t<Function>> submit( Function &&fn_ )
+            {
+                using result_type = std::invoke_result_t<Function>;
+                // std::function needs a copyable target, so the task is held by a shared pointer.
+                auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<Function>(fn_));
+                auto result = task->get_future();
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_tasks.emplace([task] { (*task)(); });
+                }
+                m_ready.notify_one();
+                return result;
+            }
+
+            /*!
+             * @brief Runs `fn_(i)` for every `i` in [0, n_) on the workers and waits for all of them.
+             *
+             * Must not be called from a task of this pool, which would wait for itself.
+             *
+             * @param n_ Number of calls.
+             * @param fn_ Callable taking the index; it outlives the calls.
+             * @throws Whatever a call threw (the lowest index first), once every call finished.
+             */
+            template <class Function>
+            void parallel_for( size_type n_, Function &&fn_ )
+            {
+                std::vector<std::future<void>> done;
+                done.reserve(n_);
+                for (size_type i{0}; i < n_; ++i)
+                    done.push_back(submit([&fn_, i] { fn_(i); }));
+                for (auto &f : done)
+                    f.wait();
+                for (auto &f : done)
+                    f.get();
+            }
+
+            /// Number of worker threads.
+            size_type size() const { return m_workers.size(); }
+
+        private:
+            void work()
+            {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock lock(m_mutex);
+                        // Timed waits are inline in libstdc++, while the untimed one needs a runtime
+                        // at least as new as GCC 12's; bounded waits run against older runtimes too.
+                        while (!m_ready.wait_for(lock, std::chrono::milliseconds(100),
+                                                 [this] { return m_stopping || !m_tasks.empty(); })) {
+                        }
+                        if (m_tasks.empty())
+                            return; // Stopping, and nothing left to run.
+                        task = std::move(m_tasks.front());
+                        m_tasks.pop();
+                    }
+                    task();
+                }
+            }
+
+            std::vector<std::thread> m_workers;
+            std::queue<std::function<void()>> m_tasks; //!< Submitted tasks not started yet.
+            std::mutex m_mutex;                        //!< Guards m_tasks and m_stopping.
+            std::condition_variable m_ready;           //!< Signals a new task or the shutdown.
+            bool m_stopping{false};
+    };
+
+} // namespace ac
+#endif
@@ -0,0 +1,81 @@
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"                  // gtest lib
+#include "../driver/account_loader.h"     // header file for tested functions
+
+// ============================================================================
+// TESTING THE PARALLEL ACCOUNT LOADER
+// ============================================================================
+
+TEST(AccountLoader, ParsesCsvAndCountsBadRows)
+{
+    auto parsed = parse_accounts_csv( "name,bank,branch,number,balance\n"
+                                      "Alex Bastos,1,1668,54321,1500\r\n"
+                                      "\n"
+                                      "Aline Souza,1,1668,45794,530.5\n"
+                                      "broken,1,x,3,4\n"
+                                      "too,few,fields\n"
+                                      "Jose Lima,18,331,1231,850" ); // No final newline.
+    ASSERT_EQ( parsed.accounts.size(), 3u );
+    ASSERT_EQ( parsed.bad_rows, 2u );
+    ASSERT_EQ( parsed.accounts[0], Account( "Alex Bastos", 1, 1668, 54321, 1500.f ) );
+    ASSERT_EQ( parsed.accounts[1].m_balance, 530.5f );
+    ASSERT_EQ( parsed.accounts[2].m_name, "Jose Lima" );
+}
+
+TEST(AccountLoader, ChunkedParseMatchesSerialParse)
+{
+    std::string csv;
+    for ( int i{0}; i < 1000; ++i )
+        csv += "Client " + std::to_string( i ) + ",1," + std::to_string( i % 13 ) + "," + std::to_string( i ) + ",2.5\n";
+    auto serial = parse_accounts_csv( csv );
+
+    ac::ThreadPool pool( 3 );
+    for ( size_t chunks : { 1u, 2u, 7u, 64u, 5000u } ) {
+        auto parallel = parse_accounts( csv, pool, chunks );
+        ASSERT_EQ( parallel.bad_rows, 0u );
+        ASSERT_EQ( parallel.accounts.size(), serial.accounts.size() );
+        for ( size_t i{0}; i < serial.accounts.size(); ++i )
+            ASSERT_EQ( parallel.accounts[i], serial.accounts[i] ); // Input order is kept.
+    }
+}
+
+TEST(AccountLoader, LoadsCsvAndBinaryDumps)
+{
+    for ( bool binary : { false, true } ) {
+        auto path = ::testing::TempDir() + ( binary ? "accounts.bin" : "accounts.csv" );
+        write_sample_dump( path, 5000, binary );
+
+        AccountTbl table;
+        auto report = load_accounts( path, table, 4 );
+        std::remove( path.c_str() );
+
+        ASSERT_EQ( report.rows, 5000u );
+        ASSERT_EQ( report.bad_rows, 0u );
+        ASSERT_EQ( report.inserted, 5000u );
+        ASSERT_GT( report.bytes, 0u );
+        ASSERT_EQ( table.size(), 5000u );
+        Account a;
+        ASSERT_TRUE( table.retrieve( Account( "Client #4321", 1 + 4321 % 7, 4321 % 997, 4321 ).getKey(), a ) );
+        ASSERT_EQ( a.m_balance, 4321 / 4.f );
+    }
+    AccountTbl table;
+    ASSERT_THROW( load_accounts( ::testing::TempDir() + "no-such-dump", table ), std::runtime_error );
+}
+
+TEST(AccountLoader, PartialBinaryRecordIsBad)
+{
+    std::string bytes( ACCOUNT_BIN_MAGIC, sizeof( ACCOUNT_BIN_MAGIC ) );
+    AccountRecord r{};
+    std::string{ "Someone" }.copy( r.m_name, AccountRecord::NAME_SIZE );
+    r.m_number = 9;
+    bytes.append( reinterpret_cast<const char*>( &r ), sizeof( r ) );
+    bytes.append( 10, 'x' );
+
+    ac::ThreadPool pool( 2 );
+    auto parsed = parse_accounts( bytes, pool, 4 );
+    ASSERT_EQ( parsed.accounts.size(), 1u );
+    ASSERT_EQ( parsed.accounts[0].m_number, 9 );
+    ASSERT_EQ( parsed.bad_rows, 1u );
+}
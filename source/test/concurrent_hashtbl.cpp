@@ -0,0 +1,108 @@
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"                   // gtest lib
+#include "../include/concurrent_hashtbl.h" // header file for tested functions
+
+// ============================================================================
+// TESTING THE SHARDED CONCURRENT HASH TABLE
+// ============================================================================
+
+TEST(ConcurrentHTTest, SingleThreadedSurface)
+{
+    ac::ConcurrentHashTbl<std::string, int> table( 5 );
+    ASSERT_EQ( table.shard_count(), 8u );
+    ASSERT_TRUE( table.empty() );
+
+    ASSERT_TRUE( table.insert( "one", 1 ) );
+    ASSERT_FALSE( table.insert( "one", 11 ) );
+    table["two"] = 2;
+    table.update( "three", []( int &n ) { n += 3; } );
+
+    int data{0};
+    ASSERT_TRUE( table.retrieve( "one", data ) );
+    ASSERT_EQ( data, 11 );
+    ASSERT_TRUE( table.retrieve( "three", data ) );
+    ASSERT_EQ( data, 3 );
+    ASSERT_EQ( table.size(), 3u );
+
+    ASSERT_TRUE( table.erase( "two" ) );
+    ASSERT_FALSE( table.erase( "two" ) );
+    ASSERT_FALSE( table.contains( "two" ) );
+    table.clear();
+    ASSERT_TRUE( table.empty() );
+
+    ac::ConcurrentHashTbl<int, int> single( 1 );
+    for ( int i{0}; i < 100; ++i )
+        single.insert( i, i );
+    ASSERT_EQ( single.size(), 100u );
+}
+
+TEST(ConcurrentHTTest, StressMixedOperations)
+{
+    // Writers own disjoint key ranges and check them while readers and erasers run alongside.
+    constexpr int THREADS = 8;
+    constexpr int KEYS = 20000;
+    ac::ConcurrentHashTbl<int, int> table( 16, 2 );
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> threads;
+
+    for ( int t{0}; t < THREADS; ++t ) {
+        threads.emplace_back( [&, t]() {
+            const int base = t * KEYS;
+            for ( int i{0}; i < KEYS; ++i )
+                table.insert( base + i, i );
+            for ( int i{0}; i < KEYS; ++i ) {
+                int data{-1};
+                if ( not table.retrieve( base + i, data ) or data != i )
+                    failed = true;
+            }
+            // Erase the odd keys of the range.
+            for ( int i{1}; i < KEYS; i += 2 )
+                if ( not table.erase( base + i ) )
+                    failed = true;
+        } );
+        // A reader on someone else's range: must only ever see consistent data.
+        threads.emplace_back( [&, t]() {
+            const int base = ( ( t + 1 ) % THREADS ) * KEYS;
+            for ( int round{0}; round < 3; ++round )
+                for ( int i{0}; i < KEYS; ++i ) {
+                    int data{-1};
+                    if ( table.retrieve( base + i, data ) and data != i )
+                        failed = true;
+                }
+        } );
+    }
+    for ( auto &th : threads )
+        th.join();
+
+    ASSERT_FALSE( failed );
+    ASSERT_EQ( table.size(), static_cast<size_t>( THREADS * KEYS / 2 ) );
+    for ( int k{0}; k < THREADS * KEYS; ++k )
+        ASSERT_EQ( table.contains( k ), k % KEYS % 2 == 0 );
+}
+
+TEST(ConcurrentHTTest, StressUpdatesAreAtomic)
+{
+    // Every thread increments the same small set of counters.
+    constexpr int THREADS = 8;
+    constexpr int ROUNDS = 20000;
+    ac::ConcurrentHashTbl<std::string, long> counts( 4 );
+    std::vector<std::thread> threads;
+    for ( int t{0}; t < THREADS; ++t )
+        threads.emplace_back( [&]() {
+            for ( int i{0}; i < ROUNDS; ++i )
+                counts.update( "key" + std::to_string( i % 10 ), []( long &n ) { ++n; } );
+        } );
+    for ( auto &th : threads )
+        th.join();
+
+    for ( int k{0}; k < 10; ++k ) {
+        long n{0};
+        ASSERT_TRUE( counts.retrieve( "key" + std::to_string( k ), n ) );
+        ASSERT_EQ( n, THREADS * ROUNDS / 10 );
+    }
+}
@@ -0,0 +1,138 @@
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"               // gtest lib
+#include "../include/cow_hashtbl.h"    // header file for tested functions
+#include "../driver/account.h"
+
+// ============================================================================
+// TESTING THE COPY-ON-WRITE TABLE
+// ============================================================================
+
+TEST(CowHashTbl, BasicOperations)
+{
+    ac::CowHashTbl<std::string, int> table;
+    ASSERT_TRUE( table.empty() );
+    ASSERT_TRUE( table.insert( "one", 1 ) );
+    ASSERT_TRUE( table.insert( "two", 2 ) );
+    ASSERT_FALSE( table.insert( "one", 10 ) ); // Replaced.
+    ASSERT_EQ( table.size(), 2u );
+    ASSERT_EQ( table.at( "one" ), 10 );
+    ASSERT_THROW( table.at( "three" ), std::out_of_range );
+    ASSERT_EQ( table.count( "two" ), 1u );
+    ASSERT_TRUE( table.erase( "two" ) );
+    ASSERT_FALSE( table.erase( "two" ) );
+    ASSERT_FALSE( table.contains( "two" ) );
+
+    for ( int i{0}; i < 10000; ++i )
+        table.insert( std::to_string( i ), i );
+    ASSERT_EQ( table.size(), 10001u );
+    ASSERT_LE( table.size(), table.bucket_count() * table.max_load_factor() );
+    for ( int i{0}; i < 10000; ++i ) {
+        int v{-1};
+        ASSERT_TRUE( table.retrieve( std::to_string( i ), v ) );
+        ASSERT_EQ( v, i );
+    }
+    table.clear();
+    ASSERT_TRUE( table.empty() );
+    ASSERT_FALSE( table.contains( "5" ) );
+    ASSERT_THROW( table.max_load_factor( 0.f ), std::invalid_argument );
+}
+
+TEST(CowHashTbl, SnapshotsKeepTheirContents)
+{
+    ac::CowHashTbl<int, int> table;
+    for ( int i{0}; i < 1000; ++i )
+        table.insert( i, i );
+
+    auto before = table.snapshot();
+    ASSERT_TRUE( table.shared() );
+    ASSERT_TRUE( before.shared() );
+
+    table.insert( 5, -5 );   // Replace
+    table.insert( 5000, 1 ); // Insert
+    table.erase( 7 );        // Erase
+    ASSERT_FALSE( table.shared() ); // The first write took its own directory.
+
+    ASSERT_EQ( before.size(), 1000u );
+    ASSERT_EQ( before.at( 5 ), 5 );
+    ASSERT_FALSE( before.contains( 5000 ) );
+    ASSERT_TRUE( before.contains( 7 ) );
+    ASSERT_EQ( table.at( 5 ), -5 );
+    ASSERT_TRUE( table.contains( 5000 ) );
+    ASSERT_FALSE( table.contains( 7 ) );
+
+    // Growth rebuilds the table; the snapshot still has the old buckets.
+    auto buckets = before.bucket_count();
+    for ( int i{1000}; i < 5000; ++i )
+        table.insert( i, i );
+    ASSERT_GT( table.bucket_count(), buckets );
+    ASSERT_EQ( before.bucket_count(), buckets );
+    ASSERT_EQ( before.size(), 1000u );
+    long sum{0};
+    before.for_each( [&sum]( const int &, const int &data ) { sum += data; } );
+    ASSERT_EQ( sum, 999L * 1000 / 2 );
+
+    // Writing to the snapshot does not change the table either.
+    before.clear();
+    ASSERT_TRUE( before.empty() );
+    ASSERT_EQ( table.size(), 5000u );
+
+    // Assignment shares too, and a copy of a copy is a snapshot of the same state.
+    ac::CowHashTbl<int, int> other;
+    other = table;
+    auto chained = other;
+    other.erase( 0 );
+    ASSERT_TRUE( chained.contains( 0 ) );
+    ASSERT_TRUE( table.contains( 0 ) );
+}
+
+TEST(CowHashTbl, AccountKeys)
+{
+    ac::CowHashTbl<Account::AcctKey, Account, KeyHash, KeyEqual> table;
+    Account acct( "Alex Bastos", 1, 1668, 54321, 1500.f );
+    table.insert( acct.getKey(), acct );
+    auto view = table.snapshot();
+    acct.m_balance = 0.f;
+    table.insert( acct.getKey(), acct );
+    ASSERT_EQ( view.at( acct.getKey() ).m_balance, 1500.f );
+    ASSERT_EQ( table.at( acct.getKey() ).m_balance, 0.f );
+}
+
+TEST(CowHashTbl, ReportersReadConsistentViews)
+{
+    // The writer publishes snapshots; the reporter checks each one is a whole state: keys
+    // 0..n-1, each holding n (every write bumps all data at once, key by key).
+    ac::CowHashTbl<int, int> table;
+    std::mutex latest_mutex;
+    ac::CowHashTbl<int, int> latest;
+    std::atomic<bool> done{false};
+
+    std::thread reporter( [&] {
+        int checked{0};
+        while ( !done.load() || checked == 0 ) {
+            ac::CowHashTbl<int, int> view;
+            {
+                std::lock_guard lock( latest_mutex );
+                view = latest;
+            }
+            const int n = static_cast<int>(view.size());
+            view.for_each( [n]( const int &key, const int &data ) {
+                ASSERT_LT( key, n );
+                ASSERT_EQ( data, n );
+            } );
+            ++checked;
+        }
+    } );
+
+    for ( int n{1}; n <= 200; ++n ) {
+        for ( int key{0}; key < n; ++key )
+            table.insert( key, n );
+        std::lock_guard lock( latest_mutex );
+        latest = table;
+    }
+    done = true;
+    reporter.join();
+}
@@ -0,0 +1,84 @@
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"                  // gtest lib
+#include "../include/filtered_hashtbl.h"  // header file for tested functions
+#include "../include/hash_functors.h"     // string_hash
+
+// ============================================================================
+// TESTING THE MEMBERSHIP FILTER AND THE FILTERED TABLE
+// ============================================================================
+
+TEST(CountingBloomFilter, NoFalseNegativesAndRemoval)
+{
+    ac::CountingBloomFilter filter( 10000 );
+    ASSERT_GE( filter.capacity(), 10000u );
+    ASSERT_EQ( filter.bytes() % 64, 0u );
+    ASSERT_EQ( filter.estimated_fpr(), 0.0 );
+
+    for ( std::uint64_t h{0}; h < 10000; ++h )
+        filter.insert( h );
+    for ( std::uint64_t h{0}; h < 10000; ++h )
+        ASSERT_TRUE( filter.may_contain( h ) );
+
+    std::size_t false_positives{0};
+    for ( std::uint64_t h{10000}; h < 110000; ++h )
+        false_positives += filter.may_contain( h );
+    double fpr = false_positives / 100000.0;
+    ASSERT_LT( fpr, 0.03 );
+    ASSERT_NEAR( filter.estimated_fpr(), fpr, 0.01 );
+
+    // Removing every value empties the filter again.
+    for ( std::uint64_t h{0}; h < 10000; ++h )
+        filter.remove( h );
+    ASSERT_EQ( filter.estimated_fpr(), 0.0 );
+    ASSERT_FALSE( filter.may_contain( 7 ) );
+}
+
+TEST(FilteredHashTbl, AgreesWithTheTableThroughUpdates)
+{
+    ac::FilteredHashTbl<int, int> table;
+    for ( int i{0}; i < 20000; ++i )
+        ASSERT_TRUE( table.insert( i, i ) ); // Outgrows the filter several times.
+    ASSERT_FALSE( table.insert( 5, 50 ) );
+    ASSERT_EQ( table.at( 5 ), 50 );
+    ASSERT_GE( table.filter_capacity(), table.size() );
+
+    table[20000] = 7;
+    ASSERT_EQ( table.size(), 20001u );
+    ASSERT_TRUE( table.erase( 20000 ) );
+    ASSERT_FALSE( table.erase( 20000 ) );
+
+    ASSERT_EQ( table.erase_if( []( const int &k, const int & ) { return k % 2 == 1; } ), 10000u );
+    for ( int i{0}; i < 20000; ++i ) {
+        int v{-1};
+        ASSERT_EQ( table.retrieve( i, v ), i % 2 == 0 );
+        ASSERT_EQ( table.contains( i ), table.table().contains( i ) );
+    }
+    ASSERT_EQ( table.find( 3 ), nullptr );
+    ASSERT_THROW( table.at( 3 ), std::out_of_range );
+
+    table.rehash( 5 );
+    for ( int i{0}; i < 20000; i += 2 )
+        ASSERT_NE( table.find( i ), nullptr );
+
+    table.clear();
+    ASSERT_TRUE( table.empty() );
+    ASSERT_FALSE( table.contains( 0 ) );
+    ASSERT_EQ( table.stats().filter_fpr, 0.0 );
+}
+
+TEST(FilteredHashTbl, StatsReportTheFilter)
+{
+    ac::FilteredHashTbl<std::string, int, ac::string_hash, std::equal_to<>> table{ { "ana", 1 }, { "bia", 2 } };
+    ASSERT_TRUE( table.contains( std::string_view( "ana" ) ) );
+    ASSERT_FALSE( table.contains( std::string_view( "caio" ) ) );
+
+    table.reserve( 100000 );
+    for ( int i{0}; i < 100000; ++i )
+        table.insert( "customer-" + std::to_string( i ), i );
+    auto s = table.stats();
+    ASSERT_GT( s.filter_bytes, 0u );
+    ASSERT_GT( s.filter_fpr, 0.0 );
+    ASSERT_LT( s.filter_fpr, 0.03 );
+}
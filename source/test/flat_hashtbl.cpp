@@ -0,0 +1,197 @@
+#include <array>
+#include <map>
+#include <random>
+
+#include "gtest/gtest.h"             // gtest lib
+#include "../include/flat_hashtbl.h" // header file for tested functions
+#include "../driver/account.h"       // To get the account class
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class FlatHTTest : public ::testing::Test {
+    public:
+        std::array<Account, 8> m_accounts; //!< our fixed account data base
+
+        /// This is the hash table we use in the tests.
+        ac::FlatHashTbl< Account::AcctKey, Account, KeyHash, KeyEqual > ht_accounts{ 4 };
+
+    protected:
+        void SetUp() override {
+            m_accounts[0] = {"Alex Bastos", 1, 1668, 54321, 1500.f};
+            m_accounts[1] = {"Aline Souza", 1, 1668, 45794, 530.f};
+            m_accounts[2] = {"Cristiano Ronaldo", 13, 557, 87629, 150000.f};
+            m_accounts[3] = {"Jose Lima", 18, 331, 1231, 850.f};
+            m_accounts[4] = {"Saulo Cunha", 116, 666, 1, 5490.f};
+            m_accounts[5] = {"Lima Junior", 12, 123, 5671, 150.f};
+            m_accounts[6] = {"Carlito Pardo", 28, 506, 9816, 50.f};
+            m_accounts[7] = {"Januario Medeiros", 17, 324, 7777, 4850.f};
+        }
+
+        void insert_accounts() {
+            for( auto & e : m_accounts )
+                ht_accounts.insert( e.getKey(), e );
+        }
+};
+
+// ============================================================================
+// TESTING FLAT (ROBIN HOOD) HASH TABLE
+// ============================================================================
+
+TEST_F(FlatHTTest, InitialState)
+{
+    ASSERT_TRUE( ht_accounts.empty() );
+    ASSERT_EQ( ht_accounts.size(), 0 );
+}
+
+TEST_F(FlatHTTest, InsertingData)
+{
+    Account temp;
+    size_t i(0);
+    for( auto & e : m_accounts )
+    {
+        ASSERT_TRUE( ht_accounts.insert( e.getKey(), e ) );
+        ASSERT_EQ( ++i, ht_accounts.size() );
+        ASSERT_TRUE( ht_accounts.retrieve( e.getKey(), temp ) );
+        ASSERT_EQ( temp, e );
+    }
+    // Every account must still be there after the table grew.
+    for( auto & e : m_accounts )
+        ASSERT_EQ( ht_accounts.at(e.getKey()), e );
+}
+
+TEST_F(FlatHTTest, InsertExisting)
+{
+    insert_accounts();
+    auto acct = m_accounts[2];
+    acct.m_balance = 40000000.f;
+    ASSERT_FALSE( ht_accounts.insert( acct.getKey(), acct ) );
+    ASSERT_EQ( ht_accounts.size(), m_accounts.size() );
+    ASSERT_EQ( ht_accounts.at( acct.getKey() ).m_balance, 40000000.f );
+}
+
+TEST_F(FlatHTTest, OperatorSquareBrakets)
+{
+    std::map<std::string, size_t> expected;
+    ac::FlatHashTbl<std::string, size_t> word_map;
+    for (const auto &w : { "this", "sentence", "is", "not", "a", "sentence",
+                           "this", "sentence", "is", "a", "hoax"})
+    {
+        ++word_map[w];
+        ++expected[w];
+    }
+
+    ASSERT_EQ( expected.size(), word_map.size() );
+    for (const auto &pair : expected )
+        ASSERT_EQ( pair.second, word_map[pair.first] );
+}
+
+TEST_F(FlatHTTest, AtException)
+{
+    ac::FlatHashTbl<std::string, size_t> word_map;
+    ASSERT_THROW( word_map.at("hoax"), std::out_of_range );
+}
+
+TEST_F(FlatHTTest, CopyAndAssignment)
+{
+    ac::FlatHashTbl<char, int> htable {{'a', 27}, {'b', 3}, {'c', 1}};
+    ac::FlatHashTbl<char, int> copy( htable );
+    ac::FlatHashTbl<char, int> assigned;
+    assigned = htable;
+    htable.clear();
+
+    std::map<char, int> expected {{'a', 27}, {'b', 3}, {'c', 1}};
+    for( const auto &e : expected )
+    {
+        int data;
+        ASSERT_TRUE( copy.retrieve( e.first, data ) );
+        ASSERT_EQ( e.second, data );
+        ASSERT_TRUE( assigned.retrieve( e.first, data ) );
+        ASSERT_EQ( e.second, data );
+        ASSERT_EQ( htable.count( e.first ), 0 );
+    }
+    ASSERT_EQ( copy.size(), expected.size() );
+
+    assigned = {{'x', 2}};
+    ASSERT_EQ( assigned.size(), 1 );
+    ASSERT_EQ( assigned.count('x'), 1 );
+    ASSERT_EQ( assigned.count('a'), 0 );
+}
+
+TEST_F(FlatHTTest, EraseExisting)
+{
+    insert_accounts();
+    for( auto & e : m_accounts )
+    {
+        ASSERT_TRUE( ht_accounts.erase( e.getKey() ) );
+        ASSERT_FALSE( ht_accounts.erase( e.getKey() ) );
+        ASSERT_EQ( ht_accounts.count( e.getKey() ), 0 );
+    }
+    ASSERT_TRUE( ht_accounts.empty() );
+}
+
+TEST_F(FlatHTTest, MaxLoadFactor)
+{
+    ac::FlatHashTbl<int, int> htable;
+    htable.max_load_factor( 0.5f );
+    for ( int i{0}; i < 100; ++i )
+        htable.insert( i, i );
+    ASSERT_LE( htable.size(), htable.capacity() * 0.5f );
+    ASSERT_THROW( htable.max_load_factor( 1.f ), std::invalid_argument );
+}
+
+TEST_F(FlatHTTest, RandomizedAgainstMap)
+{
+    // Mixes inserts and erases so that backward shifts cross the end of the array.
+    ac::FlatHashTbl<int, int> htable( 8 );
+    std::map<int, int> expected;
+    std::mt19937 rng( 2023 );
+    std::uniform_int_distribution<int> key_dist( 0, 500 );
+
+    for ( int i{0}; i < 20000; ++i )
+    {
+        auto key = key_dist( rng );
+        if ( rng() % 3 == 0 )
+            ASSERT_EQ( htable.erase( key ), expected.erase( key ) == 1 );
+        else
+            ASSERT_EQ( htable.insert( key, i ), expected.insert_or_assign( key, i ).second );
+    }
+
+    ASSERT_EQ( htable.size(), expected.size() );
+    for ( int key{0}; key <= 500; ++key )
+    {
+        int data;
+        auto it = expected.find( key );
+        ASSERT_EQ( htable.retrieve( key, data ), it != expected.end() );
+        if ( it != expected.end() ) {
+            ASSERT_EQ( data, it->second );
+        }
+    }
+}
+
+TEST(FlatHashTbl, FailedInsertLeavesTheTableUnchanged)
+{
+    // Keys below 1000 all share one hash: their cluster eventually overflows the probe distance.
+    struct ClusterHash {
+        std::size_t operator()( int key ) const { return key < 1000 ? 42 : std::hash<int>()( key ); }
+    };
+    ac::FlatHashTbl<int, int, ClusterHash> htable( 8 );
+    for ( int key{1000}; key < 1040; ++key )
+        htable.insert( key, key ); // Residents the cluster displaces as it grows.
+
+    int key{0};
+    try {
+        for ( ; key < 1000; ++key )
+            htable.insert( key, key );
+        FAIL() << "the probe distance never overflowed";
+    } catch ( const std::length_error & ) {
+    }
+
+    ASSERT_EQ( htable.size(), 40u + key );
+    ASSERT_EQ( htable.count( key ), 0u );
+    for ( int k{0}; k < key; ++k )
+        ASSERT_EQ( htable.at( k ), k );
+    for ( int k{1000}; k < 1040; ++k )
+        ASSERT_EQ( htable.at( k ), k );
+}
@@ -0,0 +1,78 @@
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"                // gtest lib
+#include "../include/frozen_hashtbl.h"  // header file for tested functions
+#include "../driver/account.h"
+
+// ============================================================================
+// TESTING THE FROZEN (MINIMAL PERFECT HASH) TABLE
+// ============================================================================
+
+TEST(FrozenHashTbl, LookupsMatchTheSourceTable)
+{
+    ac::HashTbl<std::string, int> table;
+    for ( int i{0}; i < 50000; ++i )
+        table.insert( "key" + std::to_string( i ), i );
+
+    auto frozen = ac::freeze( table );
+    ASSERT_EQ( frozen.size(), table.size() );
+    for ( int i{0}; i < 50000; ++i ) {
+        int v{-1};
+        ASSERT_TRUE( frozen.retrieve( "key" + std::to_string( i ), v ) );
+        ASSERT_EQ( v, i );
+    }
+    for ( int i{50000}; i < 51000; ++i )
+        ASSERT_FALSE( frozen.contains( "key" + std::to_string( i ) ) );
+    ASSERT_THROW( frozen.at( "missing" ), std::out_of_range );
+    ASSERT_EQ( frozen.count( "key7" ), 1u );
+    ASSERT_LE( frozen.bits_per_key(), 8.1 );
+
+    // Every element exactly once: the slots are a permutation.
+    std::set<int> seen;
+    frozen.for_each( [&seen]( const std::string &, const int &v ) { seen.insert( v ); } );
+    ASSERT_EQ( seen.size(), 50000u );
+}
+
+TEST(FrozenHashTbl, SmallAndEmptySets)
+{
+    ac::HashTbl<int, int> table;
+    ac::FrozenHashTbl<int, int> empty( table );
+    ASSERT_TRUE( empty.empty() );
+    ASSERT_FALSE( empty.contains( 1 ) );
+    ASSERT_THROW( empty.at( 1 ), std::out_of_range );
+
+    for ( int n{1}; n <= 40; ++n ) {
+        table.insert( n * 7, n );
+        auto frozen = ac::freeze( table );
+        ASSERT_EQ( frozen.size(), static_cast<std::size_t>( n ) );
+        for ( int k{1}; k <= n; ++k )
+            ASSERT_EQ( frozen.at( k * 7 ), k );
+        ASSERT_FALSE( frozen.contains( 0 ) );
+    }
+}
+
+TEST(FrozenHashTbl, AccountKeys)
+{
+    ac::HashTbl<Account::AcctKey, Account, KeyHash, KeyEqual> table;
+    Account acct( "Alex Bastos", 1, 1668, 54321, 1500.f );
+    Account other( "Aline Souza", 1, 1668, 45794, 530.f );
+    table.insert( acct.getKey(), acct );
+    table.insert( other.getKey(), other );
+
+    auto frozen = ac::freeze( table );
+    ASSERT_EQ( frozen.at( other.getKey() ).m_balance, 530.f );
+    table.erase( acct.getKey() ); // The frozen copy does not follow.
+    ASSERT_TRUE( frozen.contains( acct.getKey() ) );
+}
+
+TEST(FrozenHashTbl, IdenticalHashesAreRejected)
+{
+    struct ConstantHash {
+        std::size_t operator()( int ) const { return 42; }
+    };
+    ac::HashTbl<int, int, ConstantHash> table;
+    table.insert( 1, 1 );
+    table.insert( 2, 2 );
+    ASSERT_THROW( ac::freeze( table ), std::invalid_argument );
+}
@@ -0,0 +1,85 @@
+#include <map>
+#include <set>
+
+#include "gtest/gtest.h"             // gtest lib
+#include "../include/hashtbl.h"      // header file for tested functions
+#include "../include/hash_policy.h"
+
+// ============================================================================
+// TESTING BUCKET INDEX POLICIES
+// ============================================================================
+
+TEST(IndexPolicy, PrimeTableIsSortedAndPrime)
+{
+    const auto &primes = ac::detail::PRIMES;
+    for ( size_t i{1}; i < primes.size(); ++i )
+        ASSERT_LT( primes[i-1], primes[i] );
+    // Spot-check primality of the small entries by trial division.
+    for ( auto p : primes ) {
+        if ( p > 100000 ) break;
+        for ( std::uint64_t d{2}; d * d <= p; ++d )
+            ASSERT_NE( p % d, 0u ) << p << " is divisible by " << d;
+    }
+}
+
+TEST(IndexPolicy, PrimeResetRoundsUp)
+{
+    ac::prime_index_policy policy;
+    ASSERT_EQ( policy.reset( 9 ), 11u );
+    ASSERT_EQ( policy.reset( 11 ), 11u );
+    ASSERT_EQ( policy.reset( 22 ), 23u );
+    ASSERT_EQ( policy.bucket_count(), 23u );
+    // The constant-divisor modulo must agree with the plain one.
+    for ( std::size_t h : { 0ul, 1ul, 22ul, 23ul, 1000003ul, ~0ul } )
+        ASSERT_EQ( policy.index( h ), h % 23 );
+}
+
+TEST(IndexPolicy, Power2AndFastRangeStayInRange)
+{
+    ac::power2_index_policy mask;
+    ac::fast_range_index_policy range;
+    ASSERT_EQ( mask.reset( 100 ), 128u );
+    ASSERT_EQ( range.reset( 100 ), 128u );
+
+    // Consecutive integers (identity std::hash) must still spread over the buckets.
+    std::set<std::size_t> used_mask, used_range;
+    for ( std::size_t h{0}; h < 1024; ++h ) {
+        auto i = mask.index( h );
+        auto j = range.index( h );
+        ASSERT_LT( i, 128u );
+        ASSERT_LT( j, 128u );
+        used_mask.insert( i );
+        used_range.insert( j );
+    }
+    ASSERT_GT( used_mask.size(), 120u );
+    ASSERT_GT( used_range.size(), 120u );
+}
+
+template <class Policy>
+class PolicyHashTbl : public ::testing::Test {};
+using Policies = ::testing::Types< ac::prime_index_policy, ac::power2_index_policy, ac::fast_range_index_policy >;
+TYPED_TEST_SUITE(PolicyHashTbl, Policies);
+
+TYPED_TEST(PolicyHashTbl, InsertRetrieveErase)
+{
+    ac::HashTbl<int, int, std::hash<int>, std::equal_to<int>, TypeParam> htable( 2 );
+    std::map<int, int> expected;
+    for ( int i{0}; i < 500; ++i ) {
+        ASSERT_TRUE( htable.insert( i * 31, i ) );
+        expected[i * 31] = i;
+    }
+    for ( int i{0}; i < 500; i += 2 ) {
+        ASSERT_TRUE( htable.erase( i * 31 ) );
+        expected.erase( i * 31 );
+    }
+
+    ASSERT_EQ( htable.size(), expected.size() );
+    for ( int i{0}; i < 500; ++i ) {
+        int data{-1};
+        auto it = expected.find( i * 31 );
+        ASSERT_EQ( htable.retrieve( i * 31, data ), it != expected.end() );
+        if ( it != expected.end() ) {
+            ASSERT_EQ( data, it->second );
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"                // gtest lib
+#include "../include/hash_quality.h"    // header file for tested functions
+#include "../include/hash_functors.h"
+#include "../driver/account.h"          // To get the account class
+
+// ============================================================================
+// TESTING THE HASH QUALITY ANALYZER AND THE ACCOUNT HASH
+// ============================================================================
+
+TEST(HashQuality, HistogramAccountsForEveryBucketAndKey)
+{
+    std::vector<int> keys;
+    for ( int i{0}; i < 1000; ++i )
+        keys.push_back( i );
+    auto r = ac::analyze_hash( keys, 100, std::hash<int>{} );
+
+    ASSERT_EQ( r.keys, 1000u );
+    ASSERT_EQ( r.buckets, 131u ); // Rounded up by prime_index_policy.
+    ASSERT_EQ( r.distinct_hashes, 1000u );
+    size_t buckets{0}, keys_seen{0};
+    for ( size_t k{0}; k < r.histogram.size(); ++k ) {
+        buckets += r.histogram[k];
+        keys_seen += k * r.histogram[k];
+    }
+    ASSERT_EQ( buckets, r.buckets );
+    ASSERT_EQ( keys_seen, r.keys );
+}
+
+TEST(HashQuality, DetectsPoorHashes)
+{
+    std::vector<int> keys;
+    for ( int i{0}; i < 4096; ++i )
+        keys.push_back( i * 64 );
+
+    // std::hash<int> is the identity: no avalanche at all, unlike a mixed hash.
+    auto identity = ac::analyze_hash<ac::prime_index_policy>( keys, 4096, std::hash<int>{} );
+    auto mixed = ac::analyze_hash<ac::prime_index_policy>( keys, 4096, []( int k ) { return ac::hash_mix( k ); } );
+
+    // One input bit flips one output bit of the identity.
+    ASSERT_LT( identity.avalanche_mean, 0.05 );
+    ASSERT_NEAR( mixed.avalanche_mean, 0.5, 0.02 );
+    ASSERT_LT( mixed.avalanche_worst, 0.05 );
+    ASSERT_LT( std::abs( mixed.chi_square_z ), 4.0 );
+}
+
+TEST(HashQuality, AccountHashSeparatesSwappedFields)
+{
+    KeyHash hash;
+    ASSERT_NE( hash( Account::AcctKey{ "Alex", 1, 1668, 54321 } ), hash( Account::AcctKey{ "Alex", 1668, 1, 54321 } ) );
+    ASSERT_NE( hash( Account::AcctKey{ "Alex", 1, 2, 3 } ), hash( Account::AcctKey{ "Alex", 3, 2, 1 } ) );
+    // Key and key view still agree.
+    Account acct{ "Alex Bastos", 1, 1668, 54321, 1500.f };
+    ASSERT_EQ( hash( acct.getKey() ), hash( acct.getKeyView() ) );
+
+    // Dense account numbers in a few branches: no full-hash collisions, near-uniform buckets.
+    std::vector<Account::AcctKey> keys;
+    for ( int branch{1}; branch <= 16; ++branch )
+        for ( int number{0}; number < 1000; ++number )
+            keys.emplace_back( "Client", 1 + branch % 3, branch, number );
+    auto r = ac::analyze_hash( keys, keys.size(), hash, 200 );
+    ASSERT_EQ( r.distinct_hashes, keys.size() );
+    ASSERT_LT( std::abs( r.chi_square_z ), 4.0 );
+    ASSERT_NEAR( r.avalanche_mean, 0.5, 0.05 );
+}
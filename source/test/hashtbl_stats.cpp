@@ -0,0 +1,115 @@
+// Built into its own executable, run_stats_tests, with AC_HASHTBL_STATS=1: every translation
+// unit of a program must agree on the macro, and run_tests keeps the default (off).
+#include <string>
+
+#include "gtest/gtest.h"               // gtest lib
+#include "../include/hashtbl.h"        // header file for tested functions
+#include "../include/filtered_hashtbl.h"
+
+// ============================================================================
+// TESTING THE HASHTBL STATISTICS (COUNTERS ENABLED)
+// ============================================================================
+
+namespace {
+    // Puts key N at hash N: with 11 buckets, keys N, N+11, N+22... share a chain.
+    struct IdentityHash {
+        size_t operator()( int key ) const { return static_cast<size_t>( key ); }
+    };
+}
+
+TEST(HashTblStats, CountsProbesPerHitAndMiss)
+{
+    static_assert( AC_HASHTBL_STATS == 1 );
+    ac::HashTbl<int, int, IdentityHash> table( 11 );
+    table.max_load_factor( 10 );
+    for ( int i{0}; i < 4; ++i )
+        table.insert( 11 * i, i ); // One chain of 4: 33, 22, 11, 0 (newest first).
+
+    int d;
+    ASSERT_TRUE( table.retrieve( 33, d ) ); // 1 probe
+    ASSERT_TRUE( table.contains( 0 ) );     // 4 probes
+    ASSERT_FALSE( table.contains( 44 ) );   // 4 probes
+    ASSERT_FALSE( table.contains( 1 ) );    // 0 probes: empty bucket
+
+    auto s = table.stats();
+    ASSERT_TRUE( s.counters_enabled );
+    ASSERT_EQ( s.hits, 2u );
+    ASSERT_EQ( s.hit_probes, 5u );
+    ASSERT_DOUBLE_EQ( s.probes_per_hit(), 2.5 );
+    ASSERT_EQ( s.misses, 2u );
+    ASSERT_DOUBLE_EQ( s.probes_per_miss(), 2.0 );
+
+    // Batched lookups count too.
+    int keys[] = { 0, 5 };
+    int out[2];
+    table.retrieve_batch( keys, 2, out, nullptr );
+    s = table.stats();
+    ASSERT_EQ( s.hits, 3u );
+    ASSERT_EQ( s.misses, 3u );
+
+    table.reset_stats();
+    s = table.stats();
+    ASSERT_EQ( s.hits + s.misses + s.hit_probes + s.miss_probes, 0u );
+}
+
+TEST(HashTblStats, CountsRehashes)
+{
+    ac::HashTbl<int, int> table;
+    ASSERT_EQ( table.stats().rehashes, 0u );
+    size_t buckets = table.bucket_count(), growths{0};
+    for ( int i{0}; i < 1000; ++i ) {
+        table.insert( i, i );
+        if ( table.bucket_count() != buckets ) {
+            buckets = table.bucket_count();
+            ++growths;
+        }
+    }
+    auto s = table.stats();
+    ASSERT_GT( growths, 0u );
+    ASSERT_EQ( s.rehashes, growths );
+    ASSERT_GT( s.rehash_time.count(), 0 );
+
+    table.rehash( 5000 );
+    ASSERT_EQ( table.stats().rehashes, growths + 1 );
+
+    // A copy starts its own history.
+    ac::HashTbl<int, int> copy{ table };
+    ASSERT_EQ( copy.stats().rehashes, 0u );
+    ASSERT_EQ( copy.stats().max_chain, table.stats().max_chain );
+}
+
+TEST(HashTblStats, IncrementalRehashIsTimedToo)
+{
+    ac::HashTbl<int, int> table;
+    table.rehash_step( 1 );
+    for ( int i{0}; i < 200; ++i )
+        table.insert( i, i );
+    auto s = table.stats();
+    ASSERT_GT( s.rehashes, 0u );
+    ASSERT_GT( s.rehash_time.count(), 0 );
+    // Chains of the old array, not moved yet, are in the histogram.
+    size_t elements{0};
+    for ( size_t k{0}; k < s.chain_histogram.size(); ++k )
+        elements += k * s.chain_histogram[k];
+    ASSERT_EQ( elements, table.size() );
+}
+
+TEST(HashTblStats, CountsFilterRejectionsAndFalsePositives)
+{
+    ac::FilteredHashTbl<int, int> table;
+    for ( int i{0}; i < 10000; ++i )
+        table.insert( i, i );
+
+    for ( int i{0}; i < 110000; ++i )
+        table.contains( i );
+    auto s = table.stats();
+    ASSERT_EQ( s.hits, 10000u );                    // The table only sees what the filter lets through,
+    ASSERT_EQ( s.misses, s.filter_false_positives ); // so its misses are the filter's false positives.
+    ASSERT_EQ( s.filter_rejects + s.filter_false_positives, 100000u );
+    ASSERT_LT( s.observed_filter_fpr(), 0.03 );
+    ASSERT_NEAR( s.observed_filter_fpr(), s.filter_fpr, 0.01 );
+
+    table.reset_stats();
+    s = table.stats();
+    ASSERT_EQ( s.filter_rejects + s.filter_false_positives + s.hits, 0u );
+}
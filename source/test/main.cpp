@@ -3,9 +3,17 @@
 #include <algorithm>            // std::min_element
 #include <array>
 #include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "gtest/gtest.h"        // gtest lib
 #include "../include/hashtbl.h"   // header file for tested functions
+#include "../include/hash_functors.h"
+#include "../include/parallel_hashtbl.h"
 #include "../driver/account.h"  // To get the account class
 
 // ============================================================================
@@ -547,8 +555,545 @@ TEST_F(HTTest, Count)
     //std::cout << "The table: \n" << htable << std::endl;
 }
 
+TEST_F(HTTest, IncrementalRehash)
+{
+    ac::HashTbl<int, int> htable (2);
+    htable.rehash_step( 1 );
+    ASSERT_EQ( htable.rehash_step(), 1 );
+
+    bool saw_rehashing{false};
+    for ( int i{0}; i < 1000; ++i )
+    {
+        ASSERT_TRUE( htable.insert( i, i * 10 ) );
+        saw_rehashing = saw_rehashing or htable.rehashing();
+
+        // Every key must be reachable, whichever array it is in right now.
+        if ( i % 50 == 0 )
+            for ( int k{0}; k <= i; ++k )
+            {
+                int data;
+                ASSERT_TRUE( htable.retrieve( k, data ) );
+                ASSERT_EQ( data, k * 10 );
+            }
+    }
+    ASSERT_TRUE( saw_rehashing );
+    ASSERT_EQ( htable.size(), 1000 );
+
+    // Erase, update and copy while a migration may be in progress.
+    for ( int i{0}; i < 1000; i += 2 )
+        ASSERT_TRUE( htable.erase( i ) );
+    for ( int i{1}; i < 1000; i += 2 )
+        htable[i] += 1;
+    ac::HashTbl<int, int> copy( htable );
+
+    for ( int i{0}; i < 1000; ++i )
+    {
+        int data;
+        ASSERT_EQ( htable.retrieve( i, data ), i % 2 == 1 );
+        ASSERT_EQ( copy.retrieve( i, data ), i % 2 == 1 );
+        if ( i % 2 == 1 ) {
+            ASSERT_EQ( data, i * 10 + 1 );
+        }
+    }
+
+    // Going back to stop-the-world mode finishes the migration.
+    htable.rehash_step( 0 );
+    ASSERT_FALSE( htable.rehashing() );
+    ASSERT_EQ( htable.size(), 500 );
+    htable.clear();
+    ASSERT_TRUE( htable.empty() );
+}
+
+/// Counts copies, to prove that emplacing and rehashing never copy entries.
+struct CopyCounter {
+    static int copies;
+    int value;
+    CopyCounter( int v = 0 ) : value{v} {}
+    CopyCounter( const CopyCounter & o ) : value{o.value} { ++copies; }
+    CopyCounter( CopyCounter && o ) noexcept : value{o.value} {}
+    CopyCounter& operator=( const CopyCounter & o ) { value = o.value; ++copies; return *this; }
+    CopyCounter& operator=( CopyCounter && o ) noexcept { value = o.value; return *this; }
+};
+int CopyCounter::copies = 0;
+
+TEST_F(HTTest, EmplaceMoveOnlyData)
+{
+    // unique_ptr data does not compile if any of these paths copies.
+    ac::HashTbl<int, std::unique_ptr<int>> htable (2);
+    for ( int i{0}; i < 200; ++i )
+        ASSERT_TRUE( htable.try_emplace( i, new int{i} ) );
+    ASSERT_FALSE( htable.try_emplace( 7, std::make_unique<int>(-1) ) ); // Existing key: unchanged.
+    ASSERT_TRUE( htable.emplace( 500, std::make_unique<int>(500) ) );
+    ASSERT_FALSE( htable.emplace( 500, std::make_unique<int>(-1) ) );
+    ASSERT_TRUE( htable.insert( ac::HashEntry<int, std::unique_ptr<int>>( 501, std::make_unique<int>(501) ) ) );
+    ASSERT_FALSE( htable.insert_or_assign( 501, std::make_unique<int>(502) ) );
+
+    ASSERT_EQ( htable.size(), 202 );
+    for ( int i{0}; i < 200; ++i )
+        ASSERT_EQ( *htable.at( i ), i );
+    ASSERT_EQ( *htable.at( 500 ), 500 );
+    ASSERT_EQ( *htable.at( 501 ), 502 );
+}
+
+TEST_F(HTTest, RehashRelinksWithoutCopies)
+{
+    ac::HashTbl<int, CopyCounter> htable (2);
+    CopyCounter::copies = 0;
+
+    // Every one of these insertions (and the rehashes they trigger) must build data in place.
+    for ( int i{0}; i < 1000; ++i )
+        htable.try_emplace( i, i );
+    for ( int i{1000}; i < 1100; ++i )
+        htable.insert_or_assign( i, CopyCounter{i} );
+    ASSERT_EQ( CopyCounter::copies, 0 );
+
+    // References handed out by operator[] survive later rehashes.
+    auto &first = htable[0];
+    for ( int i{1100}; i < 5000; ++i )
+        htable[i].value = i;
+    ASSERT_EQ( &first, &htable.at( 0 ) );
+    ASSERT_EQ( CopyCounter::copies, 0 );
+    ASSERT_EQ( htable.size(), 5000 );
+}
+
+TEST_F(HTTest, TryEmplaceDoesNotConsumeArguments)
+{
+    ac::HashTbl<std::string, std::string> htable;
+    std::string key{"key"}, value{"value"};
+    ASSERT_TRUE( htable.try_emplace( std::move(key), std::move(value) ) );
+
+    std::string other{"other"};
+    ASSERT_FALSE( htable.try_emplace( "key", std::move(other) ) );
+    ASSERT_EQ( other, "other" ); // Key existed: the argument was not moved from.
+    ASSERT_EQ( htable.at( "key" ), "value" );
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
+
+TEST_F(HTTest, TransparentAccountLookup)
+{
+    insert_accounts();
+
+    // Probe with key views: the client names are never copied.
+    for( auto & e : m_accounts )
+    {
+        Account temp;
+        auto view = e.getKeyView();
+        ASSERT_TRUE( ht_accounts.contains( view ) );
+        ASSERT_TRUE( ht_accounts.retrieve( view, temp ) );
+        ASSERT_EQ( temp, e );
+        ASSERT_EQ( ht_accounts.at( view ), e );
+        ASSERT_EQ( ht_accounts.count( view ), ht_accounts.count( e.getKey() ) );
+    }
+
+    Account::AcctKeyView missing{ "Alex Bastos", 1, 1668, 0 };
+    ASSERT_FALSE( ht_accounts.contains( missing ) );
+    ASSERT_THROW( ht_accounts.at( missing ), std::out_of_range );
+    ASSERT_FALSE( ht_accounts.erase( missing ) );
+
+    ASSERT_TRUE( ht_accounts.erase( m_accounts[2].getKeyView() ) );
+    ASSERT_FALSE( ht_accounts.contains( m_accounts[2].getKey() ) );
+    ASSERT_EQ( ht_accounts.size(), m_accounts.size() - 1 );
+}
+
+TEST_F(HTTest, TransparentStringLookup)
+{
+    ac::HashTbl<std::string, size_t, ac::string_hash, std::equal_to<>> word_map;
+    for (const auto &w : { "this", "sentence", "is", "not", "a", "sentence" })
+        ++word_map[w];
+
+    const char *literal = "sentence";
+    std::string_view view{ "is not", 2 };
+    ASSERT_EQ( word_map.at( literal ), 2u );
+    ASSERT_EQ( word_map.at( view ), 1u );
+    size_t n{0};
+    ASSERT_TRUE( word_map.retrieve( "this", n ) );
+    ASSERT_EQ( n, 1u );
+    ASSERT_FALSE( word_map.contains( std::string_view{ "hoax" } ) );
+    ASSERT_TRUE( word_map.erase( view ) );
+    ASSERT_FALSE( word_map.contains( "is" ) );
+
+    // Without transparent functors the same calls still compile, through a temporary key.
+    ac::HashTbl<std::string, size_t> plain;
+    plain["word"] = 1;
+    ASSERT_TRUE( plain.contains( "word" ) );
+    ASSERT_EQ( plain.at( "word" ), 1u );
+}
+
+namespace {
+    // Counts calls, and puts key "kN" at hash 11*N: with 11 buckets, every key collides.
+    struct CountingHash {
+        static inline size_t calls{0};
+        size_t operator()( const std::string &key ) const { ++calls; return 11 * std::stoul( key.substr( 1 ) ); }
+    };
+    struct CountingEqual {
+        static inline size_t calls{0};
+        bool operator()( const std::string &a, const std::string &b ) const { ++calls; return a == b; }
+    };
+}
+
+TEST_F(HTTest, CachedHash)
+{
+    static_assert( ac::cache_hash<std::string>::value );
+    static_assert( ac::cache_hash<Account::AcctKey>::value );
+    static_assert( not ac::cache_hash<int>::value );
+    static_assert( sizeof( ac::HashTbl<int, int>::node_type ) == 2 * sizeof( int ), "no hash stored for int keys" );
+    // Only the chain node carries the hash: the slots of the open-addressing tables stay plain.
+    static_assert( sizeof( ac::HashEntry<std::string, int> ) == sizeof( std::pair<std::string, int> ) );
+    static_assert( sizeof( ac::HashTbl<std::string, int>::node_type ) > sizeof( ac::HashEntry<std::string, int> ) );
+
+    ac::HashTbl<std::string, int, CountingHash, CountingEqual> table;
+    table.max_load_factor( 100 );
+    CountingHash::calls = 0;
+    for ( int i{0}; i < 10; ++i )
+        table.insert( "k" + std::to_string( i ), i );
+    ASSERT_EQ( CountingHash::calls, 10u );
+
+    // All ten keys share bucket 0, but only the right entry reaches KeyEqual.
+    CountingEqual::calls = 0;
+    ASSERT_EQ( table.at( "k7" ), 7 );
+    ASSERT_EQ( CountingEqual::calls, 1u );
+    ASSERT_FALSE( table.contains( "k10" ) );
+    ASSERT_EQ( CountingEqual::calls, 1u );
+
+    // Growing the table reuses the stored hashes.
+    table.max_load_factor( 0 );
+    CountingHash::calls = 0;
+    for ( int i{10}; i < 100; ++i )
+        table.insert( "k" + std::to_string( i ), i );
+    ASSERT_EQ( CountingHash::calls, 90u );
+    for ( int i{0}; i < 100; ++i )
+        ASSERT_EQ( table.at( "k" + std::to_string( i ) ), i );
+}
+
+TEST_F(HTTest, BatchOperations)
+{
+    // More keys than one prefetch window, and enough to rehash during insert_batch.
+    const size_t n{ 100 };
+    std::vector<int> keys, values;
+    for ( size_t i{0}; i < n; ++i ) {
+        keys.push_back( static_cast<int>( 3 * i ) );
+        values.push_back( static_cast<int>( i ) );
+    }
+
+    ac::HashTbl<int, int> table;
+    table.insert( 0, -1 );
+    ASSERT_EQ( table.insert_batch( keys.data(), values.data(), n ), n - 1 );
+    ASSERT_EQ( table.size(), n );
+    ASSERT_EQ( table.at( 0 ), 0 ); // Replaced, as insert() would.
+
+    // Every other probe misses.
+    std::vector<int> probes;
+    for ( size_t i{0}; i < 2 * n; ++i )
+        probes.push_back( static_cast<int>( i % 2 == 0 ? 3 * ( i / 2 ) : 3 * i + 1 ) );
+    std::vector<int> out( probes.size(), -1 );
+    std::unique_ptr<bool[]> found{ new bool[ probes.size() ] };
+    ASSERT_EQ( table.retrieve_batch( probes.data(), probes.size(), out.data(), found.get() ), n );
+    for ( size_t i{0}; i < probes.size(); ++i ) {
+        ASSERT_EQ( found[i], i % 2 == 0 );
+        ASSERT_EQ( out[i], i % 2 == 0 ? static_cast<int>( i / 2 ) : -1 );
+    }
+    // The found flags are optional.
+    ASSERT_EQ( table.retrieve_batch( keys.data(), 1, out.data(), nullptr ), 1u );
+
+    // Duplicates within one batch are erased once.
+    std::vector<int> doomed{ 0, 3, 0, 1, 6 };
+    ASSERT_EQ( table.erase_batch( doomed.data(), doomed.size() ), 3u );
+    ASSERT_EQ( table.size(), n - 3 );
+    ASSERT_FALSE( table.contains( 3 ) );
+    ASSERT_TRUE( table.contains( 9 ) );
+    ASSERT_EQ( table.erase_batch( doomed.data(), 0 ), 0u );
+}
+
+TEST_F(HTTest, ReserveAndRehash)
+{
+    ac::HashTbl<int, int> table;
+    table.reserve( 1000 );
+    auto buckets = table.bucket_count();
+    ASSERT_GT( buckets, 1000u );
+    for ( int i{0}; i < 1000; ++i )
+        table.insert( i, i );
+    ASSERT_EQ( table.bucket_count(), buckets ); // No rehash on the way.
+
+    // reserve() never shrinks; rehash() does, but not below what the elements need.
+    table.reserve( 10 );
+    ASSERT_EQ( table.bucket_count(), buckets );
+    table.rehash( 5000 );
+    ASSERT_GE( table.bucket_count(), 5000u );
+    table.rehash( 0 );
+    ASSERT_GT( table.bucket_count(), 1000u );
+    ASSERT_LE( table.bucket_count(), buckets );
+    for ( int i{0}; i < 1000; ++i )
+        ASSERT_EQ( table.at( i ), i );
+
+    // The number of buckets reserve() picks follows the maximum load factor.
+    ac::HashTbl<int, int> dense;
+    dense.max_load_factor( 3 );
+    dense.reserve( 1000 );
+    buckets = dense.bucket_count();
+    ASSERT_LT( buckets, 1000u );
+    for ( int i{0}; i < 1000; ++i )
+        dense.insert( i, i );
+    ASSERT_EQ( dense.bucket_count(), buckets );
+}
+
+TEST_F(HTTest, BucketIntrospection)
+{
+    ac::HashTbl<int, int> table( 11 );
+    ASSERT_EQ( table.bucket_count(), 11u );
+    ASSERT_EQ( table.load_factor(), 0.f );
+    for ( int i{0}; i < 5; ++i )
+        table.insert( 11 * i + 3, i );
+    ASSERT_EQ( table.bucket_size( table.bucket_count() == 11 ? 3 : 0 ), 5u );
+    ASSERT_FLOAT_EQ( table.load_factor(), 5.f / 11 );
+
+    size_t total{0};
+    for ( size_t b{0}; b < table.bucket_count(); ++b )
+        total += table.bucket_size( b );
+    ASSERT_EQ( total, table.size() );
+}
+
+TEST_F(HTTest, RangeConstructor)
+{
+    std::vector<std::pair<int, std::string>> pairs;
+    for ( int i{0}; i < 500; ++i )
+        pairs.emplace_back( i, std::to_string( i ) );
+    pairs.emplace_back( 7, "seven" ); // A repeated key keeps the last data.
+
+    ac::HashTbl<int, std::string> table( pairs.begin(), pairs.end() );
+    ASSERT_EQ( table.size(), 500u );
+    ASSERT_EQ( table.at( 7 ), "seven" );
+    ASSERT_EQ( table.at( 499 ), "499" );
+    // Sized once for the whole range, at the default load factor.
+    ASSERT_LE( table.load_factor(), 1.f );
+    ac::HashTbl<int, std::string> resized;
+    resized.reserve( pairs.size() );
+    ASSERT_EQ( table.bucket_count(), resized.bucket_count() );
+
+    // Entries, through the range tag, with a minimum number of buckets.
+    std::vector<ac::HashEntry<int, std::string>> entries{ { 1, "one" }, { 2, "two" } };
+    ac::HashTbl<int, std::string> from_entries( ac::from_range, entries, 100 );
+    ASSERT_EQ( from_entries.size(), 2u );
+    ASSERT_GE( from_entries.bucket_count(), 100u );
+    ASSERT_EQ( from_entries.at( 2 ), "two" );
+
+    // Integers still select the size constructor.
+    ac::HashTbl<int, int> sized( 3, std::allocator<ac::HashEntry<int, int>>() );
+    ASSERT_TRUE( sized.empty() );
+
+    // Initializer lists are sized once too, and count repeated keys once.
+    ac::HashTbl<int, int> listed{ { 1, 10 }, { 2, 20 }, { 1, 30 } };
+    ASSERT_EQ( listed.size(), 2u );
+    ASSERT_EQ( listed.at( 1 ), 30 );
+}
+
+TEST_F(HTTest, StatsWithoutCounters)
+{
+    // run_tests is built without AC_HASHTBL_STATS: the chain figures are there, the counters are not.
+    static_assert( AC_HASHTBL_STATS == 0 );
+    ac::HashTbl<int, int> table( 11 );
+    for ( int i{0}; i < 5; ++i )
+        table.insert( 11 * i, i ); // All in bucket 0.
+    table.insert( 1, 1 );
+    ASSERT_TRUE( table.contains( 0 ) );
+
+    auto s = table.stats();
+    ASSERT_FALSE( s.counters_enabled );
+    ASSERT_EQ( s.hits, 0u );
+    ASSERT_EQ( s.max_chain, 5u );
+    ASSERT_DOUBLE_EQ( s.mean_chain, 3.0 ); // 6 elements in 2 chains.
+    ASSERT_EQ( s.chain_histogram.size(), 6u );
+    ASSERT_EQ( s.chain_histogram[0], 9u );
+    ASSERT_EQ( s.chain_histogram[1], 1u );
+    ASSERT_EQ( s.chain_histogram[5], 1u );
+    ASSERT_GE( s.bytes_allocated, 11 * sizeof( ac::HashTbl<int, int>::list_type ) + 6 * sizeof( ac::HashEntry<int, int> ) );
+
+    std::ostringstream os;
+    os << s;
+    ASSERT_NE( os.str().find( "max 5" ), std::string::npos );
+}
+
+TEST_F(HTTest, EraseIf)
+{
+    ac::HashTbl<int, int> table;
+    for ( int i{0}; i < 1000; ++i )
+        table.insert( i, i % 10 );
+
+    // Remove the "closed" accounts in one sweep.
+    auto removed = table.erase_if( []( const int &, const int &data ) { return data < 3; } );
+    ASSERT_EQ( removed, 300u );
+    ASSERT_EQ( table.size(), 700u );
+    for ( int i{0}; i < 1000; ++i )
+        ASSERT_EQ( table.contains( i ), i % 10 >= 3 );
+    ASSERT_EQ( table.erase_if( []( const int &, const int & ) { return false; } ), 0u );
+
+    // Elements still in the old array of an incremental rehash are swept too.
+    ac::HashTbl<int, int> incremental( 11 );
+    incremental.rehash_step( 1 );
+    for ( int i{0}; i < 12; ++i )
+        incremental.insert( i, i );
+    ASSERT_TRUE( incremental.rehashing() );
+    ASSERT_EQ( incremental.erase_if( []( const int &key, const int & ) { return key % 2 == 0; } ), 6u );
+    ASSERT_EQ( incremental.size(), 6u );
+    for ( int i{0}; i < 12; ++i )
+        ASSERT_EQ( incremental.contains( i ), i % 2 == 1 );
+}
+
+TEST_F(HTTest, ShrinkWithHysteresis)
+{
+    ac::HashTbl<int, int> table;
+    ASSERT_EQ( table.min_load_factor(), 0.f );
+    ASSERT_THROW( table.min_load_factor( -1.f ), std::invalid_argument );
+    for ( int i{0}; i < 10000; ++i )
+        table.insert( i, i );
+    auto full = table.bucket_count();
+
+    // Without a minimum load factor, erasing never shrinks the table.
+    table.erase_if( []( const int &key, const int & ) { return key >= 100; } );
+    ASSERT_EQ( table.bucket_count(), full );
+
+    // shrink_to_fit() does on demand.
+    table.shrink_to_fit();
+    ASSERT_LT( table.bucket_count(), full / 10 );
+    for ( int i{0}; i < 100; ++i )
+        ASSERT_TRUE( table.contains( i ) );
+
+    // With one, a purge returns the bucket array at once.
+    ac::HashTbl<int, int> purged;
+    purged.min_load_factor( 0.25f );
+    for ( int i{0}; i < 10000; ++i )
+        purged.insert( i, i );
+    purged.erase_if( []( const int &key, const int & ) { return key >= 100; } );
+    ASSERT_LE( purged.bucket_count(), 1000u );
+    ASSERT_GE( purged.load_factor(), 0.25f );
+
+    // Erasing and inserting around the threshold does not rehash back and forth.
+    auto buckets = purged.bucket_count();
+    for ( int round{0}; round < 50; ++round ) {
+        for ( int i{100}; i < 110; ++i )
+            purged.insert( i, i );
+        for ( int i{100}; i < 110; ++i )
+            ASSERT_TRUE( purged.erase( i ) );
+        ASSERT_EQ( purged.bucket_count(), buckets );
+    }
+
+    // Erasing one by one shrinks in steps, and clear() goes back to a small table.
+    for ( int i{0}; i < 90; ++i )
+        purged.erase( i );
+    ASSERT_LT( purged.bucket_count(), buckets );
+    for ( int i{90}; i < 100; ++i )
+        ASSERT_TRUE( purged.contains( i ) );
+    purged.clear();
+    ASSERT_LE( purged.bucket_count(), 23u );
+}
+
+TEST_F(HTTest, MoveConstructorAndAssignment)
+{
+    ac::HashTbl<int, std::string> table;
+    for ( int i{0}; i < 1000; ++i )
+        table.insert( i, std::to_string( i ) );
+    auto buckets = table.bucket_count();
+
+    // The elements change hands: same buckets, nothing rebuilt.
+    ac::HashTbl<int, std::string> moved( std::move( table ) );
+    ASSERT_EQ( moved.size(), 1000u );
+    ASSERT_EQ( moved.bucket_count(), buckets );
+    ASSERT_EQ( moved.at( 500 ), "500" );
+    // Moved-from: a usable empty table.
+    ASSERT_EQ( table.size(), 0u );
+    ASSERT_GT( table.bucket_count(), 0u );
+    ASSERT_FALSE( table.contains( 500 ) );
+    ASSERT_EQ( table.load_factor(), 0.f );
+    ASSERT_TRUE( table.insert( 7, "seven" ) );
+    std::string seven;
+    ASSERT_TRUE( table.retrieve( 7, seven ) );
+    ASSERT_EQ( seven, "seven" );
+    table = moved;
+    ASSERT_EQ( table.size(), 1000u );
+
+    ac::HashTbl<int, std::string> target{ { 1, "one" } };
+    target = std::move( moved );
+    ASSERT_EQ( target.size(), 1000u );
+    ASSERT_EQ( target.at( 1 ), "1" );
+
+    // Returning a table by value moves it.
+    auto make = [] {
+        ac::HashTbl<int, int> t;
+        t.insert( 1, 1 );
+        return t;
+    };
+    ASSERT_EQ( make().size(), 1u );
+    static_assert( std::is_nothrow_move_constructible_v<ac::HashTbl<int, int>> );
+    static_assert( std::is_nothrow_move_assignable_v<ac::HashTbl<int, int>> );
+
+    // Swapping, and assigning to itself.
+    ac::HashTbl<int, std::string> small{ { 7, "seven" } };
+    swap( small, target );
+    ASSERT_EQ( small.size(), 1000u );
+    ASSERT_EQ( target.size(), 1u );
+    auto &same = target;
+    target = same;
+    ASSERT_EQ( target.at( 7 ), "seven" );
+}
+
+TEST_F(HTTest, ParallelRehashAndBuild)
+{
+    // The whole layout: bucket sizes, then every entry in bucket and chain order.
+    auto layout = []( const ac::HashTbl<std::string, int> &t ) {
+        std::vector<std::string> out;
+        for ( std::size_t b{0}; b < t.bucket_count(); ++b )
+            out.push_back( std::to_string( t.bucket_size( b ) ) );
+        t.for_each( [&out]( const std::string &key, const int &data ) { out.push_back( key + "=" + std::to_string( data ) ); } );
+        return out;
+    };
+
+    std::vector<std::pair<std::string, int>> pairs;
+    for ( int i{0}; i < 20000; ++i )
+        pairs.emplace_back( std::to_string( i % 15000 ), i ); // Repeated keys keep the last data.
+
+    ac::HashTbl<std::string, int> serial( pairs.begin(), pairs.end() );
+    for ( std::size_t threads : { 1u, 3u, 8u } ) {
+        ac::ThreadPool pool( threads );
+        auto parallel = ac::parallel_build<ac::HashTbl<std::string, int>>( pairs, pool );
+        ASSERT_EQ( parallel.size(), 15000u );
+        ASSERT_EQ( layout( parallel ), layout( serial ) );
+
+        ac::HashTbl<std::string, int> grown_serial( serial ), grown_parallel( serial );
+        grown_serial.rehash( 100000 );
+        ac::parallel_rehash( grown_parallel, 100000, pool );
+        ASSERT_EQ( grown_parallel.bucket_count(), grown_serial.bucket_count() );
+        ASSERT_EQ( layout( grown_parallel ), layout( grown_serial ) );
+    }
+
+    // A pending incremental rehash is finished first, as with rehash(n).
+    ac::HashTbl<std::string, int> incremental( 11 ), reference( 11 );
+    incremental.rehash_step( 1 );
+    reference.rehash_step( 1 );
+    for ( int i{0}; i < 100; ++i ) {
+        incremental.insert( std::to_string( i ), i );
+        reference.insert( std::to_string( i ), i );
+    }
+    ASSERT_TRUE( incremental.rehashing() );
+    ac::ThreadPool pool( 4 );
+    ac::parallel_rehash( incremental, 500, pool );
+    reference.rehash( 500 );
+    ASSERT_FALSE( incremental.rehashing() );
+    ASSERT_EQ( layout( incremental ), layout( reference ) );
+}
+
+TEST_F(HTTest, FindReturnsPointerOrNull)
+{
+    insert_accounts();
+    const auto &table = ht_accounts;
+    const Account *found = table.find( m_accounts[3].getKey() );
+    ASSERT_NE( found, nullptr );
+    ASSERT_EQ( *found, m_accounts[3] );
+    ASSERT_EQ( table.find( Account( "Nobody", 0, 0, 0, 0.f ).getKey() ), nullptr );
+    ASSERT_EQ( table.find( m_accounts[3].getKeyView() ), found ); // Transparent lookup.
+    ht_accounts.find( m_accounts[3].getKey() )->m_balance = 1.f;
+    ASSERT_EQ( ht_accounts.at( m_accounts[3].getKey() ).m_balance, 1.f );
+}
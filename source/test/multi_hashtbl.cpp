@@ -0,0 +1,95 @@
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"                // gtest lib
+#include "../include/multi_hashtbl.h"   // header file for tested functions
+#include "../include/hash_functors.h"
+#include "../driver/account.h"
+
+// ============================================================================
+// TESTING THE MULTI-VALUE TABLE
+// ============================================================================
+
+TEST(MultiHashTbl, GroupsValuesByKey)
+{
+    ac::MultiHashTbl<char, int> table{ {'a', 1}, {'b', 2}, {'a', 3} };
+    ASSERT_EQ( table.size(), 3u );
+    ASSERT_EQ( table.key_count(), 2u );
+    ASSERT_FALSE( table.insert( 'a', 5 ) ); // Not the first value of 'a'.
+    ASSERT_TRUE( table.insert( 'c', 7 ) );
+
+    auto [first, last] = table.equal_range( 'a' );
+    ASSERT_EQ( std::vector<int>( first, last ), ( std::vector<int>{ 1, 3, 5 } ) ); // Insertion order.
+    ASSERT_EQ( table.count( 'a' ), 3u );
+    ASSERT_EQ( table.count( 'z' ), 0u );
+    auto missing = table.equal_range( 'z' );
+    ASSERT_EQ( missing.first, missing.second );
+
+    // Values can be changed in place.
+    for ( auto [it, end] = table.equal_range( 'b' ); it != end; ++it )
+        *it *= 10;
+    ASSERT_EQ( *table.equal_range( 'b' ).first, 20 );
+
+    ASSERT_EQ( table.erase_if( 'a', []( int v ) { return v > 2; } ), 2u );
+    ASSERT_EQ( table.count( 'a' ), 1u );
+    ASSERT_EQ( table.erase_if( 'a', []( int ) { return true; } ), 1u );
+    ASSERT_FALSE( table.contains( 'a' ) ); // No empty group is left behind.
+    ASSERT_EQ( table.erase( 'c' ), 1u );
+    ASSERT_EQ( table.erase( 'c' ), 0u );
+    ASSERT_EQ( table.size(), 1u );
+
+    int sum{0};
+    table.for_each( [&sum]( const char &, const int &v ) { sum += v; } );
+    ASSERT_EQ( sum, 20 );
+    table.clear();
+    ASSERT_TRUE( table.empty() );
+}
+
+TEST(MultiHashTbl, CustomerWithManyAccounts)
+{
+    ac::MultiHashTbl<std::string, Account, ac::string_hash, std::equal_to<>> by_name;
+    for ( int i{0}; i < 500; ++i )
+        by_name.insert( "Alex Bastos", Account( "Alex Bastos", 1, 1668, i, static_cast<float>( i ) ) );
+    for ( int i{0}; i < 1000; ++i )
+        by_name.insert( "Client #" + std::to_string( i ), Account( "Client", 2, 1, i, 0.f ) );
+
+    ASSERT_EQ( by_name.key_count(), 1001u );
+    ASSERT_EQ( by_name.size(), 1500u );
+    // Looked up by a view of the name: no temporary string, no copy of the accounts.
+    auto [first, last] = by_name.equal_range( std::string_view( "Alex Bastos" ) );
+    ASSERT_EQ( last - first, 500 );
+    ASSERT_EQ( first[499].m_number, 499 );
+    ASSERT_EQ( by_name.count( "Client #7" ), 1u );
+    // One node per name, not one per account: the table grows like one holding the names only.
+    ac::HashTbl<std::string, int> names;
+    by_name.for_each( [&names]( const std::string &name, const Account & ) { names.insert( name, 0 ); } );
+    ASSERT_EQ( by_name.bucket_count(), names.bucket_count() );
+}
+
+TEST(MultiHashTbl, ThrowingValueLeavesNoEmptyGroup)
+{
+    // Copying a value marked `fail` throws.
+    struct Fragile {
+        bool fail{false};
+        explicit Fragile( bool f ) : fail{ f } {}
+        Fragile( const Fragile &other ) : fail{ other.fail }
+        {
+            if ( fail )
+                throw std::runtime_error( "copy failed" );
+        }
+    };
+    ac::MultiHashTbl<int, Fragile> table;
+    ASSERT_THROW( table.insert( 1, Fragile( true ) ), std::runtime_error );
+    ASSERT_FALSE( table.contains( 1 ) );
+    ASSERT_EQ( table.key_count(), 0u );
+    ASSERT_EQ( table.size(), 0u );
+
+    // An existing group keeps its values.
+    ASSERT_TRUE( table.insert( 2, Fragile( false ) ) );
+    ASSERT_THROW( table.insert( 2, Fragile( true ) ), std::runtime_error );
+    ASSERT_EQ( table.count( 2 ), 1u );
+    ASSERT_EQ( table.key_count(), 1u );
+    ASSERT_EQ( table.size(), 1u );
+}
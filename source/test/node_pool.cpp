@@ -0,0 +1,96 @@
+#include <map>
+#include <string>
+
+#include "gtest/gtest.h"             // gtest lib
+#include "../include/hashtbl.h"      // header file for tested functions
+#include "../include/node_pool.h"
+
+// ============================================================================
+// TESTING THE NODE POOL AND POOL-BACKED TABLES
+// ============================================================================
+
+using PooledTbl = ac::HashTbl< int, std::string, std::hash<int>, std::equal_to<int>,
+                               ac::prime_index_policy,
+                               ac::PoolAllocator< ac::HashEntry<int, std::string> > >;
+
+TEST(NodePool, ReusesFreedSmallChunks)
+{
+    ac::NodePool pool;
+    void *a = pool.allocate( 48 );
+    void *b = pool.allocate( 48 );
+    ASSERT_NE( a, b );
+    pool.deallocate( a, 48 );
+    // Same size class: the freed chunk comes back first.
+    ASSERT_EQ( pool.allocate( 40 ), a );
+    // Different size class: a fresh chunk.
+    ASSERT_NE( pool.allocate( 96 ), a );
+}
+
+TEST(NodePool, GrowsAndHonoursAlignment)
+{
+    ac::NodePool pool( 1024 );
+    for ( int i{0}; i < 1000; ++i ) {
+        void *p = pool.allocate( 24 );
+        ASSERT_EQ( reinterpret_cast<std::uintptr_t>( p ) % alignof(std::max_align_t), 0u );
+    }
+    void *big = pool.allocate( 100000, 64 );
+    ASSERT_EQ( reinterpret_cast<std::uintptr_t>( big ) % 64, 0u );
+    ASSERT_GE( pool.bytes_reserved(), 100000u );
+
+    pool.release();
+    ASSERT_EQ( pool.bytes_reserved(), 0u );
+}
+
+TEST(NodePool, TableAgainstMap)
+{
+    ac::NodePool pool;
+    PooledTbl table( 5, pool );
+    std::map<int, std::string> expected;
+
+    // Enough keys for several rehashes, then erase half and insert again so nodes get reused.
+    for ( int i{0}; i < 5000; ++i ) {
+        table.insert( i, std::to_string( i ) );
+        expected[i] = std::to_string( i );
+    }
+    for ( int i{0}; i < 5000; i += 2 ) {
+        ASSERT_TRUE( table.erase( i ) );
+        expected.erase( i );
+    }
+    auto reserved = pool.bytes_reserved();
+    for ( int i{0}; i < 5000; i += 2 ) {
+        table.emplace( i, std::string( "again" ) );
+        expected[i] = "again";
+    }
+    // The erased nodes were recycled instead of asking the system for more memory.
+    ASSERT_EQ( pool.bytes_reserved(), reserved );
+
+    ASSERT_EQ( table.size(), expected.size() );
+    for ( const auto &e : expected )
+        ASSERT_EQ( table.at( e.first ), e.second );
+    ASSERT_EQ( table.get_allocator().pool(), &pool );
+}
+
+TEST(NodePool, CopyUsesTheSamePool)
+{
+    ac::NodePool pool;
+    PooledTbl table( 11, pool );
+    for ( int i{0}; i < 100; ++i )
+        table.insert( i, std::to_string( i ) );
+
+    PooledTbl copy( table );
+    table.clear();
+    ASSERT_EQ( copy.get_allocator(), table.get_allocator() );
+    for ( int i{0}; i < 100; ++i )
+        ASSERT_EQ( copy.at( i ), std::to_string( i ) );
+}
+
+TEST(NodePool, IncrementalRehashWithPool)
+{
+    ac::NodePool pool;
+    PooledTbl table( 2, pool );
+    table.rehash_step( 1 );
+    for ( int i{0}; i < 1000; ++i )
+        table.insert( i, std::to_string( i ) );
+    for ( int i{0}; i < 1000; ++i )
+        ASSERT_EQ( table[i], std::to_string( i ) );
+}
@@ -0,0 +1,99 @@
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"               // gtest lib
+#include "../include/hashtbl.h"        // header file for tested functions
+#include "../driver/account.h"
+
+// ============================================================================
+// TESTING THE PACKED ACCOUNT KEY
+// ============================================================================
+
+TEST(PackedKey, Layout)
+{
+    static_assert( sizeof( Account::AcctKeyPacked ) == 16 );
+    static_assert( std::is_trivially_copyable_v<Account::AcctKeyPacked> );
+    static_assert( !ac::cache_hash<Account::AcctKeyPacked>::value );
+    ASSERT_LT( sizeof( ac::HashEntry<Account::AcctKeyPacked, float> ),
+               sizeof( ac::HashEntry<Account::AcctKey, float> ) / 2 );
+}
+
+TEST(PackedKey, RoundTrip)
+{
+    Account acct( "Alex Bastos", 1, 1668, 54321, 1500.f );
+    auto key = acct.getPackedKey();
+    ASSERT_EQ( key.name(), "Alex Bastos" );
+    ASSERT_EQ( key.bank(), 1 );
+    ASSERT_EQ( key.branch(), 1668 );
+    ASSERT_EQ( key.number(), 54321 );
+
+    auto edge = AcctKeyPacked::make( "Edge", 65535, 0, -7 );
+    ASSERT_EQ( edge.bank(), 65535 );
+    ASSERT_EQ( edge.branch(), 0 );
+    ASSERT_EQ( edge.number(), -7 );
+
+    ASSERT_THROW( AcctKeyPacked::make( "Edge", 65536, 0, 0 ), std::out_of_range );
+    ASSERT_THROW( AcctKeyPacked::make( "Edge", 0, -1, 0 ), std::out_of_range );
+}
+
+TEST(PackedKey, EqualityAndInterning)
+{
+    auto before = interned_account_names();
+    auto a = AcctKeyPacked::make( "Packed Name A", 1, 2, 3 );
+    auto b = AcctKeyPacked::make( std::string( "Packed Name " ) + "A", 1, 2, 3 );
+    ASSERT_EQ( interned_account_names(), before + 1 ); // One copy of the name.
+    ASSERT_EQ( a, b );
+    ASSERT_TRUE( KeyEqual()( a, b ) );
+    ASSERT_EQ( KeyHash()( a ), KeyHash()( b ) );
+
+    ASSERT_NE( a, AcctKeyPacked::make( "Packed Name B", 1, 2, 3 ) );
+    ASSERT_NE( a, AcctKeyPacked::make( "Packed Name A", 2, 1, 3 ) );
+    ASSERT_NE( KeyHash()( a ), KeyHash()( AcctKeyPacked::make( "Packed Name A", 2, 1, 3 ) ) );
+
+    AcctKeyPacked found{};
+    ASSERT_TRUE( AcctKeyPacked::find( "Packed Name A", 1, 2, 3, found ) );
+    ASSERT_EQ( found, a );
+    ASSERT_FALSE( AcctKeyPacked::find( "Never interned", 1, 2, 3, found ) );
+    ASSERT_FALSE( AcctKeyPacked::find( "Packed Name A", 1 << 20, 2, 3, found ) );
+}
+
+TEST(PackedKey, TableOfAccounts)
+{
+    ac::HashTbl<Account::AcctKeyPacked, Account, KeyHash, KeyEqual> table;
+    std::vector<Account> accounts;
+    for ( int i{0}; i < 5000; ++i )
+        accounts.emplace_back( "Client #" + std::to_string( i % 700 ), i % 5, i % 300, i, float( i ) );
+    for ( const auto &a : accounts )
+        ASSERT_TRUE( table.insert( a.getPackedKey(), a ) );
+    ASSERT_EQ( table.size(), accounts.size() );
+
+    for ( const auto &a : accounts ) {
+        Account out;
+        ASSERT_TRUE( table.retrieve( a.getPackedKey(), out ) );
+        ASSERT_EQ( out, a );
+    }
+    ASSERT_FALSE( table.contains( AcctKeyPacked::make( "Client #1", 1, 1, 5000 ) ) );
+    ASSERT_TRUE( table.erase( accounts[42].getPackedKey() ) );
+    ASSERT_FALSE( table.contains( accounts[42].getPackedKey() ) );
+    ASSERT_EQ( table.size(), accounts.size() - 1 );
+}
+
+TEST(PackedKey, ConcurrentInterning)
+{
+    std::vector<std::vector<AcctKeyPacked>> keys( 4 );
+    std::vector<std::thread> threads;
+    for ( auto &mine : keys )
+        threads.emplace_back( [&mine] {
+            for ( int i{0}; i < 2000; ++i )
+                mine.push_back( AcctKeyPacked::make( "Shared #" + std::to_string( i ), 1, 1, i ) );
+        } );
+    for ( auto &t : threads )
+        t.join();
+    for ( std::size_t i{0}; i < keys[0].size(); ++i ) {
+        for ( const auto &other : keys )
+            ASSERT_EQ( other[i], keys[0][i] ); // Every thread got the same id for a name.
+        ASSERT_EQ( keys[0][i].name(), "Shared #" + std::to_string( i ) );
+    }
+}
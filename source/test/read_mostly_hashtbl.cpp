@@ -0,0 +1,94 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"                    // gtest lib
+#include "../include/read_mostly_hashtbl.h" // header file for tested functions
+
+// ============================================================================
+// TESTING THE READ-MOSTLY (LOCK-FREE READ) HASH TABLE
+// ============================================================================
+
+TEST(ReadMostlyHTTest, SingleThreadedSurface)
+{
+    ac::ReadMostlyHashTbl<std::string, int> table( 2 );
+    ASSERT_TRUE( table.empty() );
+    for ( int i{0}; i < 1000; ++i )
+        ASSERT_TRUE( table.insert( std::to_string( i ), i ) );
+    ASSERT_EQ( table.size(), 1000u );
+    ASSERT_GE( table.bucket_count(), 1000u ); // Grew through several rehashes.
+
+    ASSERT_FALSE( table.insert( "7", 70 ) );
+    ASSERT_EQ( table.at( "7" ), 70 );
+    int data{0};
+    ASSERT_TRUE( table.retrieve( "8", data ) );
+    ASSERT_EQ( data, 8 );
+    ASSERT_EQ( table.count( "9" ), 1u );
+    ASSERT_EQ( table.count( "nine" ), 0u );
+    ASSERT_THROW( table.at( "nine" ), std::out_of_range );
+
+    for ( int i{0}; i < 1000; i += 2 )
+        ASSERT_TRUE( table.erase( std::to_string( i ) ) );
+    ASSERT_FALSE( table.erase( "0" ) );
+    ASSERT_EQ( table.size(), 500u );
+    for ( int i{0}; i < 1000; ++i )
+        ASSERT_EQ( table.contains( std::to_string( i ) ), i % 2 == 1 );
+
+    table.clear();
+    ASSERT_TRUE( table.empty() );
+    ASSERT_FALSE( table.contains( "1" ) );
+}
+
+TEST(ReadMostlyHTTest, RetiredMemoryIsReclaimedOnceReadersLeave)
+{
+    ac::ReadMostlyHashTbl<int, int> table;
+    for ( int i{0}; i < 100; ++i )
+        table.insert( i, i );
+    for ( int i{0}; i < 100; ++i )
+        table.insert( i, -i ); // Each replacement retires a node.
+
+    // No reader is active: two epoch advances free everything.
+    table.pending_reclaim();
+    ASSERT_EQ( table.pending_reclaim(), 0u );
+}
+
+TEST(ReadMostlyHTTest, StressReadersDuringWrites)
+{
+    // Readers check that a key, when present, always maps to key * 10 or key * 10 + 1,
+    // while a writer replaces, erases and reinserts keys and forces several rehashes.
+    constexpr int KEYS = 5000;
+    ac::ReadMostlyHashTbl<int, int> table( 4 );
+    for ( int i{0}; i < KEYS; ++i )
+        table.insert( i, i * 10 );
+
+    std::atomic<bool> done{false}, failed{false};
+    std::vector<std::thread> readers;
+    for ( int t{0}; t < 4; ++t )
+        readers.emplace_back( [&]() {
+            while ( not done ) {
+                for ( int i{0}; i < 2 * KEYS; ++i ) {
+                    int data{0};
+                    if ( table.retrieve( i, data ) and data != i * 10 and data != i * 10 + 1 )
+                        failed = true;
+                }
+            }
+        } );
+
+    for ( int round{0}; round < 3; ++round ) {
+        for ( int i{0}; i < KEYS; ++i )
+            table.insert( i, i * 10 + 1 );
+        for ( int i{0}; i < KEYS; i += 3 )
+            table.erase( i );
+        for ( int i{0}; i < KEYS; i += 3 )
+            table.insert( i, i * 10 );
+        for ( int i{KEYS + round * KEYS / 3}; i < KEYS + ( round + 1 ) * KEYS / 3; ++i )
+            table.insert( i, i * 10 ); // Growth: rehashes while readers run.
+    }
+    done = true;
+    for ( auto &th : readers )
+        th.join();
+
+    ASSERT_FALSE( failed );
+    ASSERT_EQ( table.size(), static_cast<size_t>( 2 * KEYS ) );
+}
@@ -0,0 +1,144 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"               // gtest lib
+#include "../include/snapshot.h"       // header file for tested functions
+#include "../driver/account.h"         // To get the account class
+
+// ============================================================================
+// TESTING THE SNAPSHOT FILES AND MappedHashTbl
+// ============================================================================
+
+namespace {
+    /// A file path removed when the test ends.
+    struct TempFile {
+        std::string path;
+        explicit TempFile( const std::string &name ) : path{ ::testing::TempDir() + name } {}
+        ~TempFile() { std::remove( path.c_str() ); }
+    };
+}
+
+TEST(Snapshot, RoundTripIntKeys)
+{
+    TempFile file{ "ints.snap" };
+    ac::HashTbl<int, double> table;
+    for ( int i{0}; i < 1000; ++i )
+        table.insert( i * 7, i / 2.0 );
+    ac::save_snapshot( table, file.path );
+
+    ac::MappedHashTbl<int, double> mapped{ file.path };
+    ASSERT_EQ( mapped.size(), 1000u );
+    ASSERT_GE( mapped.bucket_count(), 1000u );
+    for ( int i{0}; i < 1000; ++i ) {
+        double d{-1};
+        ASSERT_TRUE( mapped.retrieve( i * 7, d ) );
+        ASSERT_EQ( d, i / 2.0 );
+        ASSERT_EQ( mapped.count( i * 7 ), 1u );
+    }
+    ASSERT_FALSE( mapped.contains( 1 ) );
+    ASSERT_EQ( mapped.count( 1 ), 0u );
+    ASSERT_THROW( mapped.at( 1 ), std::out_of_range );
+}
+
+TEST(Snapshot, StringsAndAccountKeys)
+{
+    TempFile names{ "names.snap" }, accounts{ "accounts.snap" };
+    ac::HashTbl<std::string, std::string> words;
+    words["one"] = "um";
+    words["a somewhat longer key than fits inline"] = "";
+    words[""] = "empty key";
+    ac::save_snapshot( words, names.path );
+
+    ac::MappedHashTbl<std::string, std::string> mapped_words{ names.path };
+    ASSERT_EQ( mapped_words.at( "one" ), "um" );
+    ASSERT_EQ( mapped_words.at( "a somewhat longer key than fits inline" ), "" );
+    ASSERT_EQ( mapped_words.at( "" ), "empty key" );
+    ASSERT_FALSE( mapped_words.contains( "on" ) );
+
+    // Tuple keys: the account table, with balances as data.
+    ac::HashTbl<Account::AcctKey, float, KeyHash, KeyEqual> balances;
+    for ( int i{0}; i < 300; ++i ) {
+        Account a{ "Client " + std::to_string( i ), 1, i % 13, i, 10.f * i };
+        balances.insert( a.getKey(), a.m_balance );
+    }
+    ac::save_snapshot( balances, accounts.path );
+
+    ac::MappedHashTbl<Account::AcctKey, float, KeyHash> mapped{ accounts.path };
+    ASSERT_EQ( mapped.size(), 300u );
+    for ( int i{0}; i < 300; ++i )
+        ASSERT_EQ( mapped.at( { "Client " + std::to_string( i ), 1, i % 13, i } ), 10.f * i );
+    ASSERT_FALSE( mapped.contains( { "Client 1", 1, 2, 1 } ) );
+
+    // Moving keeps the mapping alive; the moved-from table finds nothing.
+    auto moved = std::move( mapped );
+    ASSERT_EQ( moved.at( { "Client 7", 1, 7, 7 } ), 70.f );
+    ASSERT_TRUE( mapped.empty() );
+    ASSERT_FALSE( mapped.contains( { "Client 7", 1, 7, 7 } ) );
+}
+
+TEST(Snapshot, StringViewsAreStoredByValue)
+{
+    TempFile file{ "views.snap" };
+    {
+        std::vector<std::string> owners;
+        for ( int i{0}; i < 100; ++i )
+            owners.push_back( "view key " + std::to_string( i ) );
+        ac::HashTbl<std::string_view, int> table;
+        for ( int i{0}; i < 100; ++i )
+            table.insert( owners[i], i );
+        ac::save_snapshot( table, file.path );
+    } // The viewed strings are gone: the file must hold their bytes, not their addresses.
+
+    ac::MappedHashTbl<std::string_view, int> mapped{ file.path };
+    for ( int i{0}; i < 100; ++i )
+        ASSERT_EQ( mapped.at( "view key " + std::to_string( i ) ), i );
+    ASSERT_THROW( ( ac::MappedHashTbl<std::string, int>{ file.path } ), std::runtime_error );
+}
+
+TEST(Snapshot, EmptyTable)
+{
+    TempFile file{ "empty.snap" };
+    ac::save_snapshot( ac::HashTbl<int, int>{}, file.path );
+    ac::MappedHashTbl<int, int> mapped{ file.path };
+    ASSERT_TRUE( mapped.empty() );
+    ASSERT_FALSE( mapped.contains( 0 ) );
+}
+
+TEST(Snapshot, RejectsBadFiles)
+{
+    TempFile file{ "bad.snap" };
+    ac::HashTbl<int, int> table;
+    for ( int i{0}; i < 100; ++i )
+        table.insert( i, i );
+    ac::save_snapshot( table, file.path );
+
+    // Other types than the file was written with.
+    ASSERT_THROW( ( ac::MappedHashTbl<int, long>{ file.path } ), std::runtime_error );
+    ASSERT_THROW( ( ac::MappedHashTbl<unsigned, int>{ file.path } ), std::runtime_error );
+    ASSERT_THROW( ( ac::MappedHashTbl<std::string, int>{ file.path } ), std::runtime_error );
+    ASSERT_THROW( ( ac::MappedHashTbl<int, int>{ file.path + ".missing" } ), std::runtime_error );
+
+    // A flipped byte in a record fails the checksum, unless verification is skipped.
+    {
+        std::fstream f( file.path, std::ios::in | std::ios::out | std::ios::binary );
+        f.seekp( -3, std::ios::end );
+        f.put( 0x5a );
+    }
+    ASSERT_THROW( ( ac::MappedHashTbl<int, int>{ file.path } ), std::runtime_error );
+    ASSERT_NO_THROW( ( ac::MappedHashTbl<int, int>{ file.path, false } ) );
+
+    // Truncated and foreign files.
+    {
+        std::ofstream f( file.path, std::ios::binary | std::ios::trunc );
+        f << "not a snapshot, but long enough to hold a header of about a hundred bytes..............";
+    }
+    ASSERT_THROW( ( ac::MappedHashTbl<int, int>{ file.path } ), std::runtime_error );
+    {
+        std::ofstream f( file.path, std::ios::binary | std::ios::trunc );
+    }
+    ASSERT_THROW( ( ac::MappedHashTbl<int, int>{ file.path } ), std::runtime_error );
+}
@@ -0,0 +1,91 @@
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"                // gtest lib
+#include "../include/static_hashtbl.h"  // header file for tested functions
+
+// ============================================================================
+// TESTING THE FIXED-CAPACITY (CONSTEXPR) TABLE
+// ============================================================================
+
+namespace {
+    /// Built by the compiler: a constant expression, stored in read-only data.
+    constexpr ac::StaticHashTbl<char, int, 6> LETTERS{ {'x', 2}, {'y', 1}, {'w', 4}, {'a', 5}, {'b', 8}, {'c', 7} };
+
+    static_assert( LETTERS.size() == 6 );
+    static_assert( LETTERS.at( 'a' ) == 5 && LETTERS.at( 'c' ) == 7 );
+    static_assert( LETTERS.contains( 'w' ) && !LETTERS.contains( 'z' ) );
+    static_assert( LETTERS.capacity() > LETTERS.max_size() );
+
+    enum class Route { North, South, East };
+    constexpr ac::StaticHashTbl<std::string_view, Route, 4> BRANCHES{
+        { "1668", Route::North }, { "557", Route::South }, { "331", Route::East }
+    };
+    static_assert( BRANCHES.at( "557" ) == Route::South );
+    static_assert( BRANCHES.count( "666" ) == 0 );
+
+    /// Every key collides: exercises probing and the backward shift of erase.
+    struct ConstantHash {
+        constexpr std::size_t operator()( int ) const noexcept { return 3; }
+    };
+
+    constexpr int after_erase()
+    {
+        ac::StaticHashTbl<int, int, 8, ConstantHash> table{ {1, 10}, {2, 20}, {3, 30}, {4, 40} };
+        table.erase( 2 );
+        table.insert( 5, 50 );
+        table.insert( 1, 11 );
+        int sum{0};
+        table.for_each( [&sum]( const int &, const int &data ) { sum += data; } );
+        return sum;
+    }
+    static_assert( after_erase() == 11 + 30 + 40 + 50 );
+}
+
+TEST(StaticHashTbl, ConstantTables)
+{
+    int data{0};
+    ASSERT_TRUE( LETTERS.retrieve( 'x', data ) );
+    ASSERT_EQ( data, 2 );
+    ASSERT_FALSE( LETTERS.retrieve( 'z', data ) );
+    ASSERT_THROW( LETTERS.at( 'z' ), std::out_of_range );
+    ASSERT_EQ( BRANCHES.at( std::string( "331" ) ), Route::East );
+}
+
+TEST(StaticHashTbl, InsertEraseAndCapacity)
+{
+    ac::StaticHashTbl<int, std::string, 16> table;
+    ASSERT_TRUE( table.empty() );
+    for ( int i{0}; i < 16; ++i )
+        ASSERT_TRUE( table.insert( i * 31, std::to_string( i ) ) );
+    ASSERT_FALSE( table.insert( 0, "zero" ) ); // Replaced.
+    ASSERT_EQ( table.at( 0 ), "zero" );
+    ASSERT_THROW( table.insert( 1000, "full" ), std::length_error );
+    ASSERT_EQ( table.size(), 16u );
+
+    table.at( 31 ) = "one";
+    ASSERT_EQ( table.at( 31 ), "one" );
+    for ( int i{0}; i < 16; i += 2 )
+        ASSERT_TRUE( table.erase( i * 31 ) );
+    ASSERT_FALSE( table.erase( 0 ) );
+    ASSERT_EQ( table.size(), 8u );
+    for ( int i{1}; i < 16; i += 2 )
+        ASSERT_TRUE( table.contains( i * 31 ) );
+    ASSERT_TRUE( table.insert( 1000, "room again" ) );
+
+    table.clear();
+    ASSERT_TRUE( table.empty() );
+    ASSERT_FALSE( table.contains( 31 ) );
+}
+
+TEST(StaticHashTbl, CollidingKeys)
+{
+    ac::StaticHashTbl<int, int, 32, ConstantHash> table;
+    for ( int i{0}; i < 32; ++i )
+        table.insert( i, i );
+    // Erase from the middle of the single cluster; every other key must stay reachable.
+    for ( int i{0}; i < 32; i += 3 )
+        ASSERT_TRUE( table.erase( i ) );
+    for ( int i{0}; i < 32; ++i )
+        ASSERT_EQ( table.contains( i ), i % 3 != 0 );
+}
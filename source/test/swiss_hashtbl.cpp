@@ -0,0 +1,162 @@
+#include <array>
+#include <map>
+#include <random>
+
+#include "gtest/gtest.h"              // gtest lib
+#include "../include/swiss_hashtbl.h" // header file for tested functions
+#include "../driver/account.h"        // To get the account class
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class SwissHTTest : public ::testing::Test {
+    public:
+        std::array<Account, 8> m_accounts; //!< our fixed account data base
+
+        /// This is the hash table we use in the tests.
+        ac::SwissHashTbl< Account::AcctKey, Account, KeyHash, KeyEqual > ht_accounts{ 4 };
+
+    protected:
+        void SetUp() override {
+            m_accounts[0] = {"Alex Bastos", 1, 1668, 54321, 1500.f};
+            m_accounts[1] = {"Aline Souza", 1, 1668, 45794, 530.f};
+            m_accounts[2] = {"Cristiano Ronaldo", 13, 557, 87629, 150000.f};
+            m_accounts[3] = {"Jose Lima", 18, 331, 1231, 850.f};
+            m_accounts[4] = {"Saulo Cunha", 116, 666, 1, 5490.f};
+            m_accounts[5] = {"Lima Junior", 12, 123, 5671, 150.f};
+            m_accounts[6] = {"Carlito Pardo", 28, 506, 9816, 50.f};
+            m_accounts[7] = {"Januario Medeiros", 17, 324, 7777, 4850.f};
+        }
+
+        void insert_accounts() {
+            for( auto & e : m_accounts )
+                ht_accounts.insert( e.getKey(), e );
+        }
+};
+
+// ============================================================================
+// TESTING SWISS (CONTROL BYTE) HASH TABLE
+// ============================================================================
+
+TEST_F(SwissHTTest, GroupMatchScalarAgreesWithVector)
+{
+    std::mt19937 rng( 7 );
+    std::int8_t ctrl[ac::detail::GROUP_WIDTH];
+    for ( int round{0}; round < 1000; ++round )
+    {
+        for ( auto &c : ctrl )
+        {
+            auto r = rng() % 4;
+            c = r == 0 ? static_cast<std::int8_t>( ac::detail::CTRL_EMPTY )
+              : r == 1 ? static_cast<std::int8_t>( ac::detail::CTRL_DELETED )
+              : static_cast<std::int8_t>( rng() % 8 );
+        }
+        ac::detail::GroupScalar scalar( ctrl );
+        ac::detail::Group group( ctrl );
+        for ( std::int8_t h2{0}; h2 < 8; ++h2 )
+            ASSERT_EQ( scalar.match( h2 ), group.match( h2 ) );
+        ASSERT_EQ( scalar.match_empty(), group.match_empty() );
+        ASSERT_EQ( scalar.match_empty_or_deleted(), group.match_empty_or_deleted() );
+    }
+}
+
+TEST_F(SwissHTTest, InsertingData)
+{
+    Account temp;
+    size_t i(0);
+    for( auto & e : m_accounts )
+    {
+        ASSERT_TRUE( ht_accounts.insert( e.getKey(), e ) );
+        ASSERT_EQ( ++i, ht_accounts.size() );
+        ASSERT_TRUE( ht_accounts.retrieve( e.getKey(), temp ) );
+        ASSERT_EQ( temp, e );
+    }
+    for( auto & e : m_accounts )
+        ASSERT_EQ( ht_accounts.at(e.getKey()), e );
+}
+
+TEST_F(SwissHTTest, FindAndErase)
+{
+    insert_accounts();
+    auto *found = ht_accounts.find( m_accounts[3].getKey() );
+    ASSERT_NE( found, nullptr );
+    ASSERT_EQ( *found, m_accounts[3] );
+
+    for( auto & e : m_accounts )
+    {
+        ASSERT_TRUE( ht_accounts.erase( e.getKey() ) );
+        ASSERT_FALSE( ht_accounts.erase( e.getKey() ) );
+        ASSERT_EQ( ht_accounts.find( e.getKey() ), nullptr );
+    }
+    ASSERT_TRUE( ht_accounts.empty() );
+}
+
+TEST_F(SwissHTTest, OperatorSquareBrakets)
+{
+    std::map<std::string, size_t> expected;
+    ac::SwissHashTbl<std::string, size_t> word_map;
+    for (const auto &w : { "this", "sentence", "is", "not", "a", "sentence",
+                           "this", "sentence", "is", "a", "hoax"})
+    {
+        ++word_map[w];
+        ++expected[w];
+    }
+
+    ASSERT_EQ( expected.size(), word_map.size() );
+    for (const auto &pair : expected )
+        ASSERT_EQ( pair.second, word_map.at(pair.first) );
+    ASSERT_THROW( word_map.at("nothing"), std::out_of_range );
+}
+
+TEST_F(SwissHTTest, CopyAndAssignment)
+{
+    ac::SwissHashTbl<char, int> htable {{'a', 27}, {'b', 3}, {'c', 1}};
+    ac::SwissHashTbl<char, int> copy( htable );
+    ac::SwissHashTbl<char, int> assigned;
+    assigned = htable;
+    htable.clear();
+
+    std::map<char, int> expected {{'a', 27}, {'b', 3}, {'c', 1}};
+    for( const auto &e : expected )
+    {
+        int data;
+        ASSERT_TRUE( copy.retrieve( e.first, data ) );
+        ASSERT_EQ( e.second, data );
+        ASSERT_TRUE( assigned.retrieve( e.first, data ) );
+        ASSERT_EQ( e.second, data );
+        ASSERT_EQ( htable.count( e.first ), 0 );
+    }
+}
+
+TEST_F(SwissHTTest, RandomizedAgainstMap)
+{
+    // Heavy churn on a small key space exercises tombstones and same-size rebuilds.
+    ac::SwissHashTbl<int, int> htable;
+    std::map<int, int> expected;
+    std::mt19937 rng( 2023 );
+    std::uniform_int_distribution<int> key_dist( 0, 2000 );
+
+    for ( int i{0}; i < 50000; ++i )
+    {
+        auto key = key_dist( rng );
+        if ( rng() % 2 == 0 ) {
+            ASSERT_EQ( htable.erase( key ), expected.erase( key ) == 1 );
+        }
+        else {
+            ASSERT_EQ( htable.insert( key, i ), expected.insert_or_assign( key, i ).second );
+        }
+    }
+
+    ASSERT_EQ( htable.size(), expected.size() );
+    for ( int key{0}; key <= 2000; ++key )
+    {
+        const auto &const_table = htable;
+        auto it = expected.find( key );
+        auto *data = const_table.find( key );
+        ASSERT_EQ( data != nullptr, it != expected.end() );
+        if ( data != nullptr ) {
+            ASSERT_EQ( *data, it->second );
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"               // gtest lib
+#include "../include/thread_pool.h"    // header file for tested functions
+
+// ============================================================================
+// TESTING THE THREAD POOL
+// ============================================================================
+
+TEST(ThreadPool, RunsEveryTaskAndReturnsResults)
+{
+    ac::ThreadPool pool( 4 );
+    ASSERT_EQ( pool.size(), 4u );
+    std::vector<std::future<int>> results;
+    for ( int i{0}; i < 100; ++i )
+        results.push_back( pool.submit( [i] { return i * i; } ) );
+    for ( int i{0}; i < 100; ++i )
+        ASSERT_EQ( results[i].get(), i * i );
+}
+
+TEST(ThreadPool, PropagatesExceptions)
+{
+    ac::ThreadPool pool( 2 );
+    auto f = pool.submit( []() -> int { throw std::runtime_error( "boom" ); } );
+    ASSERT_THROW( f.get(), std::runtime_error );
+    ASSERT_EQ( pool.submit( [] { return 7; } ).get(), 7 ); // The worker survived.
+}
+
+TEST(ThreadPool, DestructorFinishesQueuedTasks)
+{
+    std::atomic<int> done{0};
+    {
+        ac::ThreadPool pool( 1 );
+        for ( int i{0}; i < 50; ++i )
+            pool.submit( [&done] { ++done; } );
+    }
+    ASSERT_EQ( done.load(), 50 );
+    ASSERT_GE( ac::ThreadPool{}.size(), 1u ); // 0 threads means one per core, at least one.
+}
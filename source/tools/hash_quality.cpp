@@ -0,0 +1,132 @@
+// @author: Gabriel Victor and Thiago Raquel
+//
+// Reports how well a hash spreads a key set: bucket occupancy, chi-square and avalanche.
+//
+// Usage:
+//   hash_quality [--accounts N | --account-file FILE | --word-file FILE]
+//                [--buckets B] [--policy prime|power2|fast_range]
+//
+//   --accounts N         N synthetic account keys (default 100000).
+//   --account-file FILE  Account keys, one "name,bank,branch,number" per line.
+//   --word-file FILE     String keys, one per line (hashed with std::hash<std::string>).
+//   --buckets B          Bucket count (default: the number of keys, i.e. load factor 1).
+//   --policy P           Bucket-index policy of the table (default prime).
+//
+// Account keys are analyzed with the account KeyHash and, for comparison, with the
+// former xor-of-fields hash.
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../include/hash_quality.h"
+#include "../driver/account.h"
+
+namespace {
+    /// The account hash before hash_combine: fields xored together.
+    struct XorKeyHash {
+        std::size_t operator()( const Account::AcctKey & k_ ) const
+        {
+            const auto & [name, bkid, brid, accn] = k_;
+            return std::hash<std::string>{}(name) ^ std::hash<int>{}(bkid) ^ std::hash<int>{}(brid) ^ std::hash<int>{}(accn);
+        }
+    };
+
+    /// Synthetic accounts: a few banks and branches, account numbers dense within each branch.
+    std::vector<Account::AcctKey> synthetic_accounts( std::size_t n_ )
+    {
+        const char * first[] = { "Ana", "Bruno", "Carla", "Davi", "Elisa", "Fabio", "Gabriel", "Helena",
+                                 "Igor", "Julia", "Lucas", "Marina", "Nuno", "Olga", "Pedro", "Rita" };
+        const char * last[] = { "Silva", "Souza", "Lima", "Costa", "Pereira", "Alves", "Rocha", "Dias" };
+        std::mt19937 rng( 42 );
+        std::vector<Account::AcctKey> keys;
+        keys.reserve( n_ );
+        for ( std::size_t i{0}; i < n_; ++i ) {
+            std::string name = std::string( first[rng() % 16] ) + " " + last[rng() % 8];
+            int bank = static_cast<int>( rng() % 20 ) + 1;
+            int branch = static_cast<int>( rng() % 2000 ) + 1;
+            keys.emplace_back( name, bank, branch, static_cast<int>( i ) );
+        }
+        return keys;
+    }
+
+    std::vector<Account::AcctKey> load_accounts( const std::string & path_ )
+    {
+        std::ifstream in( path_ );
+        if ( not in )
+            throw std::runtime_error( "cannot open " + path_ );
+        std::vector<Account::AcctKey> keys;
+        std::string line;
+        while ( std::getline( in, line ) ) {
+            std::istringstream fields( line );
+            std::string name, bank, branch, number;
+            if ( std::getline( fields, name, ',' ) and std::getline( fields, bank, ',' )
+                 and std::getline( fields, branch, ',' ) and std::getline( fields, number ) )
+                keys.emplace_back( name, std::stoi( bank ), std::stoi( branch ), std::stoi( number ) );
+        }
+        return keys;
+    }
+
+    std::vector<std::string> load_words( const std::string & path_ )
+    {
+        std::ifstream in( path_ );
+        if ( not in )
+            throw std::runtime_error( "cannot open " + path_ );
+        std::vector<std::string> keys;
+        for ( std::string line; std::getline( in, line ); )
+            keys.push_back( line );
+        return keys;
+    }
+
+    template <class Key, class Hash>
+    void report( const std::string & title_, const std::vector<Key> & keys_, std::size_t buckets_,
+                 const std::string & policy_, const Hash & hash_ )
+    {
+        std::cout << "=== " << title_ << " (" << policy_ << " policy) ===\n";
+        if ( policy_ == "power2" )
+            std::cout << ac::analyze_hash<ac::power2_index_policy>( keys_, buckets_, hash_ );
+        else if ( policy_ == "fast_range" )
+            std::cout << ac::analyze_hash<ac::fast_range_index_policy>( keys_, buckets_, hash_ );
+        else
+            std::cout << ac::analyze_hash<ac::prime_index_policy>( keys_, buckets_, hash_ );
+        std::cout << std::endl;
+    }
+}
+
+int main( int argc, char * argv[] )
+{
+    std::size_t accounts{100000}, buckets{0};
+    std::string account_file, word_file, policy{"prime"};
+    for ( int i{1}; i + 1 < argc; i += 2 ) {
+        std::string opt{ argv[i] }, val{ argv[i + 1] };
+        if ( opt == "--accounts" ) accounts = std::stoul( val );
+        else if ( opt == "--account-file" ) account_file = val;
+        else if ( opt == "--word-file" ) word_file = val;
+        else if ( opt == "--buckets" ) buckets = std::stoul( val );
+        else if ( opt == "--policy" ) policy = val;
+        else {
+            std::cerr << "unknown option " << opt << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        if ( not word_file.empty() ) {
+            auto keys = load_words( word_file );
+            report( "std::hash<std::string>", keys, buckets ? buckets : keys.size(), policy, std::hash<std::string>{} );
+            return EXIT_SUCCESS;
+        }
+        auto keys = account_file.empty() ? synthetic_accounts( accounts ) : load_accounts( account_file );
+        report( "account KeyHash", keys, buckets ? buckets : keys.size(), policy, KeyHash{} );
+        report( "xor of fields (former KeyHash)", keys, buckets ? buckets : keys.size(), policy, XorKeyHash{} );
+    }
+    catch ( const std::exception & e ) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}